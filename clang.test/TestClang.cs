@@ -175,6 +175,184 @@ public void Clang_LoadTranslationUnit()
 			finally { SysFile.Delete(outpath); }
 		}
 
+		[TestMethod(), TestCategory("Diagnostics")]
+		public void Clang_OpenDiagnostics()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\diagnostics.bin");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			// Stream the diagnostics and compare them against the libclang loaded diagnostics
+			using (LoadedDiagnosticCollection loaded = Clang.LoadDiagnostics(inpath))
+			using (SerializedDiagnosticReader reader = Clang.OpenDiagnostics(inpath))
+			{
+				Assert.AreEqual(inpath, reader.Path);
+
+				List<SerializedDiagnostic> diags = new List<SerializedDiagnostic>();
+				for (SerializedDiagnostic diag = reader.Read(); diag != null; diag = reader.Read()) diags.Add(diag);
+
+				Assert.AreEqual(2, reader.Version);
+				Assert.IsNull(reader.Read());
+				Assert.AreEqual(loaded.Count, diags.Count);
+
+				for (int index = 0; index < diags.Count; index++)
+				{
+					Assert.AreEqual(loaded[index].Severity, diags[index].Severity);
+					Assert.AreEqual(loaded[index].Spelling, diags[index].Spelling);
+					Assert.AreEqual(loaded[index].Category.Text, diags[index].Category);
+					Assert.AreEqual(loaded[index].EnableOption, diags[index].EnableOption);
+					Assert.AreEqual(loaded[index].DisableOption, diags[index].DisableOption);
+					Assert.AreEqual(loaded[index].Location.File.Name, diags[index].FileName);
+					Assert.AreEqual(loaded[index].Location.Line, diags[index].Line);
+					Assert.AreEqual(loaded[index].Location.Column, diags[index].Column);
+					Assert.AreEqual(loaded[index].Location.Offset, diags[index].Offset);
+				}
+
+				// Notes in nested blocks are all attached to the top-level diagnostic - see diagnostics-expected.txt
+				Assert.AreEqual(0, diags[0].Children.Count);
+				Assert.AreEqual(1, diags[1].Children.Count);
+				Assert.AreEqual(2, diags[3].Children.Count);
+				Assert.AreEqual(DiagnosticSeverity.Note, diags[3].Children[0].Severity);
+				Assert.AreEqual("previous definition is here", diags[3].Children[0].Spelling);
+				Assert.AreEqual("expanded from macro 'A'", diags[3].Children[1].Spelling);
+				Assert.AreEqual(3, diags[3].Children[1].Line);
+				Assert.AreEqual(11, diags[3].Children[1].Column);
+			}
+
+			// Read in batches
+			using (SerializedDiagnosticReader reader = Clang.OpenDiagnostics(inpath))
+			{
+				Assert.AreEqual(4, reader.ReadBatch(4).Length);
+				Assert.AreEqual(2, reader.ReadBatch(4).Length);
+				Assert.AreEqual(0, reader.ReadBatch(4).Length);
+
+				reader.Dispose();
+				Assert.IsTrue(reader.IsDisposed(() => reader.Read()));
+			}
+
+			// Read multiple files in parallel
+			int count = 0;
+			SerializedDiagnosticReader.ForEach(new string[] { inpath, inpath, inpath }, (path, diag) =>
+			{
+				Assert.AreEqual(inpath, path);
+				System.Threading.Interlocked.Increment(ref count);
+			});
+			Assert.AreEqual(18, count);
+
+			// Files that aren't serialized diagnostics or don't exist
+			try { Clang.OpenDiagnostics(Path.Combine(Environment.CurrentDirectory, @"input\hello.cpp")); Assert.Fail(); }
+			catch (Exception ex) { Assert.AreEqual(DiagnosticLoadErrorCode.InvalidFile, ((DiagnosticLoadException)ex).ErrorCode); }
+
+			try { Clang.OpenDiagnostics("not_a_real_path"); Assert.Fail(); }
+			catch (Exception ex) { Assert.AreEqual(DiagnosticLoadErrorCode.CannotLoad, ((DiagnosticLoadException)ex).ErrorCode); }
+		}
+
+		[TestMethod(), TestCategory("Diagnostics")]
+		public void Clang_OpenDiagnostics_Corrupt()
+		{
+			// Blob with a length near 2^64 that would wrap a naive bounds check
+			AssertCorruptDiagnostics(bits =>
+			{
+				bits.Fixed(3, 2).VBR(5, 2);								// DEFINE_ABBREV: [literal 6, blob]
+				bits.Fixed(1, 1).VBR(8, 6);
+				bits.Fixed(1, 0).Fixed(3, 5);
+				bits.Fixed(3, 4).VBR(6, 0xFFFFFFFFFFFFFFF0UL);			// Record with a corrupt blob length
+			});
+
+			// Blob longer than the remaining data
+			AssertCorruptDiagnostics(bits =>
+			{
+				bits.Fixed(3, 2).VBR(5, 2);
+				bits.Fixed(1, 1).VBR(8, 6);
+				bits.Fixed(1, 0).Fixed(3, 5);
+				bits.Fixed(3, 4).VBR(6, 1024);
+			});
+
+			// Array of literal elements with a huge element count
+			AssertCorruptDiagnostics(bits =>
+			{
+				bits.Fixed(3, 2).VBR(5, 3);								// DEFINE_ABBREV: [literal 6, array, literal 0]
+				bits.Fixed(1, 1).VBR(8, 6);
+				bits.Fixed(1, 0).Fixed(3, 3);
+				bits.Fixed(1, 1).VBR(8, 0);
+				bits.Fixed(3, 4).VBR(6, 0xFFFFFFFFFFFFFFF0UL);
+			});
+
+			// Array of zero-width fixed elements, which are read as literals
+			AssertCorruptDiagnostics(bits =>
+			{
+				bits.Fixed(3, 2).VBR(5, 3);								// DEFINE_ABBREV: [literal 6, array, fixed(0)]
+				bits.Fixed(1, 1).VBR(8, 6);
+				bits.Fixed(1, 0).Fixed(3, 3);
+				bits.Fixed(1, 0).Fixed(3, 1).VBR(5, 0);
+				bits.Fixed(3, 4).VBR(6, 0xFFFFFFFFFFFFFFF0UL);
+			});
+		}
+
+		[TestMethod(), TestCategory("Diagnostics")]
+		public void Clang_OpenDiagnostics_Large()
+		{
+			// Files of 512MiB and larger overflow a 32-bit bit position; skip an unknown block that spans
+			// past that boundary and ends exactly at the end of the file
+			const uint numwords = (512 * 1024 * 1024 + 65536) / 4;
+
+			BitstreamWriter bits = new BitstreamWriter();
+			bits.Fixed(2, 1).VBR(8, 100).VBR(4, 3).Align().Fixed(32, numwords);		// ENTER_SUBBLOCK: unknown block
+
+			string path = Path.GetTempFileName();
+			try
+			{
+				using (FileStream stream = SysFile.Create(path))
+				{
+					stream.Write(new byte[] { (byte)'D', (byte)'I', (byte)'A', (byte)'G' }, 0, 4);
+					byte[] data = bits.ToArray();
+					stream.Write(data, 0, data.Length);
+					stream.SetLength(stream.Length + (numwords * 4L));
+				}
+
+				using (SerializedDiagnosticReader reader = Clang.OpenDiagnostics(path)) Assert.IsNull(reader.Read());
+			}
+
+			finally { SysFile.Delete(path); }
+		}
+
+		[TestMethod(), TestCategory("Miscellaneous")]
+		public void Clang_PerformanceCounters()
+		{
+			PerformanceCounters.Enabled = true;
+			PerformanceCounters.Reset();
+
+			try
+			{
+				using (Index index = Clang.CreateIndex())
+				{
+					using (TranslationUnit tu = index.CreateTranslationUnitFromString("int x = 0;"))
+					{
+						Assert.IsNotNull(tu.Cursor);
+						Assert.IsNotNull(tu.Cursor.Extent.GetTokens());
+					}
+				}
+
+				Assert.AreEqual(1L, PerformanceCounters.GetOperationCount(PerformanceOperation.Parse));
+				Assert.AreEqual(1L, PerformanceCounters.GetOperationCount(PerformanceOperation.Tokenize));
+				Assert.AreNotEqual(TimeSpan.Zero, PerformanceCounters.GetOperationTime(PerformanceOperation.Parse));
+				Assert.AreEqual(1L, PerformanceCounters.GetObjectCounts()["TranslationUnit"]);
+				Assert.AreNotEqual(0L, PerformanceCounters.GetObjectCounts()["Cursor"]);
+				Assert.AreNotEqual(0L, PerformanceCounters.HandleAddRefCount);
+				Assert.AreEqual(PerformanceCounters.HandleAddRefCount, PerformanceCounters.HandleReleaseCount);
+
+				// Once disabled the counters should stop changing
+				PerformanceCounters.Enabled = false;
+				using (Index index = Clang.CreateIndex()) index.CreateTranslationUnitFromString("int y = 0;").Dispose();
+				Assert.AreEqual(1L, PerformanceCounters.GetOperationCount(PerformanceOperation.Parse));
+
+				PerformanceCounters.Reset();
+				Assert.AreEqual(0L, PerformanceCounters.GetOperationCount(PerformanceOperation.Parse));
+				Assert.AreEqual(0L, PerformanceCounters.HandleAddRefCount);
+			}
+
+			finally { PerformanceCounters.Enabled = false; }
+		}
+
 		[TestMethod(), TestCategory("Miscellaneous")]
 		public void Clang_SetCrashRecovery()
 		{
@@ -182,5 +360,120 @@ public void Clang_SetCrashRecovery()
 			Clang.SetCrashRecovery(true);
 			Clang.SetCrashRecovery(false);
 		}
+
+		[TestMethod(), TestCategory("Miscellaneous")]
+		public void Clang_TraceRecorder()
+		{
+			TraceRecorder recorder = new TraceRecorder();
+			Assert.IsFalse(recorder.IsRecording);
+
+			recorder.Start();
+			try
+			{
+				Assert.IsTrue(recorder.IsRecording);
+
+				// Only one recorder can be recording at a time
+				try { new TraceRecorder().Start(); Assert.Fail(); }
+				catch (Exception ex) { Assert.IsInstanceOfType(ex, typeof(InvalidOperationException)); }
+
+				using (Index index = Clang.CreateIndex())
+				{
+					TranslationUnit tu = index.CreateTranslationUnitFromString("int x = 0;");
+					tu.ExtractDiagnostics(DiagnosticFields.All);
+					tu.Dispose();
+				}
+			}
+
+			finally { recorder.Stop(); }
+
+			Assert.IsFalse(recorder.IsRecording);
+
+			// Parse, diagnostics and dispose should each have a begin and an end event
+			Assert.AreEqual(6, recorder.EventCount);
+
+			using (StringWriter writer = new StringWriter())
+			{
+				recorder.WriteTo(writer);
+				string json = writer.ToString();
+
+				Assert.IsTrue(json.StartsWith("{\"traceEvents\":["));
+				Assert.IsTrue(json.Contains("\"name\":\"Parse\",\"cat\":\"clang\",\"ph\":\"B\""));
+				Assert.IsTrue(json.Contains("\"name\":\"Dispose\",\"cat\":\"clang\",\"ph\":\"E\""));
+				Assert.IsTrue(json.Contains("\"file\":"));
+			}
+
+			// Events are no longer recorded once stopped
+			using (Index index = Clang.CreateIndex()) index.CreateTranslationUnitFromString("int y = 0;").Dispose();
+			Assert.AreEqual(6, recorder.EventCount);
+		}
+
+		/// <summary>
+		/// Writes a serialized diagnostics file containing a single diagnostic block and
+		/// verifies that reading it fails with DiagnosticLoadErrorCode.InvalidFile
+		/// </summary>
+		/// <param name="body">Writes the contents of the diagnostic block</param>
+		private static void AssertCorruptDiagnostics(Action<BitstreamWriter> body)
+		{
+			BitstreamWriter bits = new BitstreamWriter();
+			bits.Fixed(2, 1).VBR(8, 9).VBR(4, 3).Align().Fixed(32, 0);		// ENTER_SUBBLOCK: DIAG, abbrev width 3
+			body(bits);
+			bits.Align();
+
+			string path = Path.GetTempFileName();
+			try
+			{
+				using (FileStream stream = SysFile.Create(path))
+				{
+					stream.Write(new byte[] { (byte)'D', (byte)'I', (byte)'A', (byte)'G' }, 0, 4);
+					byte[] data = bits.ToArray();
+					stream.Write(data, 0, data.Length);
+				}
+
+				using (SerializedDiagnosticReader reader = Clang.OpenDiagnostics(path))
+				{
+					try { reader.Read(); Assert.Fail(); }
+					catch (DiagnosticLoadException ex) { Assert.AreEqual(DiagnosticLoadErrorCode.InvalidFile, ex.ErrorCode); }
+				}
+			}
+
+			finally { SysFile.Delete(path); }
+		}
+
+		/// <summary>
+		/// Minimal LLVM bitstream writer used to generate malformed serialized diagnostics
+		/// </summary>
+		private class BitstreamWriter
+		{
+			public BitstreamWriter Align()
+			{
+				while ((m_position % 32) != 0) Fixed(1, 0);
+				return this;
+			}
+
+			public BitstreamWriter Fixed(int width, ulong value)
+			{
+				for (int bit = 0; bit < width; bit++, m_position++)
+				{
+					if ((m_position % 8) == 0) m_bytes.Add(0);
+					if (((value >> bit) & 1) != 0) m_bytes[m_bytes.Count - 1] |= (byte)(1 << (m_position % 8));
+				}
+				return this;
+			}
+
+			public byte[] ToArray()
+			{
+				return m_bytes.ToArray();
+			}
+
+			public BitstreamWriter VBR(int width, ulong value)
+			{
+				ulong continuation = 1UL << (width - 1);
+				for (; value >= continuation; value >>= (width - 1)) Fixed(width, (value & (continuation - 1)) | continuation);
+				return Fixed(width, value);
+			}
+
+			private List<byte> m_bytes = new List<byte>();
+			private int m_position;
+		}
 	}
 }
@@ -68,6 +68,50 @@ public void Comment_BlockCommandComment()
 			}
 		}
 
+		[TestMethod(), TestCategory("Comments")]
+		public void Comment_DocumentationExtractor()
+		{
+			string code = "/// \\brief Adds values.\n/// \\param a The first\n///   value.\n/// \\param b The second value.\nint add(int a, int b);\n" +
+				"int add(int a, int b) { return a + b; }\n/// \\brief A value.\nint value;\nint undocumented;";
+
+			using (TranslationUnit tu = s_index.CreateTranslationUnitFromString(code))
+			{
+				List<DocumentationRecord> records = new List<DocumentationRecord>();
+				DocumentationExtractor extractor = new DocumentationExtractor((r) => records.Add(r));
+
+				// Redeclarations share the same comment and are only reported once
+				extractor.Extract(new TranslationUnit[] { tu });
+				Assert.AreEqual(2, records.Count);
+				Assert.AreEqual(2, extractor.RecordCount);
+				Assert.AreEqual(1, extractor.FileCount);
+
+				DocumentationRecord add = records.Find((r) => r.Spelling == "add");
+				Assert.IsNotNull(add);
+				Assert.AreEqual(CursorKind.FunctionDecl, add.Kind);
+				Assert.AreEqual("Adds values.", add.BriefText);
+				Assert.AreEqual((string)tu.FindCursor("add").UnifiedSymbolResolution, add.UnifiedSymbolResolution);
+				Assert.AreEqual(5, add.Line);
+				Assert.IsTrue(add.Xml.StartsWith("<Function"));
+				Assert.AreEqual(0, add.TemplateParameters.Count);
+
+				// Parameter text spanning multiple lines is collapsed
+				Assert.AreEqual(2, add.Parameters.Count);
+				Assert.AreEqual("a", add.Parameters[0].Key);
+				Assert.AreEqual("The first value.", add.Parameters[0].Value);
+				Assert.AreEqual("b", add.Parameters[1].Key);
+				Assert.AreEqual("The second value.", add.Parameters[1].Value);
+
+				DocumentationRecord value = records.Find((r) => r.Spelling == "value");
+				Assert.IsNotNull(value);
+				Assert.AreEqual("A value.", value.BriefText);
+				Assert.AreEqual(0, value.Parameters.Count);
+
+				// Files that have already been processed are not processed again
+				extractor.Extract(new TranslationUnit[] { tu });
+				Assert.AreEqual(2, records.Count);
+			}
+		}
+
 		[TestMethod(), TestCategory("Comments")]
 		public void Comment_HtmlStartTagComment()
 		{
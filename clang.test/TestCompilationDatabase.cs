@@ -53,6 +53,46 @@ public void CompilationDatabase_Workaround_JsonLoaderLock()
 			}
 		}
 
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_BuildIndex()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, "input");
+			using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(inpath))
+			{
+				Assert.IsFalse(cdb.IsIndexed);
+				cdb.BuildIndex();
+				Assert.IsTrue(cdb.IsIndexed);
+
+				// Building the index again should be harmless
+				cdb.BuildIndex();
+
+				// Lookups should now be served from the index
+				Assert.AreEqual(0, cdb.GetCompileCommands("this_file_does_not_exist").Count);
+
+				CompileCommandCollection project2 = cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\project2.cpp");
+				Assert.AreEqual(2, project2.Count);
+				Assert.AreEqual(@"C:\home\john.doe\MyProjectA", project2[0].WorkingDirectory);
+				Assert.AreEqual(@"C:\home\john.doe\MyProjectB", project2[1].WorkingDirectory);
+
+				// Path lookups are normalized
+				Assert.AreEqual(2, cdb.GetCompileCommands(@"c:/home/john.doe/MyProject/subdir/../project2.cpp").Count);
+
+				// The same materialized command instances are shared across lookups
+				Assert.AreSame(project2[0], cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\project2.cpp")[0]);
+
+				// Argument strings are interned across commands
+				CompileCommandCollection allcommands = cdb.GetCompileCommands();
+				Assert.AreEqual(3, allcommands.Count);
+				Assert.AreEqual("clang++", allcommands[0].Arguments[0]);
+				Assert.AreSame(allcommands[0].Arguments[0], allcommands[2].Arguments[0]);
+				Assert.AreEqual(0, allcommands[0].SourceMappings.Count);
+
+				// Disposing of a lookup result should not affect the index
+				allcommands.Dispose();
+				Assert.AreEqual(3, cdb.GetCompileCommands().Count);
+			}
+		}
+
 		[TestMethod(), TestCategory("Compilation Database")]
 		public void CompilationDatabase_Dispose()
 		{
@@ -102,6 +142,170 @@ public void CompilationDatabase_GetCompileCommands()
 			}
 		}
 
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_GetCompileCommands_Infer()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, "input");
+			using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(inpath))
+			{
+				// Files in the database are returned as-is
+				CompileCommandCollection existent = cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\project.cpp", true);
+				Assert.AreEqual(1, existent.Count);
+				Assert.IsFalse(existent[0].IsInferred);
+				Assert.IsTrue(cdb.IsIndexed);
+
+				// A header file borrows the command of the source file with the same name
+				CompileCommandCollection header = cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\project.h", true);
+				Assert.AreEqual(1, header.Count);
+				Assert.IsTrue(header[0].IsInferred);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject\project.h", header[0].Filename);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject", header[0].WorkingDirectory);
+				Assert.AreEqual(5, header[0].Arguments.Count);
+				Assert.AreEqual("clang++", header[0].Arguments[0]);
+				Assert.AreEqual("-c", header[0].Arguments[1]);
+				Assert.AreEqual("-x", header[0].Arguments[2]);
+				Assert.AreEqual("c++-header", header[0].Arguments[3]);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject\project.h", header[0].Arguments[4]);
+
+				// A source file in a subdirectory borrows the command of a file in the nearest directory
+				CompileCommandCollection nested = cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\sub\other.cpp", true);
+				Assert.AreEqual(1, nested.Count);
+				Assert.IsTrue(nested[0].IsInferred);
+				Assert.AreEqual(3, nested[0].Arguments.Count);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject\sub\other.cpp", nested[0].Arguments[2]);
+
+				// Without inference a missing file still yields no commands
+				Assert.AreEqual(0, cdb.GetCompileCommands(@"C:\home\john.doe\MyProject\project.h", false).Count);
+			}
+		}
+
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_ValidationTime()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, "input");
+			using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(inpath))
+			{
+				// compile_commands.json exists in the input directory and was validated
+				Assert.IsTrue(cdb.ValidationTime >= TimeSpan.Zero);
+			}
+
+			// Property should not be accessible after disposal
+			CompilationDatabase database = Clang.CreateCompilationDatabase(inpath);
+			database.Dispose();
+			Assert.IsTrue(database.IsDisposed(() => { var v = database.ValidationTime; }));
+		}
+
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_GroupByFlags()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, "input");
+			using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(inpath))
+			{
+				// The first two commands only differ by their input and output files
+				var groups = cdb.GroupByFlags();
+				Assert.IsTrue(cdb.IsIndexed);
+				Assert.AreEqual(2, groups.Count);
+
+				Assert.AreEqual(2, groups[0].Commands.Count);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject\project.cpp", groups[0].Commands[0].Filename);
+				Assert.AreEqual(@"C:\home\john.doe\MyProject\project2.cpp", groups[0].Commands[1].Filename);
+				Assert.AreEqual(1, groups[1].Commands.Count);
+
+				// Normalized arguments exclude the input and output files
+				Assert.AreEqual(2, groups[0].Arguments.Count);
+				Assert.AreEqual("clang++", groups[0].Arguments[0]);
+				Assert.AreEqual("-c", groups[0].Arguments[1]);
+				Assert.AreEqual("-DFEATURE=1", groups[1].Arguments[2]);
+				Assert.AreSame(groups[0].Arguments, groups[0].Arguments);
+
+				// Fingerprints are distinct between groups and stable between calls
+				Assert.AreNotEqual(groups[0].Fingerprint, groups[1].Fingerprint);
+				Assert.IsFalse(groups[0].Fingerprint == groups[1].Fingerprint);
+				Assert.AreEqual(groups[0].Fingerprint, cdb.GroupByFlags()[0].Fingerprint);
+				Assert.AreEqual(groups[0].Fingerprint.GetHashCode(), cdb.GroupByFlags()[0].Fingerprint.GetHashCode());
+				Assert.AreEqual(32, groups[0].Fingerprint.ToString().Length);
+			}
+		}
+
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_GroupByFlags_ClOptions()
+		{
+			string dbpath = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			Directory.CreateDirectory(dbpath);
+
+			try
+			{
+				// An absolute POSIX input path that looks like a cl-style /I option, and a clang-cl command that uses one
+				File.WriteAllText(Path.Combine(dbpath, "compile_commands.json"), "[ " +
+					"{ \"directory\": \"C:/work\", \"arguments\": [ \"clang++\", \"-c\", \"/Include/foo.cpp\" ], \"file\": \"/Include/foo.cpp\" }, " +
+					"{ \"directory\": \"C:/work\", \"arguments\": [ \"clang-cl.exe\", \"/c\", \"/Iinc\", \"/Fox.obj\", \"x.cpp\" ], \"file\": \"x.cpp\" } ]");
+
+				using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(dbpath))
+				{
+					var groups = cdb.GroupByFlags();
+					Assert.AreEqual(2, groups.Count);
+
+					// The POSIX input file is dropped rather than being treated as an include path
+					var posix = (groups[0].Arguments[0] == "clang++") ? groups[0] : groups[1];
+					Assert.AreEqual(2, posix.Arguments.Count);
+					Assert.AreEqual("-c", posix.Arguments[1]);
+
+					// The cl-style options are recognized for clang-cl
+					var cl = (groups[0].Arguments[0] == "clang++") ? groups[1] : groups[0];
+					Assert.AreEqual(3, cl.Arguments.Count);
+					Assert.AreEqual("/c", cl.Arguments[1]);
+					Assert.AreEqual(@"/IC:\work\inc", cl.Arguments[2]);
+				}
+			}
+
+			finally { Directory.Delete(dbpath, true); }
+		}
+
+		[TestMethod(), TestCategory("Compilation Database")]
+		public void CompilationDatabase_Reload()
+		{
+			string dbpath = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			string jsonfile = Path.Combine(dbpath, "compile_commands.json");
+			string entry = "{{ \"directory\": \"{0}\", \"command\": \"clang++ {1} -o {2}.o -c {2}.cpp\", \"file\": \"{2}.cpp\" }}";
+			string dir = dbpath.Replace(@"\", @"\\");
+
+			Directory.CreateDirectory(dbpath);
+
+			try
+			{
+				File.WriteAllText(jsonfile, "[" + String.Join(",", String.Format(entry, dir, "", "a"), String.Format(entry, dir, "", "b"), 
+					String.Format(entry, dir, "", "c")) + "]");
+
+				using (CompilationDatabase cdb = Clang.CreateCompilationDatabase(dbpath))
+				{
+					// Reloading an unchanged database reports no changes
+					CompilationDatabaseDiff unchanged = cdb.Reload();
+					Assert.IsTrue(unchanged.IsEmpty);
+
+					// Changing only the output file does not change how the file is parsed
+					File.WriteAllText(jsonfile, "[" + String.Join(",", String.Format(entry, dir, "-DFEATURE=1", "a"), String.Format(entry, dir, "", "b2"),
+						String.Format(entry, dir, "", "c").Replace("-o c.o", "-o other.o"), String.Format(entry, dir, "", "d")) + "]");
+
+					CompilationDatabaseDiff diff = cdb.Reload();
+					Assert.IsFalse(diff.IsEmpty);
+
+					Assert.AreEqual(2, diff.Added.Count);
+					Assert.AreEqual(Path.Combine(dbpath, "b2.cpp"), diff.Added[0], true);
+					Assert.AreEqual(Path.Combine(dbpath, "d.cpp"), diff.Added[1], true);
+					Assert.AreEqual(1, diff.Removed.Count);
+					Assert.AreEqual(Path.Combine(dbpath, "b.cpp"), diff.Removed[0], true);
+					Assert.AreEqual(1, diff.Changed.Count);
+					Assert.AreEqual(Path.Combine(dbpath, "a.cpp"), diff.Changed[0], true);
+
+					// The instance now serves the reloaded commands
+					Assert.AreEqual(4, cdb.GetCompileCommands().Count);
+					Assert.AreEqual(0, cdb.GetCompileCommands(Path.Combine(dbpath, "b.cpp")).Count);
+				}
+			}
+
+			finally { Directory.Delete(dbpath, true); }
+		}
+
 		[TestMethod(), TestCategory("Compilation Database")]
 		public void CompileCommand_Arguments()
 		{
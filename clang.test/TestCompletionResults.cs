@@ -22,6 +22,7 @@
 
 using System;
 using System.IO;
+using System.Linq;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using zuki.tools.llvm.clang.extensions;
 
@@ -141,6 +142,101 @@ public void CompletionResultsCollection_Diagnostics()
 			}
 		}
 
+		[TestMethod(), TestCategory("Code Completion")]
+		public void CompletionResultsCollection_ExtractChunks()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\completion.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				Assert.IsNotNull(tu);
+
+				// get_Z().???
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, CompletionOptions.SortAlphabetical))
+				{
+					CompletionChunkTable table = results.ExtractChunks();
+					Assert.IsNotNull(table);
+					Assert.AreEqual(results.Count + 1, table.ResultOffsets.Length);
+					Assert.AreEqual(table.Count, table.ResultOffsets[results.Count]);
+					Assert.AreEqual(table.Count, table.Kinds.Length);
+					Assert.AreEqual(table.Count, table.Texts.Length);
+					Assert.AreEqual(table.Count, table.Depths.Length);
+					Assert.AreEqual(table.Count, table.ResultIndices.Length);
+
+					// The top-level rows of each result match the chunks of the completion string
+					for (int index = 0; index < results.Count; index++)
+					{
+						var chunks = results[index].String.Chunks;
+						int row = table.ResultOffsets[index];
+						foreach (CompletionChunk chunk in chunks)
+						{
+							while (table.Depths[row] != 0) row++;
+							Assert.AreEqual(index, table.ResultIndices[row]);
+							Assert.AreEqual(chunk.Kind, table.Kinds[row]);
+							Assert.AreEqual(chunk.Text, table.Texts[row]);
+							row++;
+						}
+					}
+
+					// double member
+					Assert.AreEqual(CompletionChunkKind.ResultType, table.Kinds[0]);
+					Assert.AreEqual("double", table.Texts[0]);
+					Assert.AreEqual(CompletionChunkKind.TypedText, table.Kinds[1]);
+					Assert.AreEqual("member", table.Texts[1]);
+
+					// Identical chunk texts are interned
+					int[] members = Enumerable.Range(0, table.Count).Where(row => table.Texts[row] == "member").ToArray();
+					Assert.IsTrue(members.Length > 1);
+					Assert.AreSame(table.Texts[members[0]], table.Texts[members[1]]);
+				}
+
+				// Filtered collections only extract the selected results
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, "memf", 10))
+				{
+					CompletionChunkTable table = results.ExtractChunks();
+					Assert.AreEqual(2, table.ResultOffsets.Length);
+					Assert.IsTrue(table.ResultIndices.All(index => index == 0));
+					Assert.IsTrue(table.Depths.Any(depth => depth > 0));
+				}
+			}
+		}
+
+		[TestMethod(), TestCategory("Code Completion")]
+		public void CompletionResultsCollection_Filter()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\completion.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				Assert.IsNotNull(tu);
+
+				// get_Z().mem???
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, "mem", 2))
+				{
+					Assert.IsNotNull(results);
+					Assert.AreEqual(2, results.Count);
+					Assert.AreSame(results[0], results[0]);
+					foreach (CompletionResult result in results)
+						Assert.IsTrue(result.String.Chunks.Any(chunk => chunk.Kind == CompletionChunkKind.TypedText && chunk.Text.StartsWith("mem")));
+				}
+
+				// get_Z().memf??? is a fuzzy match against only memfunc()
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, "mfn", 10))
+				{
+					Assert.AreEqual(1, results.Count);
+					Assert.IsTrue(results[0].String.Chunks.Any(chunk => chunk.Kind == CompletionChunkKind.TypedText && chunk.Text == "memfunc"));
+				}
+
+				// An empty filter selects the highest priority results
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, String.Empty, 5)) Assert.AreEqual(5, results.Count);
+
+				// A filter that matches nothing yields an empty collection
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, "zzz", 5)) Assert.AreEqual(0, results.Count);
+			}
+		}
+
 		[TestMethod(), TestCategory("Code Completion")]
 		public void CompletionResultsCollection_GetContainerCursorKind()
 		{
@@ -246,5 +342,92 @@ public void CompletionResultsCollection_Result()
 				}
 			}
 		}
+
+		[TestMethod(), TestCategory("Code Completion")]
+		public void TranslationUnit_PrewarmCompletions()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\completion.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				Assert.AreEqual(0, tu.PrewarmedCompletionCount);
+
+				var warm = tu.PrewarmCompletions(inpath, 22, 11);
+				Assert.IsTrue(warm.Wait(60000));
+				Assert.IsTrue(warm.Result >= 1);
+
+				// The pre-warmed results are handed over to the first matching request only
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11))
+				{
+					Assert.AreEqual(1, tu.PrewarmedCompletionCount);
+					Assert.AreNotEqual(0, results.Count);
+					Assert.IsTrue(results.Contexts.HasFlag(CompletionContext.DotMemberAccess));
+				}
+
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11)) Assert.AreNotEqual(0, results.Count);
+				Assert.AreEqual(1, tu.PrewarmedCompletionCount);
+
+				// Unsaved file contents that differ from the pre-warmed contents are not served from the cache
+				UnsavedFile[] unsaved = new UnsavedFile[] { new UnsavedFile(inpath, SysFile.ReadAllText(inpath)) };
+				Assert.IsTrue(tu.PrewarmCompletions(inpath, 22, 11, unsaved).Wait(60000));
+				unsaved[0].Content += "\n";
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11, unsaved)) Assert.AreNotEqual(0, results.Count);
+				Assert.AreEqual(1, tu.PrewarmedCompletionCount);
+
+				// Restarting cancels the earlier operations; only the last one produces results
+				tu.PrewarmCompletions(inpath, 22, 11);
+				tu.PrewarmCompletions(inpath, 22, 11);
+				Assert.IsTrue(tu.PrewarmCompletions(inpath, 22, 11).Wait(60000));
+				using (CompletionResultCollection results = tu.CompleteAt(inpath, 22, 11)) Assert.AreNotEqual(0, results.Count);
+				Assert.AreEqual(2, tu.PrewarmedCompletionCount);
+
+				// Disposing of the translation unit while pre-warming is in progress waits for it
+				tu.PrewarmCompletions(inpath, 22, 11);
+				tu.PrewarmCompletions(inpath, 22, 11);
+			}
+		}
+
+		[TestMethod(), TestCategory("Code Completion")]
+		public void CompletionSession_CompleteAt()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\completion.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				CompletionSession session = tu.CreateCompletionSession(inpath);
+				Assert.AreEqual(inpath, session.Filename);
+				Assert.AreEqual(0, session.QueryCount);
+
+				// get_Z().??? queries libclang
+				CompletionResultCollection all = session.CompleteAt(22, 11, String.Empty, 100);
+				Assert.AreEqual(1, session.QueryCount);
+				Assert.AreNotEqual(0, all.Count);
+
+				// get_Z().m??? and get_Z().mem??? refine the same results
+				CompletionResultCollection m = session.CompleteAt(22, 12, "m", 100);
+				CompletionResultCollection mem = session.CompleteAt(22, 14, "mem", 100);
+				Assert.AreEqual(1, session.QueryCount);
+				Assert.IsTrue(m.Count <= all.Count);
+				Assert.IsTrue(mem.Count <= m.Count);
+				Assert.AreNotEqual(0, mem.Count);
+
+				// Removing characters from the identifier queries libclang again
+				session.CompleteAt(22, 12, "m", 100);
+				Assert.AreEqual(2, session.QueryCount);
+
+				// Resetting the session queries libclang again
+				session.Reset();
+				session.CompleteAt(22, 13, "me", 100);
+				Assert.AreEqual(3, session.QueryCount);
+
+				// Collections from previous queries can no longer be accessed
+				Assert.IsTrue(mem.IsDisposed(() => { var v = mem[0]; }));
+
+				session.Dispose();
+				Assert.IsTrue(session.IsDisposed(() => { var v = session.QueryCount; }));
+			}
+		}
 	}
 }
@@ -313,6 +313,37 @@ public void Cursor_DefinitionCursor()
 			}
 		}
 
+		[TestMethod(), TestCategory("Cursors")]
+		public void Cursor_Descendants()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\hello.cpp");
+			using (TranslationUnit unit = s_index.CreateTranslationUnit(inpath))
+			{
+				Cursor main = unit.FindCursor("main");
+
+				// The lazy enumeration should produce the same preorder sequence as GetChildren(true)
+				var expected = main.GetChildren(true);
+				var actual = new List<Cursor>(main.Descendants());
+				Assert.AreEqual(expected.Count, actual.Count);
+				for (int index = 0; index < expected.Count; index++) Assert.AreEqual(expected[index].Item1, actual[index]);
+
+				// Abandoning the enumeration early should be supported
+				using (IEnumerator<Cursor> enumerator = main.Descendants().GetEnumerator())
+				{
+					Assert.IsTrue(enumerator.MoveNext());
+					Assert.AreEqual(expected[0].Item1, enumerator.Current);
+
+					// Reset should restart the traversal from the beginning
+					enumerator.Reset();
+					Assert.IsTrue(enumerator.MoveNext());
+					Assert.AreEqual(expected[0].Item1, enumerator.Current);
+				}
+
+				// A cursor without children produces an empty enumeration
+				Assert.IsFalse(Cursor.Null.Descendants().GetEnumerator().MoveNext());
+			}
+		}
+
 		[TestMethod(), TestCategory("Cursors")]
 		public void Cursor_DisplayName()
 		{
@@ -761,6 +792,63 @@ public void Cursor_GetSpellingNameExtents()
 			}
 		}
 
+		[TestMethod(), TestCategory("Cursors")]
+		public void Cursor_GetSpellingUtf8()
+		{
+			string code = "int x; int y;";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				Cursor cursor = unit.FindCursor("x");
+				Assert.IsNotNull(cursor);
+				Assert.IsFalse(Cursor.IsNull(cursor));
+
+				// Each call returns a new object that the caller owns
+				using (Utf8String spelling1 = cursor.GetSpellingUtf8())
+				using (Utf8String spelling2 = cursor.GetSpellingUtf8())
+				{
+					Assert.AreNotSame(spelling1, spelling2);
+					Assert.AreEqual(spelling1, spelling2);
+					Assert.AreEqual(spelling1.GetHashCode(), spelling2.GetHashCode());
+
+					Assert.AreEqual(1, spelling1.Length);
+					Assert.AreEqual((byte)'x', spelling1[0]);
+					CollectionAssert.AreEqual(System.Text.Encoding.UTF8.GetBytes(cursor.Spelling), spelling1.ToArray());
+					Assert.AreEqual(cursor.Spelling, spelling1.ToString());
+
+					// Once disposed, the string can no longer be accessed
+					spelling2.Dispose();
+					Assert.IsTrue(spelling2.IsDisposed(() => { var length = spelling2.Length; }));
+				}
+			}
+		}
+
+		[TestMethod(), TestCategory("Cursors")]
+		public void Cursor_GetUnifiedSymbolResolutionUtf8()
+		{
+			string code = "int x; int y;";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				Cursor cursor = unit.FindCursor("x");
+				Assert.IsNotNull(cursor);
+				Assert.IsFalse(Cursor.IsNull(cursor));
+
+				using (Utf8String usr = cursor.GetUnifiedSymbolResolutionUtf8())
+				{
+					Assert.AreEqual(cursor.UnifiedSymbolResolution.Utf8Length, usr.Length);
+					CollectionAssert.AreEqual(cursor.UnifiedSymbolResolution.ToUtf8Array(), usr.ToArray());
+
+					// Copy into an existing buffer at an offset
+					byte[] buffer = new byte[usr.Length + 2];
+					usr.CopyTo(buffer, 2);
+					Assert.AreEqual(usr[0], buffer[2]);
+
+					// The buffer must be large enough to hold the string
+					try { usr.CopyTo(buffer, 3); Assert.Fail("CopyTo: expected ArgumentException"); }
+					catch (Exception ex) { Assert.IsInstanceOfType(ex, typeof(ArgumentException)); }
+				}
+			}
+		}
+
 		[TestMethod(), TestCategory("Cursors")]
 		public void Cursor_HasAttributes()
 		{
@@ -2297,6 +2385,76 @@ public void EnumerateChildrenResult_ToString()
 			Assert.IsFalse(String.IsNullOrEmpty(EnumerateChildrenResult.Continue.ToString()));
 			Assert.IsFalse(String.IsNullOrEmpty(EnumerateChildrenResult.Recurse.ToString()));
 		}
+
+		[TestMethod(), TestCategory("Cursors")]
+		public void CursorBatch_Extract()
+		{
+			string code = "int x; static int y; int func(int a, int b);";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				List<Cursor> cursors = new List<Cursor>();
+				cursors.Add(unit.FindCursor("x"));
+				cursors.Add(unit.FindCursor("y"));
+				cursors.Add(unit.FindCursor("func"));
+
+				CursorBatch batch = CursorBatch.Extract(cursors, CursorFields.All);
+				Assert.IsNotNull(batch);
+				Assert.AreEqual(3, batch.Count);
+				Assert.AreEqual(CursorFields.All, batch.Fields);
+
+				// Every column must match the equivalent per-cursor property
+				for (int index = 0; index < cursors.Count; index++)
+				{
+					Cursor cursor = cursors[index];
+					Assert.AreEqual(cursor.Kind, batch.Kinds[index]);
+					Assert.AreEqual(cursor.Spelling, batch.Spellings[index]);
+					Assert.AreEqual(cursor.DisplayName, batch.DisplayNames[index]);
+					Assert.AreEqual(cursor.Type.Spelling, batch.TypeSpellings[index]);
+					Assert.AreEqual((string)cursor.UnifiedSymbolResolution, batch.UnifiedSymbolResolutions[index]);
+					Assert.AreEqual(cursor.Linkage, batch.Linkages[index]);
+					Assert.AreEqual(cursor.CxxAccessSpecifier, batch.CxxAccessSpecifiers[index]);
+					Assert.AreEqual(cursor.Extent.Start.Offset, batch.ExtentStartOffsets[index]);
+					Assert.AreEqual(cursor.Extent.End.Offset, batch.ExtentEndOffsets[index]);
+					Assert.AreEqual(cursor.Extent.Start.File.Name, batch.ExtentFileNames[index]);
+				}
+
+				// Identical strings are interned within the batch
+				Assert.AreSame(batch.TypeSpellings[0], batch.TypeSpellings[1]);
+				Assert.AreSame(batch.ExtentFileNames[0], batch.ExtentFileNames[2]);
+			}
+		}
+
+		[TestMethod(), TestCategory("Cursors")]
+		public void CursorBatch_ExtractFields()
+		{
+			string code = "int x; int y;";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				Cursor[] cursors = new Cursor[] { unit.FindCursor("x"), unit.FindCursor("y") };
+
+				// Only the requested columns should be generated
+				CursorBatch batch = CursorBatch.Extract(cursors, CursorFields.Kind | CursorFields.Spelling);
+				Assert.AreEqual(2, batch.Count);
+				Assert.IsNotNull(batch.Kinds);
+				Assert.IsNotNull(batch.Spellings);
+				Assert.IsNull(batch.DisplayNames);
+				Assert.IsNull(batch.TypeSpellings);
+				Assert.IsNull(batch.UnifiedSymbolResolutions);
+				Assert.IsNull(batch.Linkages);
+				Assert.IsNull(batch.CxxAccessSpecifiers);
+				Assert.IsNull(batch.ExtentFileNames);
+				Assert.IsNull(batch.ExtentStartOffsets);
+				Assert.IsNull(batch.ExtentEndOffsets);
+
+				Assert.AreEqual("x", batch.Spellings[0]);
+				Assert.AreEqual("y", batch.Spellings[1]);
+
+				// An empty list generates an empty batch
+				batch = CursorBatch.Extract(new Cursor[0], CursorFields.All);
+				Assert.AreEqual(0, batch.Count);
+			}
+		}
+
 		
 		//
 		// EXTENSIONS
@@ -52,6 +52,46 @@ public static void ClassCleanup()
 			s_tu.Dispose();
 		}
 
+		[TestMethod(), TestCategory("Diagnostics")]
+		public void Diagnostics_Aggregate()
+		{
+			string infile = Path.Combine(Environment.CurrentDirectory, @"input\diagnostics.cpp");
+
+			DiagnosticAggregator aggregator = new DiagnosticAggregator();
+			Assert.AreEqual(0, aggregator.Count);
+			Assert.AreEqual(0, aggregator.Diagnostics.Count);
+
+			// The first translation unit contributes every one of its diagnostics
+			Assert.AreEqual(6, aggregator.Add(s_tu));
+
+			// A second translation unit for the same file without -Wreturn-type contributes nothing new
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(infile, new string[] { "-Wno-return-type" }))
+			{
+				Assert.AreEqual(5, tu.Diagnostics.Count);
+				Assert.AreEqual(0, aggregator.Add(tu));
+			}
+
+			Assert.AreEqual(2, aggregator.TranslationUnitCount);
+			Assert.AreEqual(11, aggregator.OccurrenceCount);
+			Assert.AreEqual(6, aggregator.Count);
+
+			// The unique diagnostics are reported in the order they were first seen
+			var diagnostics = aggregator.Diagnostics;
+			Assert.AreEqual(6, diagnostics.Count);
+			for (int index = 0; index < diagnostics.Count; index++)
+			{
+				Assert.AreEqual(s_tu.Diagnostics[index].Spelling, diagnostics[index].Spelling);
+				Assert.AreEqual(s_tu.Diagnostics[index].Severity, diagnostics[index].Severity);
+				Assert.AreEqual(s_tu.Diagnostics[index].Category, diagnostics[index].Category);
+				Assert.AreEqual(s_tu.Diagnostics[index].EnableOption, diagnostics[index].EnableOption);
+				Assert.AreEqual(s_tu.Diagnostics[index].Location.File.Name, diagnostics[index].FileName);
+				Assert.AreEqual(s_tu.Diagnostics[index].Location.Offset, diagnostics[index].Offset);
+				Assert.AreEqual((index == 0) ? 1 : 2, diagnostics[index].Count);
+			}
+
+			Assert.IsNotNull(diagnostics[0].ToString());
+		}
+
 		[TestMethod(), TestCategory("Diagnostics")]
 		public void Diagnostics_Dispose()
 		{
@@ -82,6 +122,72 @@ public void Diagnostics_Dispose()
 			Assert.IsTrue(diags.IsDisposed(() => { foreach (Diagnostic d in diags) ; }));
 		}
 
+		[TestMethod(), TestCategory("Diagnostics")]
+		public void Diagnostics_Extract()
+		{
+			Assert.IsNotNull(s_tu);
+
+			// Only the requested columns are extracted, top-level diagnostics have no parent
+			DiagnosticTable table = s_tu.ExtractDiagnostics(DiagnosticFields.Severity);
+			Assert.AreEqual(DiagnosticFields.Severity, table.Fields);
+			Assert.AreEqual(s_tu.Diagnostics.Count, table.Count);
+			Assert.IsNotNull(table.Severities);
+			Assert.IsNull(table.Spellings);
+			Assert.IsNull(table.FileIds);
+			Assert.IsNull(table.FixItOffsets);
+			Assert.AreEqual(0, table.FileNames.Length);
+			foreach (int parent in table.ParentIndices) Assert.AreEqual(-1, parent);
+
+			// Extract everything and compare it against the object model
+			table = s_tu.ExtractDiagnostics(DiagnosticFields.All);
+			Assert.AreEqual(1, table.FileNames.Length);
+			Assert.AreEqual(s_tu.Spelling, table.FileNames[0]);
+
+			int row = 0;
+			foreach (Diagnostic diag in s_tu.Diagnostics)
+			{
+				int parent = row;
+				Assert.AreEqual(-1, table.ParentIndices[row]);
+
+				CompareDiagnostic(diag, table, row++);
+				foreach (Diagnostic child in diag.Children)
+				{
+					Assert.AreEqual(parent, table.ParentIndices[row]);
+					CompareDiagnostic(child, table, row++);
+				}
+			}
+
+			Assert.AreEqual(row, table.Count);
+			Assert.AreEqual(row + 1, table.FixItOffsets.Length);
+
+			// Identical strings share the same instance
+			Assert.AreSame(table.CategoryTexts[0], table.CategoryTexts[1]);
+		}
+
+		private static void CompareDiagnostic(Diagnostic diag, DiagnosticTable table, int row)
+		{
+			Assert.AreEqual(diag.Severity, table.Severities[row]);
+			Assert.AreEqual(diag.Spelling, table.Spellings[row]);
+			Assert.AreEqual(diag.Location.File.Name, table.FileNames[table.FileIds[row]]);
+			Assert.AreEqual(diag.Location.Line, table.Lines[row]);
+			Assert.AreEqual(diag.Location.Column, table.Columns[row]);
+			Assert.AreEqual(diag.Location.Offset, table.Offsets[row]);
+			Assert.AreEqual(diag.Category.Number, table.CategoryNumbers[row]);
+			Assert.AreEqual(diag.Category.Text, table.CategoryTexts[row]);
+			Assert.AreEqual(diag.EnableOption, table.EnableOptions[row]);
+			Assert.AreEqual(diag.DisableOption, table.DisableOptions[row]);
+
+			int first = table.FixItOffsets[row];
+			Assert.AreEqual(diag.FixIts.Count, table.FixItOffsets[row + 1] - first);
+			for (int index = 0; index < diag.FixIts.Count; index++)
+			{
+				Assert.AreEqual(diag.FixIts[index].ReplacementText, table.FixItReplacements[first + index]);
+				Assert.AreEqual(diag.FixIts[index].Extent.Start.Offset, table.FixItStartOffsets[first + index]);
+				Assert.AreEqual(diag.FixIts[index].Extent.End.Offset, table.FixItEndOffsets[first + index]);
+				Assert.AreEqual(0, table.FixItFileIds[first + index]);
+			}
+		}
+
 		[TestMethod(), TestCategory("Diagnostics")]
 		public void Diagnostic_Category()
 		{
@@ -213,6 +213,16 @@ public void File_GetLocation()
 			Assert.IsFalse(Location.IsNull(s_hello.GetLocation(1, 1)));
 		}
 
+		[TestMethod(), TestCategory("Files")]
+		public void File_GetNameUtf8()
+		{
+			using (Utf8String name = s_hello.GetNameUtf8())
+			{
+				Assert.AreEqual(s_hello.Name, name.ToString());
+				CollectionAssert.AreEqual(System.Text.Encoding.UTF8.GetBytes(s_hello.Name), name.ToArray());
+			}
+		}
+
 		[TestMethod(), TestCategory("Files")]
 		public void File_IsMultipleIncludeGuarded()
 		{
@@ -168,5 +168,59 @@ public void ModuleMapDescriptorExtensions_WriteTo()
 				}
 			}
 		}
+
+		[TestMethod(), TestCategory("Module Map Descriptors")]
+		public void ModuleMapDescriptor_ImplicitModuleCache()
+		{
+			string workspace = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			string headers = Path.Combine(workspace, "include");
+			Directory.CreateDirectory(headers);
+
+			try
+			{
+				string main = Path.Combine(workspace, "main.cpp");
+				SysFile.WriteAllText(Path.Combine(headers, "widget.h"), "#pragma once\nstruct widget { int value; };");
+				SysFile.WriteAllText(main, "#include \"widget.h\"\nint get(widget w) { return w.value; }");
+
+				// Write a compilation database with a single command that uses the header directory; the
+				// source file and include path are relative to the command's working directory
+				string json = "[ { \"directory\": \"" + workspace.Replace('\\', '/') + "\", \"arguments\": [ \"clang++\", \"-c\", " + 
+					"\"-Iinclude\", \"main.cpp\" ], \"file\": \"" + main.Replace('\\', '/') + "\" } ]";
+				SysFile.WriteAllText(Path.Combine(workspace, "compile_commands.json"), json);
+
+				ImplicitModuleCache cache = new ImplicitModuleCache(Path.Combine(workspace, "cache"));
+				Assert.AreNotEqual(0UL, cache.BuildSessionTimestamp);
+
+				string modulename = cache.AddHeaderDirectory(headers);
+				Assert.AreEqual("include", modulename);
+				Assert.AreEqual(modulename, cache.AddHeaderDirectory(headers));
+				Assert.AreEqual(1, cache.ModuleMapFiles.Count);
+				Assert.IsTrue(SysFile.Exists(cache.ModuleMapFiles[0]));
+
+				using (CompilationDatabase database = Clang.CreateCompilationDatabase(workspace))
+				using (CompileCommandCollection commands = database.GetCompileCommands())
+				{
+					Assert.AreEqual(1, commands.Count);
+
+					string[] args = cache.GetArguments(commands[0]);
+					Assert.AreEqual("-working-directory=" + commands[0].WorkingDirectory, args[1]);
+					Assert.AreEqual("-fmodules", args[2]);
+					Assert.AreEqual(commands[0].Arguments.Count + 7, args.Length);
+
+					using (Index index = Clang.CreateIndex())
+					using (TranslationUnit tu = cache.CreateTranslationUnit(index, commands[0]))
+					{
+						Assert.AreEqual(0, tu.Diagnostics.Count);
+						Assert.IsFalse(Cursor.IsNull(tu.Cursor.FindCursor("get")));
+					}
+				}
+
+				// Clearing the cache removes the compiled modules but not the module maps
+				cache.Clear();
+				Assert.IsTrue(SysFile.Exists(cache.ModuleMapFiles[0]));
+			}
+
+			finally { Directory.Delete(workspace, true); }
+		}
 	}
 }
@@ -109,6 +109,22 @@ public void Token_Extent()
 			}
 		}
 
+		[TestMethod(), TestCategory("Tokens")]
+		public void Token_GetSpellingUtf8()
+		{
+			Assert.IsNotNull(s_tokens);
+
+			// The raw UTF-8 spelling must match the converted spelling for every token
+			foreach (Token token in s_tokens)
+			{
+				using (Utf8String spelling = token.GetSpellingUtf8())
+				{
+					Assert.IsTrue(spelling.Length > 0);
+					Assert.AreEqual(token.Spelling, spelling.ToString());
+				}
+			}
+		}
+
 		[TestMethod(), TestCategory("Tokens")]
 		public void Token_Location()
 		{
@@ -182,6 +182,31 @@ public void TranslationUnit_GetFile()
 			}
 		}
 
+		[TestMethod(), TestCategory("Translation Units")]
+		public void TranslationUnit_LiveCount()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\hello.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			int livecount;
+			long livebytes;
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				Assert.IsNotNull(tu);
+
+				// The live translation unit should be reflected in the process-wide counters
+				livecount = TranslationUnit.LiveCount;
+				livebytes = TranslationUnit.LiveNativeBytes;
+				Assert.IsTrue(livecount >= 1);
+				Assert.IsTrue(livebytes > 0);
+			}
+
+			// Disposal releases the unmanaged translation unit and the counters
+			Assert.IsTrue(TranslationUnit.LiveCount < livecount);
+			Assert.IsTrue(TranslationUnit.LiveNativeBytes < livebytes);
+		}
+
 		[TestMethod(), TestCategory("Translation Units")]
 		public void TranslationUnit_ResourceUsage()
 		{
@@ -236,6 +261,39 @@ public void TranslationUnit_Save()
 			finally { SysFile.Delete(outpath); }
 		}
 
+		[TestMethod(), TestCategory("Translation Units")]
+		public void TranslationUnit_ShareCursorInstances()
+		{
+			string inpath = Path.Combine(Environment.CurrentDirectory, @"input\hello.cpp");
+			Assert.IsTrue(SysFile.Exists(inpath));
+
+			using (TranslationUnit tu = Clang.CreateTranslationUnit(inpath))
+			{
+				Assert.IsNotNull(tu);
+
+				// Sharing is opt-in, equal cursors are distinct instances by default
+				Assert.IsFalse(tu.ShareCursorInstances);
+				Assert.AreNotSame(tu.FindCursor("main"), tu.FindCursor("main"));
+
+				// Once enabled, equal cursors should resolve to the same instance
+				tu.ShareCursorInstances = true;
+				Assert.IsTrue(tu.ShareCursorInstances);
+
+				Cursor main = tu.FindCursor("main");
+				Assert.AreSame(main, tu.FindCursor("main"));
+				Assert.AreSame(main, main.CanonicalCursor);
+				Assert.AreSame(main, main.Location.Cursor);
+
+				// Cached properties are shared along with the instance
+				Assert.AreSame(main.DisplayName, tu.FindCursor("main").DisplayName);
+
+				// Disabling sharing releases the map, new lookups are distinct again
+				tu.ShareCursorInstances = false;
+				Assert.IsFalse(tu.ShareCursorInstances);
+				Assert.AreNotSame(main, tu.FindCursor("main"));
+			}
+		}
+
 		[TestMethod(), TestCategory("Translation Units")]
 		public void TranslationUnit_Spelling()
 		{
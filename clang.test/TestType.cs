@@ -442,6 +442,46 @@ public void Type_GetHashCode()
 			}
 		}
 
+		[TestMethod(), TestCategory("Types")]
+		public void Type_GetSpellingUtf8()
+		{
+			string code = "char x; long long z;";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				Type type = unit.FindCursor("z").Type;
+				Assert.IsNotNull(type);
+
+				using (Utf8String spelling = type.GetSpellingUtf8())
+				{
+					Assert.AreEqual("long long", spelling.ToString());
+					CollectionAssert.AreEqual(System.Text.Encoding.UTF8.GetBytes(type.Spelling), spelling.ToArray());
+				}
+			}
+		}
+
+		[TestMethod(), TestCategory("Types")]
+		public void Type_Interning()
+		{
+			string code = "typedef int mytype; mytype x; mytype y; int z;";
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code))
+			{
+				// Equal types are shared instances within the translation unit
+				Type typex = unit.FindCursor("x").Type;
+				Assert.IsNotNull(typex);
+				Assert.AreSame(typex, unit.FindCursor("y").Type);
+
+				// The canonical type is shared with the plain int type and
+				// is its own canonical type
+				Type typez = unit.FindCursor("z").Type;
+				Assert.AreNotSame(typex, typez);
+				Assert.AreSame(typez, typex.CanonicalType);
+				Assert.AreSame(typez, typez.CanonicalType);
+
+				// Cached properties are shared along with the instance
+				Assert.AreSame(typex.Spelling, unit.FindCursor("y").Type.Spelling);
+			}
+		}
+
 		[TestMethod(), TestCategory("Types")]
 		public void Type_IsConstQualified()
 		{
@@ -909,5 +949,63 @@ public void TypeExtensions_GetFields()
 				Assert.AreNotEqual(0, result.Count);
 			}
 		}
+
+
+		[TestMethod(), TestCategory("Types")]
+		public void RecordLayout_ExtractAll()
+		{
+			string code = "struct outer { int a; union { char b; short c; }; struct inner { unsigned d : 3; unsigned e : 5; } f; double g; };" +
+				"template<typename T> struct dependent { T t; }; struct incomplete;";
+
+			using (TranslationUnit unit = s_index.CreateTranslationUnitFromString(code, Language.CPlusPlus))
+			{
+				RecordLayout layout = RecordLayout.ExtractAll(unit);
+				Assert.IsNotNull(layout);
+
+				// Dependent and incomplete records have no layout
+				Assert.AreEqual(3, layout.Count);
+				Assert.AreEqual(8, layout.FieldCount);
+				Assert.AreEqual(layout.Count + 1, layout.FieldStartIndices.Length);
+				Assert.AreEqual(layout.FieldCount, layout.FieldStartIndices[layout.Count]);
+
+				// outer
+				Assert.AreEqual("outer", layout.Names[0]);
+				Assert.AreEqual(CursorKind.StructDecl, layout.Kinds[0]);
+				Assert.AreEqual(24L, layout.Sizes[0]);
+				Assert.AreEqual(8L, layout.Alignments[0]);
+				Assert.AreEqual(-1, layout.ParentIndices[0]);
+				Assert.IsFalse(layout.IsAnonymous[0]);
+				Assert.AreEqual(0, layout.FieldStartIndices[0]);
+				Assert.AreEqual(4, layout.FieldStartIndices[1]);
+
+				// outer::(anonymous union)
+				Assert.AreEqual(CursorKind.UnionDecl, layout.Kinds[1]);
+				Assert.AreEqual(2L, layout.Sizes[1]);
+				Assert.AreEqual(0, layout.ParentIndices[1]);
+				Assert.IsTrue(layout.IsAnonymous[1]);
+				Assert.AreEqual(1, layout.FieldRecordIndices[1]);
+				Assert.AreEqual(32L, layout.FieldBitOffsets[1]);
+
+				// outer::inner
+				Assert.AreEqual("outer::inner", layout.Names[2]);
+				Assert.AreEqual(4L, layout.Sizes[2]);
+				Assert.AreEqual(0, layout.ParentIndices[2]);
+				Assert.AreEqual("f", layout.FieldNames[2]);
+				Assert.AreEqual(2, layout.FieldRecordIndices[2]);
+				Assert.AreEqual(64L, layout.FieldBitOffsets[2]);
+
+				// Fields of outer::inner are bit fields
+				Assert.AreEqual("e", layout.FieldNames[7]);
+				Assert.AreEqual(3L, layout.FieldBitOffsets[7]);
+				Assert.AreEqual(5, layout.FieldBitWidths[7]);
+
+				// Non bit fields report a width of -1 and scalar fields have no record
+				Assert.AreEqual("g", layout.FieldNames[3]);
+				Assert.AreEqual("double", layout.FieldTypeNames[3]);
+				Assert.AreEqual(128L, layout.FieldBitOffsets[3]);
+				Assert.AreEqual(-1, layout.FieldBitWidths[3]);
+				Assert.AreEqual(-1, layout.FieldRecordIndices[3]);
+			}
+		}
 	}
 }
@@ -178,6 +178,63 @@ public void UnifiedSymbolResolution_GetHashCode()
 			Assert.AreNotEqual(0, classusr.GetHashCode());
 		}
 
+		[TestMethod, TestCategory("Unified Symbol Resolution")]
+		public void UnifiedSymbolResolution_Utf8()
+		{
+			// c:objc(cs)classname
+			UnifiedSymbolResolution classusr = UnifiedSymbolResolution.FromObjectiveCClass("classname");
+			Assert.IsNotNull(classusr);
+
+			byte[] expected = System.Text.Encoding.UTF8.GetBytes("c:objc(cs)classname");
+			Assert.AreEqual(expected.Length, classusr.Utf8Length);
+			CollectionAssert.AreEqual(expected, classusr.ToUtf8Array());
+
+			// ToUtf8Array returns a copy, modifying it cannot affect the USR
+			classusr.ToUtf8Array()[0] = 0;
+			CollectionAssert.AreEqual(expected, classusr.ToUtf8Array());
+
+			byte[] buffer = new byte[expected.Length + 1];
+			classusr.CopyUtf8To(buffer, 1);
+			Assert.AreEqual(expected[0], buffer[1]);
+		}
+
+		[TestMethod, TestCategory("Unified Symbol Resolution")]
+		public void UnifiedSymbolResolution_Interner()
+		{
+			UnifiedSymbolResolutionInterner interner = new UnifiedSymbolResolutionInterner();
+			Assert.AreEqual(1, interner.Count);
+
+			// Identifiers are dense and equal USRs share the same identifier
+			int classid = interner.GetId(UnifiedSymbolResolution.FromObjectiveCClass("classname"));
+			int protocolid = interner.GetId(UnifiedSymbolResolution.FromObjectiveCProtocol("protocolname"));
+			Assert.AreEqual(1, classid);
+			Assert.AreEqual(2, protocolid);
+			Assert.AreEqual(classid, interner.GetId(UnifiedSymbolResolution.FromObjectiveCClass("classname")));
+			Assert.AreEqual(3, interner.Count);
+
+			// Identifiers can be mapped back into the USR
+			Assert.AreEqual(UnifiedSymbolResolution.FromObjectiveCClass("classname"), interner.GetUnifiedSymbolResolution(classid));
+			Assert.AreEqual(String.Empty, (string)interner.GetUnifiedSymbolResolution(0));
+			try { interner.GetUnifiedSymbolResolution(3); Assert.Fail(); }
+			catch (Exception ex) { Assert.IsInstanceOfType(ex, typeof(ArgumentOutOfRangeException)); }
+
+			// Cursors use the process-wide interner
+			using (Index index = Clang.CreateIndex())
+			{
+				using (TranslationUnit tu = index.CreateTranslationUnitFromString("extern int x; int x; int y;"))
+				{
+					var cursors = tu.Cursor.FindChildren((c, p) => c.Spelling == "x");
+					Assert.AreEqual(2, cursors.Count);
+
+					Cursor first = cursors[0].Item1;
+					Assert.AreNotEqual(0, first.UnifiedSymbolResolutionId);
+					Assert.AreEqual(first.UnifiedSymbolResolutionId, cursors[1].Item1.UnifiedSymbolResolutionId);
+					Assert.AreNotEqual(first.UnifiedSymbolResolutionId, tu.FindCursor("y").UnifiedSymbolResolutionId);
+					Assert.AreEqual(first.UnifiedSymbolResolution, UnifiedSymbolResolutionInterner.Default.GetUnifiedSymbolResolution(first.UnifiedSymbolResolutionId));
+				}
+			}
+		}
+
 		[TestMethod, TestCategory("Unified Symbol Resolution")]
 		public void UnifiedSymbolResolution_ToString()
 		{
@@ -22,7 +22,9 @@
 
 using System;
 using System.IO;
+using System.Text;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
+using zuki.tools.llvm.clang.extensions;
 
 using SysFile = System.IO.File;
 
@@ -100,5 +102,107 @@ public void UnsavedFile_FileName()
 			file.FileName = "unsaved.c";
 			Assert.AreEqual("unsaved.c", file.FileName);
 		}
+
+		[TestMethod, TestCategory("Unsaved Files")]
+		public void UnsavedFile_WorkspaceSnapshot()
+		{
+			string workspace = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			Directory.CreateDirectory(workspace);
+
+			try
+			{
+				string header = Path.Combine(workspace, "header.h");
+				string main = Path.Combine(workspace, "main.c");
+				SysFile.WriteAllText(header, "int snapshot(void);");
+				SysFile.WriteAllText(main, "#include \"header.h\"\nint main(void) { return snapshot(); }");
+				SysFile.WriteAllText(Path.Combine(workspace, "copy.h"), "int snapshot(void);");
+
+				using (WorkspaceSnapshot snapshot = WorkspaceSnapshot.Create(new string[] { workspace }))
+				{
+					Assert.AreEqual(3, snapshot.Count);
+					Assert.AreEqual(2, snapshot.ContentCount);
+					Assert.AreEqual(snapshot.GetContentHash(header), snapshot.GetContentHash(Path.Combine(workspace, "copy.h")));
+					Assert.AreEqual(3, snapshot.GetUnsavedFiles().Length);
+
+					// Change the header on disk, the parse must still see the snapshot contents
+					SysFile.WriteAllText(header, "int changed(void);");
+					SysFile.SetLastWriteTimeUtc(header, DateTime.UtcNow.AddMinutes(1));
+
+					using (Index index = Clang.CreateIndex())
+					{
+						using (TranslationUnit tu = snapshot.CreateTranslationUnit(index, main, null))
+						{
+							Assert.AreEqual(0, tu.Diagnostics.Count);
+							Assert.IsFalse(Cursor.IsNull(tu.Cursor.FindCursor("snapshot")));
+						}
+					}
+
+					// A snapshot created from the baseline only reads the changed file
+					using (WorkspaceSnapshot updated = WorkspaceSnapshot.Create(new string[] { workspace }, "*", snapshot))
+					{
+						Assert.AreEqual(3, updated.Count);
+						Assert.AreEqual(3, updated.ContentCount);
+						Assert.AreEqual(snapshot.GetContentHash(main), updated.GetContentHash(main));
+						Assert.AreNotEqual(snapshot.GetContentHash(header), updated.GetContentHash(header));
+					}
+				}
+			}
+
+			finally { Directory.Delete(workspace, true); }
+		}
+
+		[TestMethod, TestCategory("Unsaved Files")]
+		public void UnsavedFile_WorkspaceSnapshotOverlay()
+		{
+			string workspace = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+			string cache = workspace + ".cache";
+			Directory.CreateDirectory(workspace);
+
+			try
+			{
+				string header = Path.Combine(workspace, "header.h");
+				SysFile.WriteAllText(header, "int first(void);");
+
+				using (WorkspaceSnapshot snapshot = WorkspaceSnapshot.Create(new string[] { workspace }))
+				{
+					// Cached files are named by the hash of their contents
+					string cached = Path.Combine(cache, snapshot.GetContentHash(header).ToString("x16"));
+					using (VirtualFileOverlay overlay = snapshot.CreateOverlay(cache))
+					{
+						Assert.IsTrue(Encoding.UTF8.GetString(overlay.ToByteArray()).Contains(Path.GetFileName(cached)));
+					}
+					Assert.AreEqual("int first(void);", SysFile.ReadAllText(cached));
+
+					// A cached file with the same length but different contents is rewritten
+					SysFile.WriteAllText(cached, "int other(void);");
+					using (VirtualFileOverlay overlay = snapshot.CreateOverlay(cache)) Assert.IsNotNull(overlay);
+					Assert.AreEqual("int first(void);", SysFile.ReadAllText(cached));
+
+					// An edit that keeps the length of the file maps to the new contents
+					SysFile.WriteAllText(header, "int other(void);");
+					SysFile.SetLastWriteTimeUtc(header, DateTime.UtcNow.AddMinutes(1));
+
+					using (WorkspaceSnapshot updated = WorkspaceSnapshot.Create(new string[] { workspace }, "*", snapshot))
+					{
+						string edited = Path.Combine(cache, updated.GetContentHash(header).ToString("x16"));
+						Assert.AreNotEqual(cached, edited);
+
+						using (VirtualFileOverlay overlay = updated.CreateOverlay(cache))
+						{
+							string yaml = Encoding.UTF8.GetString(overlay.ToByteArray());
+							Assert.IsTrue(yaml.Contains(Path.GetFileName(edited)));
+							Assert.IsFalse(yaml.Contains(Path.GetFileName(cached)));
+						}
+						Assert.AreEqual("int other(void);", SysFile.ReadAllText(edited));
+					}
+				}
+			}
+
+			finally
+			{
+				Directory.Delete(workspace, true);
+				if (Directory.Exists(cache)) Directory.Delete(cache, true);
+			}
+		}
 	}
 }
@@ -0,0 +1,203 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "AggregatedDiagnostic.h"
+
+#include "StringInterner.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic Constructor (private)
+//
+// Arguments:
+//
+//	diagnostic	- First occurrence of the diagnostic
+//	strings		- String interner shared by the aggregator
+
+AggregatedDiagnostic::AggregatedDiagnostic(CXDiagnostic diagnostic, StringInterner^ strings) : m_category(diagnostic), m_count(1)
+{
+	CXFile					file;					// Location file
+	unsigned int			line, column, offset;	// Location information
+	CXString				disableopt;				// Disable option string
+
+	if(Object::ReferenceEquals(strings, nullptr)) throw gcnew ArgumentNullException("strings");
+
+	m_severity = DiagnosticSeverity(clang_getDiagnosticSeverity(diagnostic));
+	m_spelling = strings->Intern(clang_getDiagnosticSpelling(diagnostic));
+
+	// clang_getDiagnosticOption returns both strings, and they both have to be disposed of
+	m_enableopt = strings->Intern(clang_getDiagnosticOption(diagnostic, &disableopt));
+	clang_disposeString(disableopt);
+
+	// Use the same spelling location that Diagnostic::Location reports to the caller
+	clang_getSpellingLocation(clang_getDiagnosticLocation(diagnostic), &file, &line, &column, &offset);
+
+	m_filename = (file == __nullptr) ? String::Empty : strings->Intern(clang_getFileName(file));
+	m_line = static_cast<int>(line);
+	m_column = static_cast<int>(column);
+	m_offset = static_cast<int>(offset);
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::AddOccurrence (internal)
+//
+// Records another occurrence of the diagnostic
+//
+// Arguments:
+//
+//	severity	- Severity with which the diagnostic was reported
+
+void AggregatedDiagnostic::AddOccurrence(DiagnosticSeverity severity)
+{
+	m_count++;
+	if(severity > m_severity) m_severity = severity;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Category::get
+//
+// Gets the category of the diagnostic
+
+DiagnosticCategory AggregatedDiagnostic::Category::get(void)
+{
+	return m_category;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Column::get
+//
+// Gets the column number of the diagnostic location
+
+int AggregatedDiagnostic::Column::get(void)
+{
+	return m_column;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Count::get
+//
+// Gets the number of times the diagnostic was reported
+
+int AggregatedDiagnostic::Count::get(void)
+{
+	return m_count;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Create (internal, static)
+//
+// Creates a new AggregatedDiagnostic instance from the first occurrence
+//
+// Arguments:
+//
+//	diagnostic	- First occurrence of the diagnostic
+//	strings		- String interner shared by the aggregator
+
+AggregatedDiagnostic^ AggregatedDiagnostic::Create(CXDiagnostic diagnostic, StringInterner^ strings)
+{
+	return gcnew AggregatedDiagnostic(diagnostic, strings);
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::EnableOption::get
+//
+// Gets the command line option that enables the diagnostic
+
+String^ AggregatedDiagnostic::EnableOption::get(void)
+{
+	return m_enableopt;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::FileName::get
+//
+// Gets the name of the file in which the diagnostic is located
+
+String^ AggregatedDiagnostic::FileName::get(void)
+{
+	return m_filename;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Line::get
+//
+// Gets the line number of the diagnostic location
+
+int AggregatedDiagnostic::Line::get(void)
+{
+	return m_line;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Offset::get
+//
+// Gets the file offset of the diagnostic location
+
+int AggregatedDiagnostic::Offset::get(void)
+{
+	return m_offset;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Severity::get
+//
+// Gets the highest severity with which the diagnostic was reported
+
+DiagnosticSeverity AggregatedDiagnostic::Severity::get(void)
+{
+	return m_severity;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::Spelling::get
+//
+// Gets the text of the diagnostic
+
+String^ AggregatedDiagnostic::Spelling::get(void)
+{
+	return m_spelling;
+}
+
+//---------------------------------------------------------------------------
+// AggregatedDiagnostic::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ AggregatedDiagnostic::ToString(void)
+{
+	// [File]([Line],[Column]): [Severity]: [Spelling] (x[Count])
+	return String::Format("{0}({1},{2}): {3}: {4} (x{5})", m_filename, m_line, m_column, m_severity.ToString(), m_spelling, m_count);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,176 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __AGGREGATEDDIAGNOSTIC_H_
+#define __AGGREGATEDDIAGNOSTIC_H_
+#pragma once
+
+#include "DiagnosticCategory.h"
+#include "DiagnosticSeverity.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	StringInterner;
+
+//---------------------------------------------------------------------------
+// Class AggregatedDiagnostic
+//
+// Describes a unique diagnostic collected by a DiagnosticAggregator along
+// with the number of times it was reported.  The properties are captured
+// from the first occurrence; the severity is the highest that was reported
+//---------------------------------------------------------------------------
+
+public ref class AggregatedDiagnostic
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Category
+	//
+	// Gets the category of the diagnostic
+	property DiagnosticCategory Category
+	{
+		DiagnosticCategory get(void);
+	}
+
+	// Column
+	//
+	// Gets the column number of the diagnostic location
+	property int Column
+	{
+		int get(void);
+	}
+
+	// Count
+	//
+	// Gets the number of times the diagnostic was reported
+	property int Count
+	{
+		int get(void);
+	}
+
+	// EnableOption
+	//
+	// Gets the command line option that enables the diagnostic
+	property String^ EnableOption
+	{
+		String^ get(void);
+	}
+
+	// FileName
+	//
+	// Gets the name of the file in which the diagnostic is located
+	property String^ FileName
+	{
+		String^ get(void);
+	}
+
+	// Line
+	//
+	// Gets the line number of the diagnostic location
+	property int Line
+	{
+		int get(void);
+	}
+
+	// Offset
+	//
+	// Gets the file offset of the diagnostic location
+	property int Offset
+	{
+		int get(void);
+	}
+
+	// Severity
+	//
+	// Gets the highest severity with which the diagnostic was reported
+	property DiagnosticSeverity Severity
+	{
+		DiagnosticSeverity get(void);
+	}
+
+	// Spelling
+	//
+	// Gets the text of the diagnostic
+	property String^ Spelling
+	{
+		String^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AddOccurrence
+	//
+	// Records another occurrence of the diagnostic
+	void AddOccurrence(DiagnosticSeverity severity);
+
+	// Create (static)
+	//
+	// Creates a new AggregatedDiagnostic instance from the first occurrence
+	static AggregatedDiagnostic^ Create(CXDiagnostic diagnostic, StringInterner^ strings);
+
+private:
+
+	// Instance Constructor
+	//
+	AggregatedDiagnostic(CXDiagnostic diagnostic, StringInterner^ strings);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	DiagnosticCategory				m_category;			// Diagnostic category
+	DiagnosticSeverity				m_severity;			// Highest severity
+	String^							m_spelling;			// Diagnostic spelling
+	String^							m_enableopt;		// Enable option
+	String^							m_filename;			// Location file name
+	int								m_line;				// Location line number
+	int								m_column;			// Location column number
+	int								m_offset;			// Location file offset
+	int								m_count;			// Number of occurrences
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __AGGREGATEDDIAGNOSTIC_H_
@@ -28,9 +28,11 @@
 #include "CompilationDatabaseLoadException.h"
 #include "DiagnosticLoadException.h"
 #include "Index.h"
+#include "JsonValidator.h"
 #include "LoadedDiagnosticCollection.h"
 #include "ModuleMapDescriptor.h"
 #include "RemappingCollection.h"
+#include "SerializedDiagnosticReader.h"
 #include "StringUtil.h"
 #include "TranslationUnit.h"
 #include "TranslationUnitParseOptions.h"
@@ -53,6 +55,7 @@ namespace zuki::tools::llvm::clang {
 CompilationDatabase^ Clang::CreateCompilationDatabase(String^ path)
 {
 	CXCompilationDatabase_Error		result;		// Result from compilation database operation
+	TimeSpan						validation;	// Time spent validating the JSON
 
 	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
 	char* pszpath = StringUtil::ToCharPointer(path, CP_UTF8);
@@ -61,23 +64,15 @@ CompilationDatabase^ Clang::CreateCompilationDatabase(String^ path)
 
 #pragma message("CLANG WORKAROUND: Invalid JSON causes loader lock problem")
 		// If the compile_commands.json file has a problem, calling clang_CompilationDatabase_fromDirectory() will
-		// cause a loader lock problem.  Avoid this by checking that the JSON will parse before calling clang
+		// cause a loader lock problem.  Avoid this by checking that the JSON is well-formed before calling clang
 		String^ jsonfile = Path::Combine(path, "compile_commands.json");
-		if(System::IO::File::Exists(jsonfile)) {
-
-			DataContractJsonSerializer^ json = gcnew DataContractJsonSerializer(Object::typeid);
-			MemoryStream^ ms = gcnew MemoryStream(System::IO::File::ReadAllBytes(jsonfile));
-			
-			// Attempt to read the JSON data from the memory stream to ensure that it's not malformed
-			try { json->ReadObject(ms); }
-			finally { delete ms; }
-		}
+		if(System::IO::File::Exists(jsonfile)) validation = JsonValidator::Validate(jsonfile);
 
 		// Attempt to create the compilation database from the specified directory
 		CXCompilationDatabase database = clang_CompilationDatabase_fromDirectory(pszpath, &result);
 		if(result != CXCompilationDatabase_NoError) throw gcnew CompilationDatabaseLoadException(result);
 
-		return CompilationDatabase::Create(std::move(database));
+		return CompilationDatabase::Create(std::move(database), path, validation);
 	}
 	
 	finally { StringUtil::FreeCharPointer(pszpath); }
@@ -402,6 +397,21 @@ TranslationUnit^ Clang::LoadTranslationUnit(String^ path)
 	return index->LoadTranslationUnit(path);
 }
 
+//---------------------------------------------------------------------------
+// Clang::OpenDiagnostics (static)
+//
+// Opens a serialized diagnostics file for streaming
+//
+// Arguments:
+//
+//	path		- Path to the serialized diagnostics file to open
+
+SerializedDiagnosticReader^ Clang::OpenDiagnostics(String^ path)
+{
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+	return SerializedDiagnosticReader::Create(path);
+}
+
 //---------------------------------------------------------------------------
 // Clang::SetCrashRecovery
 //
@@ -29,7 +29,6 @@
 using namespace System;
 using namespace System::Collections::Generic;
 using namespace System::IO;
-using namespace System::Runtime::Serialization::Json;
 
 namespace zuki::tools::llvm::clang {
 
@@ -40,6 +39,7 @@ ref class	Index;
 ref class	LoadedDiagnosticCollection;
 ref class	ModuleMapDescriptor;
 ref class	RemappingCollection;
+ref class	SerializedDiagnosticReader;
 ref class	TranslationUnit;
 enum class	TranslationUnitParseOptions;
 ref class	UnsavedFile;
@@ -118,6 +118,11 @@ public:
 	// Loads a translation unit in a default index from a serialized abstract syntax tree
 	static TranslationUnit^ LoadTranslationUnit(String^ path);
 
+	// OpenDiagnostics (static)
+	//
+	// Opens a serialized diagnostics file for streaming
+	static SerializedDiagnosticReader^ OpenDiagnostics(String^ path);
+
 	// SetCrashRecovery (static)
 	//
 	// Enable/disable clang crash recovery
@@ -0,0 +1,180 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "ClangEventSource.h"
+
+#include "PerformanceCounters.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// ClangEventSource Constructor (private)
+//
+// Arguments:
+//
+//	NONE
+
+ClangEventSource::ClangEventSource()
+{
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::CompletionCompleted
+//
+// Code completion has completed
+//
+// Arguments:
+//
+//	fileName				- File in which completion was performed
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::CompletionCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(3, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::DiagnosticsCompleted
+//
+// Extraction of the diagnostics of a translation unit has completed
+//
+// Arguments:
+//
+//	fileName				- Translation unit source file
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::DiagnosticsCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(5, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::DisposeCompleted
+//
+// Disposal of a translation unit has completed
+//
+// Arguments:
+//
+//	fileName				- Translation unit source file
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::DisposeCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(7, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::IndexCompleted
+//
+// Indexing of a source file or translation unit has completed
+//
+// Arguments:
+//
+//	fileName				- File that was indexed
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::IndexCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(2, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::Log::get (static)
+//
+// Gets the process-wide event source instance
+
+ClangEventSource^ ClangEventSource::Log::get(void)
+{
+	return s_log;
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::OnEventCommand (protected)
+//
+// Invoked when a listener enables or disables the event source
+//
+// Arguments:
+//
+//	command		- Event command arguments
+
+void ClangEventSource::OnEventCommand(EventCommandEventArgs^ command)
+{
+	UNREFERENCED_PARAMETER(command);
+
+	// The operations are only timed for the event source while someone is listening
+	PerformanceCounters::Listening = IsEnabled();
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::ParseCompleted
+//
+// Parsing or reparsing of a translation unit has completed
+//
+// Arguments:
+//
+//	fileName				- File that was parsed
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::ParseCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(1, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::SaveCompleted
+//
+// Serialization of a translation unit has completed
+//
+// Arguments:
+//
+//	fileName				- Translation unit source file
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::SaveCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(6, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+// ClangEventSource::TokenizeCompleted
+//
+// Tokenization of an extent has completed
+//
+// Arguments:
+//
+//	fileName				- File that contains the extent
+//	elapsedMicroseconds		- Duration of the operation
+
+void ClangEventSource::TokenizeCompleted(String^ fileName, Int64 elapsedMicroseconds)
+{
+	WriteEvent(4, fileName, elapsedMicroseconds);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __CLANGEVENTSOURCE_H_
+#define __CLANGEVENTSOURCE_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Diagnostics::Tracing;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class ClangEventSource
+//
+// EventSource that reports the duration of each timed libclang operation.
+// Enabling the source with any listener (PerfView, ETW, an in-process
+// EventListener) turns on the timing; the process-wide totals are kept by
+// PerformanceCounters
+//---------------------------------------------------------------------------
+
+[EventSource(Name = "Zuki-Tools-Llvm-Clang")]
+public ref class ClangEventSource sealed : public EventSource
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// CompletionCompleted
+	//
+	// Code completion has completed
+	[Event(3, Level = EventLevel::Informational)]
+	void CompletionCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// DiagnosticsCompleted
+	//
+	// Extraction of the diagnostics of a translation unit has completed
+	[Event(5, Level = EventLevel::Informational)]
+	void DiagnosticsCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// DisposeCompleted
+	//
+	// Disposal of a translation unit has completed
+	[Event(7, Level = EventLevel::Informational)]
+	void DisposeCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// IndexCompleted
+	//
+	// Indexing of a source file or translation unit has completed
+	[Event(2, Level = EventLevel::Informational)]
+	void IndexCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// ParseCompleted
+	//
+	// Parsing or reparsing of a translation unit has completed
+	[Event(1, Level = EventLevel::Informational)]
+	void ParseCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// SaveCompleted
+	//
+	// Serialization of a translation unit has completed
+	[Event(6, Level = EventLevel::Informational)]
+	void SaveCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	// TokenizeCompleted
+	//
+	// Tokenization of an extent has completed
+	[Event(4, Level = EventLevel::Verbose)]
+	void TokenizeCompleted(String^ fileName, Int64 elapsedMicroseconds);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Log (static)
+	//
+	// Gets the process-wide event source instance
+	static property ClangEventSource^ Log
+	{
+		ClangEventSource^ get(void);
+	}
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// OnEventCommand (EventSource)
+	//
+	// Invoked when a listener enables or disables the event source
+	virtual void OnEventCommand(EventCommandEventArgs^ command) override;
+
+private:
+
+	// Instance Constructor
+	//
+	ClangEventSource();
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	static initonly ClangEventSource^ s_log = gcnew ClangEventSource();
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __CLANGEVENTSOURCE_H_
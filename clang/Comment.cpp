@@ -32,6 +32,7 @@
 #include "NullComment.h"
 #include "ParagraphComment.h"
 #include "ParamCommandComment.h"
+#include "PerformanceCounters.h"
 #include "TextComment.h"
 #include "TParamCommandComment.h"
 #include "VerbatimBlockCommandComment.h"
@@ -81,6 +82,8 @@ CommentCollection^ Comment::Children::get(void)
 
 Comment^ Comment::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXComment comment)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Comment);
+
 	// Determine what kind of comment this is
 	CommentKind kind = CommentKind(clang_Comment_getKind(comment));
 
@@ -23,7 +23,11 @@
 #include "stdafx.h"
 #include "CompilationDatabase.h"
 
+#include "Clang.h"
+#include "CompilationDatabaseDiff.h"
+#include "CompilationDatabaseIndex.h"
 #include "CompileCommandCollection.h"
+#include "CompileCommandGroup.h"
 #include "StringUtil.h"
 
 using namespace System::Linq;
@@ -38,10 +42,14 @@ namespace zuki::tools::llvm::clang {
 // Arguments:
 //
 //	handle			- Underlying CompilationDatabaseHandle instance
+//	path			- Path to the directory containing the database
+//	validationtime	- Time spent validating the JSON database
 
-CompilationDatabase::CompilationDatabase(CompilationDatabaseHandle^ handle) : m_handle(handle)
+CompilationDatabase::CompilationDatabase(CompilationDatabaseHandle^ handle, String^ path, TimeSpan validationtime) : 
+	m_handle(handle), m_path(path), m_validation(validationtime)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
 }
 
 //---------------------------------------------------------------------------
@@ -55,6 +63,23 @@ CompilationDatabase::~CompilationDatabase()
 	m_disposed = true;					// Object is now in a disposed state
 }
 
+//---------------------------------------------------------------------------
+// CompilationDatabase::BuildIndex
+//
+// Materializes every compile command into an in-memory index
+//
+// Arguments:
+//
+//	NONE
+
+void CompilationDatabase::BuildIndex(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(m_index, nullptr)) 
+		m_index = CompilationDatabaseIndex::Create(CompilationDatabaseHandle::Reference(m_handle));
+}
+
 //---------------------------------------------------------------------------
 // CompilationDatabase::Create (internal, static)
 //
@@ -62,11 +87,13 @@ CompilationDatabase::~CompilationDatabase()
 //
 // Arguments:
 //
-//	database	- Unmanaged CXCompilationDatabase instance to take ownership of
+//	database		- Unmanaged CXCompilationDatabase instance to take ownership of
+//	path			- Path to the directory containing the database
+//	validationtime	- Time spent validating the JSON database
 
-CompilationDatabase^ CompilationDatabase::Create(CXCompilationDatabase&& database)
+CompilationDatabase^ CompilationDatabase::Create(CXCompilationDatabase&& database, String^ path, TimeSpan validationtime)
 {
-	return gcnew CompilationDatabase(gcnew CompilationDatabaseHandle(std::move(database)));
+	return gcnew CompilationDatabase(gcnew CompilationDatabaseHandle(std::move(database)), path, validationtime);
 }
 
 //---------------------------------------------------------------------------
@@ -81,6 +108,8 @@ CompilationDatabase^ CompilationDatabase::Create(CXCompilationDatabase&& databas
 CompileCommandCollection^ CompilationDatabase::GetCompileCommands(void)
 {
 	CHECK_DISPOSED(m_disposed);
+
+	if(!Object::ReferenceEquals(m_index, nullptr)) return m_index->GetCompileCommands();
 	return CompileCommandCollection::Create(clang_CompilationDatabase_getAllCompileCommands(CompilationDatabaseHandle::Reference(m_handle)));
 }
 
@@ -97,12 +126,114 @@ CompileCommandCollection^ CompilationDatabase::GetCompileCommands(String^ filena
 {
 	CHECK_DISPOSED(m_disposed);
 
+	if(!Object::ReferenceEquals(m_index, nullptr)) return m_index->GetCompileCommands(filename);
+
 	char* pszname = StringUtil::ToCharPointer(filename, CP_UTF8);
 
 	try { return CompileCommandCollection::Create(clang_CompilationDatabase_getCompileCommands(CompilationDatabaseHandle::Reference(m_handle), pszname)); }
 	finally { StringUtil::FreeCharPointer(pszname); }
 }
 
+//---------------------------------------------------------------------------
+// CompilationDatabase::GetCompileCommands
+//
+// Gets the collection of compile commands from the database for a file, optionally
+// inferring a compile command from a nearby file if the file is not in the database
+//
+// Arguments:
+//
+//	filename		- Name of the file in the database
+//	infer			- Flag to infer a command if the file is not in the database
+
+CompileCommandCollection^ CompilationDatabase::GetCompileCommands(String^ filename, bool infer)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(!infer) return GetCompileCommands(filename);
+
+	BuildIndex();						// Inference operates on the index
+	return m_index->GetCompileCommands(filename, true);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabase::GroupByFlags
+//
+// Groups the compile commands that share the same normalized flags
+//
+// Arguments:
+//
+//	NONE
+
+ReadOnlyCollection<CompileCommandGroup^>^ CompilationDatabase::GroupByFlags(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	BuildIndex();						// Grouping operates on the index
+	return m_index->GroupByFlags();
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabase::IsIndexed::get
+//
+// Gets a flag indicating if BuildIndex() has been called
+
+bool CompilationDatabase::IsIndexed::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return !Object::ReferenceEquals(m_index, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabase::Reload
+//
+// Reloads the database from its directory and reports the affected source files
+//
+// Arguments:
+//
+//	NONE
+
+CompilationDatabaseDiff^ CompilationDatabase::Reload(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// The new database is loaded and indexed before anything is replaced so that
+	// a failed reload leaves this instance untouched
+	CompilationDatabase^ reloaded = Clang::CreateCompilationDatabase(m_path);
+
+	try {
+
+		BuildIndex();
+		reloaded->BuildIndex();
+
+		CompilationDatabaseDiff^ diff = CompilationDatabaseDiff::Create(m_index, reloaded->m_index);
+
+		// Take ownership of the reloaded database handle and index; collections
+		// previously returned from this instance do not depend on the old handle
+		delete m_handle;
+		m_handle = reloaded->m_handle;
+		m_index = reloaded->m_index;
+		m_validation = reloaded->m_validation;
+
+		reloaded->m_handle = nullptr;
+		reloaded->m_disposed = true;
+
+		return diff;
+	}
+
+	finally { delete reloaded; }
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabase::ValidationTime::get
+//
+// Gets the time spent validating compile_commands.json before it was loaded
+
+TimeSpan CompilationDatabase::ValidationTime::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_validation;
+}
+
 //---------------------------------------------------------------------------
 
 } // zuki::tools::llvm::clang
@@ -29,13 +29,17 @@
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
+using namespace System::Collections::ObjectModel;
 
 namespace zuki::tools::llvm::clang {
 
 // FORWARD DECLARATIONS
 //
+ref class CompilationDatabaseDiff;
 ref class CompilationDatabaseHandle;
+ref class CompilationDatabaseIndex;
 ref class CompileCommandCollection;
+ref class CompileCommandGroup;
 
 //---------------------------------------------------------------------------
 // Class CompilationDatabase
@@ -50,11 +54,49 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// BuildIndex
+	//
+	// Materializes every compile command into an in-memory index that is
+	// used to serve all subsequent lookups without calling into libclang
+	void BuildIndex(void);
+
 	// GetCompileCommands
 	//
 	// Gets the collection of compile commands from the database
 	CompileCommandCollection^ GetCompileCommands(void);
 	CompileCommandCollection^ GetCompileCommands(String^ filename);
+	CompileCommandCollection^ GetCompileCommands(String^ filename, bool infer);
+
+	// GroupByFlags
+	//
+	// Groups the compile commands that share the same normalized flags; the
+	// input and output files are ignored and paths are fully resolved
+	ReadOnlyCollection<CompileCommandGroup^>^ GroupByFlags(void);
+
+	// Reload
+	//
+	// Reloads the database from its directory and reports the source files
+	// that were added, removed, or whose normalized flags were changed
+	CompilationDatabaseDiff^ Reload(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// IsIndexed
+	//
+	// Gets a flag indicating if BuildIndex() has been called
+	property bool IsIndexed
+	{
+		bool get(void);
+	}
+
+	// ValidationTime
+	//
+	// Gets the time spent validating compile_commands.json before it was loaded
+	property TimeSpan ValidationTime
+	{
+		TimeSpan get(void);
+	}
 
 internal:
 
@@ -64,7 +106,7 @@ internal:
 	// Create
 	//
 	// Creates a new CompilationDatabase instance
-	static CompilationDatabase^ Create(CXCompilationDatabase&& database);
+	static CompilationDatabase^ Create(CXCompilationDatabase&& database, String^ path, TimeSpan validationtime);
 
 private:
 
@@ -75,7 +117,7 @@ private:
 
 	// Instance Constructor
 	//
-	CompilationDatabase(CompilationDatabaseHandle^ handle);
+	CompilationDatabase(CompilationDatabaseHandle^ handle, String^ path, TimeSpan validationtime);
 
 	// Destructor
 	//
@@ -86,6 +128,9 @@ private:
 
 	bool							m_disposed;		// Object disposal flag
 	CompilationDatabaseHandle^		m_handle;		// Underlying safe handle
+	String^							m_path;			// Database directory
+	TimeSpan						m_validation;	// JSON validation time
+	CompilationDatabaseIndex^		m_index;		// Materialized index
 };
 
 //---------------------------------------------------------------------------
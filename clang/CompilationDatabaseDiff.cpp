@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompilationDatabaseDiff.h"
+
+#include "CompilationDatabaseIndex.h"
+#include "CompileCommandFingerprint.h"
+
+using namespace System::Collections::Generic;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff Constructor (private)
+//
+// Arguments:
+//
+//	added		- Source files that were added to the database
+//	removed		- Source files that were removed from the database
+//	changed		- Source files whose compile commands were changed
+
+CompilationDatabaseDiff::CompilationDatabaseDiff(ReadOnlyCollection<String^>^ added, ReadOnlyCollection<String^>^ removed, ReadOnlyCollection<String^>^ changed) :
+	m_added(added), m_removed(removed), m_changed(changed)
+{
+	if(Object::ReferenceEquals(added, nullptr)) throw gcnew ArgumentNullException("added");
+	if(Object::ReferenceEquals(removed, nullptr)) throw gcnew ArgumentNullException("removed");
+	if(Object::ReferenceEquals(changed, nullptr)) throw gcnew ArgumentNullException("changed");
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff::Added::get
+//
+// Gets the source files that were added to the database
+
+ReadOnlyCollection<String^>^ CompilationDatabaseDiff::Added::get(void)
+{
+	return m_added;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff::Changed::get
+//
+// Gets the source files whose normalized compile commands were changed
+
+ReadOnlyCollection<String^>^ CompilationDatabaseDiff::Changed::get(void)
+{
+	return m_changed;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff::Create (internal, static)
+//
+// Creates a new CompilationDatabaseDiff instance
+//
+// Arguments:
+//
+//	previous	- Index of the database before it was reloaded
+//	current		- Index of the database after it was reloaded
+
+CompilationDatabaseDiff^ CompilationDatabaseDiff::Create(CompilationDatabaseIndex^ previous, CompilationDatabaseIndex^ current)
+{
+	CompileCommandFingerprint			fingerprint;		// Fingerprint from the previous index
+
+	if(Object::ReferenceEquals(previous, nullptr)) throw gcnew ArgumentNullException("previous");
+	if(Object::ReferenceEquals(current, nullptr)) throw gcnew ArgumentNullException("current");
+
+	IReadOnlyDictionary<String^, CompileCommandFingerprint>^ before = previous->FileFingerprints;
+	IReadOnlyDictionary<String^, CompileCommandFingerprint>^ after = current->FileFingerprints;
+
+	List<String^>^ added = gcnew List<String^>();
+	List<String^>^ removed = gcnew List<String^>();
+	List<String^>^ changed = gcnew List<String^>();
+
+	// Output file names are not part of the normalized arguments, a file is only
+	// considered changed if the way it would be parsed has been changed
+	for each(KeyValuePair<String^, CompileCommandFingerprint> file in after) {
+
+		if(!before->TryGetValue(file.Key, fingerprint)) added->Add(file.Key);
+		else if(fingerprint != file.Value) changed->Add(file.Key);
+	}
+
+	for each(String^ file in before->Keys) if(!after->ContainsKey(file)) removed->Add(file);
+
+	added->Sort(StringComparer::OrdinalIgnoreCase);
+	removed->Sort(StringComparer::OrdinalIgnoreCase);
+	changed->Sort(StringComparer::OrdinalIgnoreCase);
+
+	return gcnew CompilationDatabaseDiff(added->AsReadOnly(), removed->AsReadOnly(), changed->AsReadOnly());
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff::IsEmpty::get
+//
+// Gets a flag indicating if no source files were affected
+
+bool CompilationDatabaseDiff::IsEmpty::get(void)
+{
+	return (m_added->Count == 0) && (m_removed->Count == 0) && (m_changed->Count == 0);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseDiff::Removed::get
+//
+// Gets the source files that were removed from the database
+
+ReadOnlyCollection<String^>^ CompilationDatabaseDiff::Removed::get(void)
+{
+	return m_removed;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
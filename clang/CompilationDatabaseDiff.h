@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPILATIONDATABASEDIFF_H_
+#define __COMPILATIONDATABASEDIFF_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompilationDatabaseIndex;
+
+//---------------------------------------------------------------------------
+// Class CompilationDatabaseDiff
+//
+// Describes the source files affected by reloading a compilation database
+//---------------------------------------------------------------------------
+
+public ref class CompilationDatabaseDiff
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Added
+	//
+	// Gets the source files that were added to the database
+	property ReadOnlyCollection<String^>^ Added
+	{
+		ReadOnlyCollection<String^>^ get(void);
+	}
+
+	// Changed
+	//
+	// Gets the source files whose normalized compile commands were changed
+	property ReadOnlyCollection<String^>^ Changed
+	{
+		ReadOnlyCollection<String^>^ get(void);
+	}
+
+	// IsEmpty
+	//
+	// Gets a flag indicating if no source files were affected
+	property bool IsEmpty
+	{
+		bool get(void);
+	}
+
+	// Removed
+	//
+	// Gets the source files that were removed from the database
+	property ReadOnlyCollection<String^>^ Removed
+	{
+		ReadOnlyCollection<String^>^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new CompilationDatabaseDiff instance
+	static CompilationDatabaseDiff^ Create(CompilationDatabaseIndex^ previous, CompilationDatabaseIndex^ current);
+
+private:
+
+	// Instance Constructor
+	//
+	CompilationDatabaseDiff(ReadOnlyCollection<String^>^ added, ReadOnlyCollection<String^>^ removed, ReadOnlyCollection<String^>^ changed);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	ReadOnlyCollection<String^>^		m_added;		// Added source files
+	ReadOnlyCollection<String^>^		m_removed;		// Removed source files
+	ReadOnlyCollection<String^>^		m_changed;		// Changed source files
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPILATIONDATABASEDIFF_H_
@@ -0,0 +1,427 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompilationDatabaseIndex.h"
+
+#include "CompileCommand.h"
+#include "CompileCommandArgumentCollection.h"
+#include "CompileCommandCollection.h"
+#include "CompileCommandGroup.h"
+#include "CompileCommandNormalizer.h"
+#include "CompileCommandSourceMapping.h"
+#include "CompileCommandSourceMappingCollection.h"
+#include "StringInterner.h"
+#include "StringUtil.h"
+
+using namespace System::IO;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex Constructor (private)
+//
+// Arguments:
+//
+//	commands		- Materialized compile commands
+
+CompilationDatabaseIndex::CompilationDatabaseIndex(array<CompileCommand^>^ commands) : m_commands(commands)
+{
+	if(Object::ReferenceEquals(commands, nullptr)) throw gcnew ArgumentNullException("commands");
+
+	// Group the commands by normalized file name; most files will only have one
+	Dictionary<String^, List<CompileCommand^>^>^ files = gcnew Dictionary<String^, List<CompileCommand^>^>(StringComparer::OrdinalIgnoreCase);
+	m_keys = gcnew array<String^>(commands->Length);
+
+	for(int index = 0; index < commands->Length; index++) {
+
+		CompileCommand^ command = commands[index];
+		String^ key = m_keys[index] = NormalizePath(command->WorkingDirectory, command->Filename);
+
+		List<CompileCommand^>^ list = nullptr;
+		if(!files->TryGetValue(key, list)) { list = gcnew List<CompileCommand^>(1); files->Add(key, list); }
+		list->Add(command);
+	}
+
+	m_files = gcnew Dictionary<String^, array<CompileCommand^>^>(files->Count, StringComparer::OrdinalIgnoreCase);
+	m_stems = gcnew Dictionary<String^, List<String^>^>(files->Count, StringComparer::OrdinalIgnoreCase);
+	m_directories = gcnew Dictionary<String^, String^>(StringComparer::OrdinalIgnoreCase);
+
+	for each(KeyValuePair<String^, List<CompileCommand^>^> file in files) {
+
+		m_files->Add(file.Key, file.Value->ToArray());
+
+		// Files with the same stem are the preferred donors (foo.h -> foo.cpp)
+		String^ stem = Path::GetFileNameWithoutExtension(file.Key);
+		List<String^>^ list = nullptr;
+		if(!m_stems->TryGetValue(stem, list)) { list = gcnew List<String^>(1); m_stems->Add(stem, list); }
+		list->Add(file.Key);
+
+		// The first file in each directory represents that directory
+		String^ directory = Path::GetDirectoryName(file.Key);
+		if(!String::IsNullOrEmpty(directory) && !m_directories->ContainsKey(directory)) m_directories->Add(directory, file.Key);
+	}
+
+	// Ancestor directories that have no files of their own are represented by the
+	// first file found below them; this is done as a second pass so that a directory
+	// with its own files is never represented by a file in a subdirectory
+	for each(KeyValuePair<String^, String^> directory in gcnew List<KeyValuePair<String^, String^>>(m_directories)) {
+
+		for(String^ parent = Path::GetDirectoryName(directory.Key); !String::IsNullOrEmpty(parent); parent = Path::GetDirectoryName(parent)) {
+
+			if(m_directories->ContainsKey(parent)) continue;
+			m_directories->Add(parent, directory.Value);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::CommonPrefixLength (private, static)
+//
+// Gets the length of the common leading portion of two paths
+//
+// Arguments:
+//
+//	left		- First path to compare
+//	right		- Second path to compare
+
+int CompilationDatabaseIndex::CommonPrefixLength(String^ left, String^ right)
+{
+	int length = Math::Min(left->Length, right->Length);
+
+	for(int index = 0; index < length; index++)
+		if(Char::ToUpperInvariant(left[index]) != Char::ToUpperInvariant(right[index])) return index;
+
+	return length;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Commands::get
+//
+// Gets all of the materialized commands in database order
+
+array<CompileCommand^>^ CompilationDatabaseIndex::Commands::get(void)
+{
+	return m_commands;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Create (internal, static)
+//
+// Creates a new CompilationDatabaseIndex instance
+//
+// Arguments:
+//
+//	database		- Unmanaged CXCompilationDatabase instance to materialize
+
+CompilationDatabaseIndex^ CompilationDatabaseIndex::Create(CXCompilationDatabase database)
+{
+	StringInterner^ interner = gcnew StringInterner();
+
+	CXCompileCommands commands = clang_CompilationDatabase_getAllCompileCommands(database);
+
+	try {
+
+		array<CompileCommand^>^ materialized = gcnew array<CompileCommand^>(clang_CompileCommands_getSize(commands));
+		for(int index = 0; index < materialized->Length; index++) {
+
+			CXCompileCommand command = clang_CompileCommands_getCommand(commands, static_cast<unsigned int>(index));
+
+			// Arguments and directories are heavily duplicated across commands, intern them
+			array<String^>^ arguments = gcnew array<String^>(clang_CompileCommand_getNumArgs(command));
+			for(int arg = 0; arg < arguments->Length; arg++) 
+				arguments[arg] = interner->Intern(clang_CompileCommand_getArg(command, static_cast<unsigned int>(arg)));
+
+			array<CompileCommandSourceMapping^>^ mappings = gcnew array<CompileCommandSourceMapping^>(clang_CompileCommand_getNumMappedSources(command));
+			for(int mapping = 0; mapping < mappings->Length; mapping++)
+				mappings[mapping] = CompileCommandSourceMapping::Create(StringUtil::ToString(clang_CompileCommand_getMappedSourcePath(command, static_cast<unsigned int>(mapping))),
+					StringUtil::ToString(clang_CompileCommand_getMappedSourceContent(command, static_cast<unsigned int>(mapping))));
+
+			materialized[index] = CompileCommand::Create(StringUtil::ToString(clang_CompileCommand_getFilename(command)), 
+				interner->Intern(clang_CompileCommand_getDirectory(command)), CompileCommandArgumentCollection::Create(arguments), 
+				CompileCommandSourceMappingCollection::Create(mappings), false);
+		}
+
+		return gcnew CompilationDatabaseIndex(materialized);
+	}
+
+	finally { clang_CompileCommands_dispose(commands); }
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::FileFingerprints::get
+//
+// Gets the combined fingerprint of every command for each normalized source file path
+
+IReadOnlyDictionary<String^, CompileCommandFingerprint>^ CompilationDatabaseIndex::FileFingerprints::get(void)
+{
+	if(Object::ReferenceEquals(m_filefingerprints, nullptr)) Normalize();
+	return m_filefingerprints;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Files::get
+//
+// Gets the materialized commands keyed by normalized source file path
+
+IReadOnlyDictionary<String^, array<CompileCommand^>^>^ CompilationDatabaseIndex::Files::get(void)
+{
+	return m_files;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Fingerprints::get
+//
+// Gets the normalized argument fingerprint of each command in database order
+
+array<CompileCommandFingerprint>^ CompilationDatabaseIndex::Fingerprints::get(void)
+{
+	if(Object::ReferenceEquals(m_fingerprints, nullptr)) Normalize();
+	return m_fingerprints;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::GetCompileCommands
+//
+// Gets the collection of all compile commands from the index
+//
+// Arguments:
+//
+//	NONE
+
+CompileCommandCollection^ CompilationDatabaseIndex::GetCompileCommands(void)
+{
+	return CompileCommandCollection::Create(m_commands);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::GetCompileCommands
+//
+// Gets the collection of compile commands from the index for a file
+//
+// Arguments:
+//
+//	filename		- Name of the file in the database
+
+CompileCommandCollection^ CompilationDatabaseIndex::GetCompileCommands(String^ filename)
+{
+	array<CompileCommand^>^ commands = nullptr;
+
+	if(Object::ReferenceEquals(filename, nullptr) || !m_files->TryGetValue(NormalizePath(filename), commands)) commands = s_empty;
+	return CompileCommandCollection::Create(commands);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::GetCompileCommands
+//
+// Gets the collection of compile commands from the index for a file, optionally
+// inferring a compile command if the file is not in the database
+//
+// Arguments:
+//
+//	filename		- Name of the file in the database
+//	infer			- Flag to infer a command if the file is not in the database
+
+CompileCommandCollection^ CompilationDatabaseIndex::GetCompileCommands(String^ filename, bool infer)
+{
+	if(!infer || Object::ReferenceEquals(filename, nullptr)) return GetCompileCommands(filename);
+
+	String^ key = NormalizePath(filename);
+
+	array<CompileCommand^>^ commands = nullptr;
+	if(m_files->TryGetValue(key, commands)) return CompileCommandCollection::Create(commands);
+
+	CompileCommand^ inferred = Infer(key);
+	return CompileCommandCollection::Create((Object::ReferenceEquals(inferred, nullptr)) ? s_empty : gcnew array<CompileCommand^> { inferred });
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::GroupByFlags
+//
+// Groups the commands by the fingerprint of their normalized arguments
+//
+// Arguments:
+//
+//	NONE
+
+ReadOnlyCollection<CompileCommandGroup^>^ CompilationDatabaseIndex::GroupByFlags(void)
+{
+	if(Object::ReferenceEquals(m_fingerprints, nullptr)) Normalize();
+
+	// Groups are ordered by the first appearance of their fingerprint in the database
+	Dictionary<CompileCommandFingerprint, int>^ lookup = gcnew Dictionary<CompileCommandFingerprint, int>();
+	List<List<CompileCommand^>^>^ members = gcnew List<List<CompileCommand^>^>();
+	List<int>^ firsts = gcnew List<int>();
+
+	for(int index = 0; index < m_commands->Length; index++) {
+
+		int group;
+		if(!lookup->TryGetValue(m_fingerprints[index], group)) {
+
+			group = members->Count;
+			lookup->Add(m_fingerprints[index], group);
+			members->Add(gcnew List<CompileCommand^>());
+			firsts->Add(index);
+		}
+
+		members[group]->Add(m_commands[index]);
+	}
+
+	List<CompileCommandGroup^>^ groups = gcnew List<CompileCommandGroup^>(members->Count);
+	for(int group = 0; group < members->Count; group++) 
+		groups->Add(CompileCommandGroup::Create(m_fingerprints[firsts[group]], m_normalized[firsts[group]], members[group]->ToArray()));
+
+	return groups->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Infer (private)
+//
+// Infers a compile command for a file that is not in the database
+//
+// Arguments:
+//
+//	filename		- Normalized name of the file
+
+CompileCommand^ CompilationDatabaseIndex::Infer(String^ filename)
+{
+	String^ donor = nullptr;
+	int proximity = -1;
+
+	// Files that share the stem of the target file are considered first, preferring
+	// the one that shares the longest leading portion of its path with the target
+	List<String^>^ stems = nullptr;
+	if(m_stems->TryGetValue(Path::GetFileNameWithoutExtension(filename), stems)) {
+
+		for each(String^ stem in stems) {
+
+			int common = CommonPrefixLength(filename, stem);
+			if(common > proximity) { donor = stem; proximity = common; }
+		}
+	}
+
+	// The file representing the nearest ancestor directory replaces a same-stem
+	// donor that lives further away from the target (foo/main.h -> bar/main.cpp)
+	for(String^ directory = Path::GetDirectoryName(filename); !String::IsNullOrEmpty(directory); directory = Path::GetDirectoryName(directory)) {
+
+		String^ nearest = nullptr;
+		if(!m_directories->TryGetValue(directory, nearest)) continue;
+
+		if(CommonPrefixLength(filename, nearest) > proximity) donor = nearest;
+		break;
+	}
+
+	// Without any relationship to the target, any command is better than none
+	if(Object::ReferenceEquals(donor, nullptr)) {
+
+		if(m_commands->Length == 0) return nullptr;
+		donor = m_keys[0];
+	}
+
+	CompileCommand^ command = m_files[donor][0];
+
+	return CompileCommand::Create(filename, command->WorkingDirectory, CompileCommandArgumentCollection::Create(CompileCommandNormalizer::Retarget(command, filename)),
+		CompileCommandSourceMappingCollection::Create(gcnew array<CompileCommandSourceMapping^>(0)), true);
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::Normalize (private)
+//
+// Normalizes and fingerprints every command in the index
+//
+// Arguments:
+//
+//	NONE
+
+void CompilationDatabaseIndex::Normalize(void)
+{
+	array<array<String^>^>^ normalized = gcnew array<array<String^>^>(m_commands->Length);
+	array<CompileCommandFingerprint>^ fingerprints = gcnew array<CompileCommandFingerprint>(m_commands->Length);
+
+	Dictionary<String^, List<String^>^>^ combined = gcnew Dictionary<String^, List<String^>^>(m_files->Count, StringComparer::OrdinalIgnoreCase);
+
+	for(int index = 0; index < m_commands->Length; index++) {
+
+		normalized[index] = CompileCommandNormalizer::Normalize(m_commands[index]);
+		fingerprints[index] = CompileCommandFingerprint::Compute(normalized[index]);
+
+		List<String^>^ list = nullptr;
+		if(!combined->TryGetValue(m_keys[index], list)) { list = gcnew List<String^>(1); combined->Add(m_keys[index], list); }
+		list->Add(fingerprints[index].ToString());
+	}
+
+	// A file with multiple commands is fingerprinted by the ordered fingerprints of those commands
+	Dictionary<String^, CompileCommandFingerprint>^ filefingerprints = gcnew Dictionary<String^, CompileCommandFingerprint>(combined->Count, StringComparer::OrdinalIgnoreCase);
+	for each(KeyValuePair<String^, List<String^>^> file in combined) filefingerprints->Add(file.Key, CompileCommandFingerprint::Compute(file.Value));
+
+	m_normalized = normalized;
+	m_fingerprints = fingerprints;
+	m_filefingerprints = filefingerprints;
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::NormalizePath (static)
+//
+// Normalizes a source file path for use as a lookup key
+//
+// Arguments:
+//
+//	path		- Path to be normalized
+
+String^ CompilationDatabaseIndex::NormalizePath(String^ path)
+{
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+
+	// Full paths collapse relative segments and alternate separators; if the
+	// path cannot be expanded it is used as-is
+	try { return Path::GetFullPath(path); }
+	catch(Exception^) { return path; }
+}
+
+//---------------------------------------------------------------------------
+// CompilationDatabaseIndex::NormalizePath (static)
+//
+// Normalizes a source file path for use as a lookup key
+//
+// Arguments:
+//
+//	directory	- Directory that relative file names are relative to
+//	filename	- File name to be normalized
+
+String^ CompilationDatabaseIndex::NormalizePath(String^ directory, String^ filename)
+{
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+
+	// Relative file names in the database are relative to the working directory
+	if(String::IsNullOrEmpty(directory) || Path::IsPathRooted(filename)) return NormalizePath(filename);
+
+	try { return NormalizePath(Path::Combine(directory, filename)); }
+	catch(Exception^) { return filename; }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
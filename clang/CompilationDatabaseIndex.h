@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPILATIONDATABASEINDEX_H_
+#define __COMPILATIONDATABASEINDEX_H_
+#pragma once
+
+#include "CompileCommandFingerprint.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompileCommand;
+ref class	CompileCommandCollection;
+ref class	CompileCommandGroup;
+
+//---------------------------------------------------------------------------
+// Class CompilationDatabaseIndex (internal)
+//
+// Materialized copy of every command in a compilation database.  Argument
+// and directory strings are interned across commands, and commands are
+// hashed by their normalized source file path so that lookups can be
+// served without calling back into libclang.  Files are also indexed by
+// name stem and directory so that commands can be inferred for files that
+// are not in the database, such as header files
+//---------------------------------------------------------------------------
+
+ref class CompilationDatabaseIndex
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetCompileCommands
+	//
+	// Gets a collection of compile commands from the index
+	CompileCommandCollection^ GetCompileCommands(void);
+	CompileCommandCollection^ GetCompileCommands(String^ filename);
+	CompileCommandCollection^ GetCompileCommands(String^ filename, bool infer);
+
+	// GroupByFlags
+	//
+	// Groups the commands by the fingerprint of their normalized arguments
+	ReadOnlyCollection<CompileCommandGroup^>^ GroupByFlags(void);
+
+	// NormalizePath (static)
+	//
+	// Normalizes a source file path for use as a lookup key
+	static String^ NormalizePath(String^ path);
+	static String^ NormalizePath(String^ directory, String^ filename);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Commands
+	//
+	// Gets all of the materialized commands in database order
+	property array<CompileCommand^>^ Commands
+	{
+		array<CompileCommand^>^ get(void);
+	}
+
+	// Fingerprints
+	//
+	// Gets the normalized argument fingerprint of each command in database order
+	property array<CompileCommandFingerprint>^ Fingerprints
+	{
+		array<CompileCommandFingerprint>^ get(void);
+	}
+
+	// FileFingerprints
+	//
+	// Gets the combined fingerprint of every command for each normalized source file path
+	property IReadOnlyDictionary<String^, CompileCommandFingerprint>^ FileFingerprints
+	{
+		IReadOnlyDictionary<String^, CompileCommandFingerprint>^ get(void);
+	}
+
+	// Files
+	//
+	// Gets the materialized commands keyed by normalized source file path
+	property IReadOnlyDictionary<String^, array<CompileCommand^>^>^ Files
+	{
+		IReadOnlyDictionary<String^, array<CompileCommand^>^>^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new CompilationDatabaseIndex instance
+	static CompilationDatabaseIndex^ Create(CXCompilationDatabase database);
+
+private:
+
+	// Instance Constructor
+	//
+	CompilationDatabaseIndex(array<CompileCommand^>^ commands);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// CommonPrefixLength (static)
+	//
+	// Gets the length of the common leading portion of two paths
+	static int CommonPrefixLength(String^ left, String^ right);
+
+	// Infer
+	//
+	// Infers a compile command for a file that is not in the database
+	CompileCommand^ Infer(String^ filename);
+
+	// Normalize
+	//
+	// Normalizes and fingerprints every command in the index
+	void Normalize(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	array<CompileCommand^>^								m_commands;	// All commands
+	array<String^>^										m_keys;		// File key per command
+	Dictionary<String^, array<CompileCommand^>^>^		m_files;	// Commands by file
+	Dictionary<String^, List<String^>^>^				m_stems;	// Files by name stem
+	Dictionary<String^, String^>^						m_directories;	// Nearest file by directory
+	array<array<String^>^>^								m_normalized;	// Normalized arguments
+	array<CompileCommandFingerprint>^					m_fingerprints;	// Argument fingerprints
+	Dictionary<String^, CompileCommandFingerprint>^		m_filefingerprints;	// Fingerprints by file
+	static initonly array<CompileCommand^>^				s_empty = gcnew array<CompileCommand^>(0);
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPILATIONDATABASEINDEX_H_
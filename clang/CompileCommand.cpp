@@ -27,6 +27,8 @@
 #include "CompileCommandSourceMappingCollection.h"
 #include "StringUtil.h"
 
+using namespace System::Collections::Generic;
+
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 namespace zuki::tools::llvm::clang {
@@ -43,6 +45,26 @@ CompileCommand::CompileCommand(CompileCommandHandle^ handle) : m_handle(handle)
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
 }
 
+//---------------------------------------------------------------------------
+// CompileCommand Constructor
+//
+// Arguments:
+//
+//	filename		- Materialized file name
+//	workdir			- Materialized working directory
+//	arguments		- Materialized argument collection
+//	mappings		- Materialized source mapping collection
+//	inferred		- Flag if the command was inferred from another command
+
+CompileCommand::CompileCommand(String^ filename, String^ workdir, CompileCommandArgumentCollection^ arguments, CompileCommandSourceMappingCollection^ mappings, bool inferred) :
+	m_filename(filename), m_workdir(workdir), m_arguments(arguments), m_mappings(mappings), m_inferred(inferred)
+{
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+	if(Object::ReferenceEquals(workdir, nullptr)) throw gcnew ArgumentNullException("workdir");
+	if(Object::ReferenceEquals(arguments, nullptr)) throw gcnew ArgumentNullException("arguments");
+	if(Object::ReferenceEquals(mappings, nullptr)) throw gcnew ArgumentNullException("mappings");
+}
+
 //---------------------------------------------------------------------------
 // CompileCommand::Arguments::get
 //
@@ -71,6 +93,25 @@ CompileCommand^ CompileCommand::Create(SafeHandle^ owner, CXCompileCommand&& com
 	return gcnew CompileCommand(gcnew CompileCommandHandle(owner, std::move(command)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommand::Create (internal, static)
+//
+// Creates a new CompileCommand instance from materialized data that does not
+// refer back to the unmanaged compilation database
+//
+// Arguments:
+//
+//	filename		- File name associated with the command
+//	workdir			- Working directory of the command
+//	arguments		- Command argument collection
+//	mappings		- Command source mapping collection
+//	inferred		- Flag if the command was inferred from another command
+
+CompileCommand^ CompileCommand::Create(String^ filename, String^ workdir, CompileCommandArgumentCollection^ arguments, CompileCommandSourceMappingCollection^ mappings, bool inferred)
+{
+	return gcnew CompileCommand(filename, workdir, arguments, mappings, inferred);
+}
+
 //---------------------------------------------------------------------------
 // CompileCommand::Filename::get
 //
@@ -84,6 +125,48 @@ String^ CompileCommand::Filename::get(void)
 	return m_filename;
 }
 
+//---------------------------------------------------------------------------
+// CompileCommand::GetCommandLine (internal)
+//
+// Gets the full command line to parse the command, with the working directory
+// and any additional flags inserted after the compiler executable
+//
+// Arguments:
+//
+//	flags		- Additional flags to insert; can be null
+
+array<String^>^ CompileCommand::GetCommandLine(array<String^>^ flags)
+{
+	CompileCommandArgumentCollection^ arguments = this->Arguments;
+	String^ workdir = this->WorkingDirectory;
+
+	int numflags = (Object::ReferenceEquals(flags, nullptr)) ? 0 : flags->Length;
+	List<String^>^ result = gcnew List<String^>(arguments->Count + numflags + 1);
+
+	for(int index = 0; index < arguments->Count; index++) {
+
+		result->Add(arguments[index]);
+		if(index > 0) continue;
+
+		// Relative input files and include paths are resolved against the directory the
+		// command was executed from rather than the current directory of this process
+		if(!String::IsNullOrEmpty(workdir)) result->Add(String::Concat("-working-directory=", workdir));
+		if(numflags > 0) result->AddRange(flags);
+	}
+
+	return result->ToArray();
+}
+
+//---------------------------------------------------------------------------
+// CompileCommand::IsInferred::get
+//
+// Gets a flag indicating if the command was inferred from another command
+
+bool CompileCommand::IsInferred::get(void)
+{
+	return m_inferred;
+}
+
 //---------------------------------------------------------------------------
 // CompileCommand::SourceMappings::get
 //
@@ -67,6 +67,15 @@ public:
 		String^ get(void);
 	}
 
+	// IsInferred
+	//
+	// Gets a flag indicating if the command was inferred from another command
+	// rather than being present in the compilation database
+	property bool IsInferred
+	{
+		bool get(void);
+	}
+
 	// SourceMappings
 	//
 	// Gets a collection of compiler invocation source mappings
@@ -92,6 +101,12 @@ internal:
 	//
 	// Creates a new CompileCommand instance
 	static CompileCommand^ Create(SafeHandle^ owner, CXCompileCommand&& command);
+	static CompileCommand^ Create(String^ filename, String^ workdir, CompileCommandArgumentCollection^ arguments, CompileCommandSourceMappingCollection^ mappings, bool inferred);
+
+	// GetCommandLine
+	//
+	// Gets the full command line to parse the command, including the working directory
+	array<String^>^ GetCommandLine(array<String^>^ flags);
 
 private:
 
@@ -103,6 +118,7 @@ private:
 	// Instance Constructor
 	//
 	CompileCommand(CompileCommandHandle^ handle);
+	CompileCommand(String^ filename, String^ workdir, CompileCommandArgumentCollection^ arguments, CompileCommandSourceMappingCollection^ mappings, bool inferred);
 
 	//-----------------------------------------------------------------------
 	// Member Variables
@@ -112,6 +128,7 @@ private:
 	CompileCommandSourceMappingCollection^	m_mappings;		// Source mappings
 	String^									m_filename;		// Cached file name
 	String^									m_workdir;		// Cached working dir
+	bool									m_inferred;		// Inferred command flag
 };
 
 //---------------------------------------------------------------------------
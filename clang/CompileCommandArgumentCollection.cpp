@@ -43,6 +43,18 @@ CompileCommandArgumentCollection::CompileCommandArgumentCollection(CompileComman
 	m_cache = gcnew array<String^>(clang_CompileCommand_getNumArgs(CompileCommandHandle::Reference(m_handle)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandArgumentCollection Constructor
+//
+// Arguments:
+//
+//	arguments		- Materialized argument strings
+
+CompileCommandArgumentCollection::CompileCommandArgumentCollection(array<String^>^ arguments) : m_cache(arguments)
+{
+	if(Object::ReferenceEquals(arguments, nullptr)) throw gcnew ArgumentNullException("arguments");
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandArgumentCollection::default[int]::get
 //
@@ -85,6 +97,20 @@ CompileCommandArgumentCollection^ CompileCommandArgumentCollection::Create(SafeH
 	return gcnew CompileCommandArgumentCollection(gcnew CompileCommandHandle(owner, command));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandArgumentCollection::Create (static, internal)
+//
+// Creates a new CompileCommandArgumentCollection instance
+//
+// Arguments:
+//
+//	arguments		- Materialized argument strings; the array is not copied
+
+CompileCommandArgumentCollection^ CompileCommandArgumentCollection::Create(array<String^>^ arguments)
+{
+	return gcnew CompileCommandArgumentCollection(arguments);
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandArgumentCollection::GetEnumerator
 //
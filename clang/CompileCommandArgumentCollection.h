@@ -79,6 +79,7 @@ internal:
 	//
 	// Creates a new CompileCommandArgumentCollection instance
 	static CompileCommandArgumentCollection^ Create(SafeHandle^ owner, CXCompileCommand command);
+	static CompileCommandArgumentCollection^ Create(array<String^>^ arguments);
 
 private:
 
@@ -90,6 +91,7 @@ private:
 	// Instance Constructor
 	//
 	CompileCommandArgumentCollection(CompileCommandHandle^ handle);
+	CompileCommandArgumentCollection(array<String^>^ arguments);
 
 	//-----------------------------------------------------------------------
 	// Private Member Functions
@@ -43,6 +43,18 @@ CompileCommandCollection::CompileCommandCollection(CompileCommandsHandle^ handle
 	m_cache = gcnew array<CompileCommand^>(clang_CompileCommands_getSize(CompileCommandsHandle::Reference(m_handle)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandCollection Constructor
+//
+// Arguments:
+//
+//	commands	- Materialized compile commands
+
+CompileCommandCollection::CompileCommandCollection(array<CompileCommand^>^ commands) : m_cache(commands)
+{
+	if(Object::ReferenceEquals(commands, nullptr)) throw gcnew ArgumentNullException("commands");
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandCollection Destructor
 
@@ -50,8 +62,9 @@ CompileCommandCollection::~CompileCommandCollection()
 {
 	if(m_disposed) return;
 
-	// Dispose of all cached CompileCommand instances
-	for each(CompileCommand^ command in m_cache) delete command;
+	// Dispose of all cached CompileCommand instances, materialized collections
+	// share their instances with the compilation database index
+	if(!Object::ReferenceEquals(m_handle, nullptr)) for each(CompileCommand^ command in m_cache) delete command;
 
 	delete m_handle;					// Release the safe handle
 	m_disposed = true;					// Object is now in a disposed state
@@ -104,6 +117,20 @@ CompileCommandCollection^ CompileCommandCollection::Create(CXCompileCommands&& c
 	return gcnew CompileCommandCollection(gcnew CompileCommandsHandle(std::move(commands)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandCollection::Create (static, internal)
+//
+// Creates a new CompileCommandCollection instance
+//
+// Arguments:
+//
+//	commands		- Materialized compile commands; the array is not copied
+
+CompileCommandCollection^ CompileCommandCollection::Create(array<CompileCommand^>^ commands)
+{
+	return gcnew CompileCommandCollection(commands);
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandCollection::GetEnumerator
 //
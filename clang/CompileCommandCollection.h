@@ -84,6 +84,7 @@ internal:
 	//
 	// Creates a new CompileCommandCollection instance
 	static CompileCommandCollection^ Create(CXCompileCommands&& commands);
+	static CompileCommandCollection^ Create(array<CompileCommand^>^ commands);
 
 private:
 
@@ -95,6 +96,7 @@ private:
 	// Instance Constructor
 	//
 	CompileCommandCollection(CompileCommandsHandle^ handle);
+	CompileCommandCollection(array<CompileCommand^>^ commands);
 
 	// Destructor
 	//
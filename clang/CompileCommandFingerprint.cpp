@@ -0,0 +1,268 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompileCommandFingerprint.h"
+
+#include <vcclr.h>					// PtrToStringChars
+
+using namespace System::Text;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Rotate (local)
+//
+// 64-bit left rotation
+//
+// Arguments:
+//
+//	value		- Value to be rotated
+//	count		- Number of bits to rotate
+
+static inline uint64_t Rotate(uint64_t value, int count)
+{
+	return (value << count) | (value >> (64 - count));
+}
+
+//---------------------------------------------------------------------------
+// Mix (local)
+//
+// MurmurHash3 64-bit finalization mix
+//
+// Arguments:
+//
+//	value		- Value to be mixed
+
+static inline uint64_t Mix(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xFF51AFD7ED558CCDULL;
+	value ^= value >> 33;
+	value *= 0xC4CEB9FE1A85EC53ULL;
+	value ^= value >> 33;
+
+	return value;
+}
+
+//---------------------------------------------------------------------------
+// Hash128 (local)
+//
+// MurmurHash3 x64 128-bit hash of a block of memory
+//
+// Arguments:
+//
+//	data		- Pointer to the data to be hashed
+//	length		- Length of the data to be hashed
+//	high		- Receives the high 64 bits of the hash
+//	low			- Receives the low 64 bits of the hash
+
+static void Hash128(const uint8_t* data, size_t length, uint64_t& high, uint64_t& low)
+{
+	const uint64_t c1 = 0x87C37B91114253D5ULL;
+	const uint64_t c2 = 0x4CF5AD432745937FULL;
+
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
+
+	size_t blocks = length / 16;
+	for(size_t index = 0; index < blocks; index++) {
+
+		uint64_t k1, k2;
+		memcpy(&k1, data + (index * 16), sizeof(uint64_t));
+		memcpy(&k2, data + (index * 16) + 8, sizeof(uint64_t));
+
+		k1 *= c1; k1 = Rotate(k1, 31); k1 *= c2; h1 ^= k1;
+		h1 = Rotate(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52DCE729;
+
+		k2 *= c2; k2 = Rotate(k2, 33); k2 *= c1; h2 ^= k2;
+		h2 = Rotate(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495AB5;
+	}
+
+	// Fold in the remaining 0-15 bytes
+	const uint8_t* tail = data + (blocks * 16);
+	size_t remaining = length & 15;
+
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+
+	for(size_t index = remaining; index > 8; index--) k2 ^= static_cast<uint64_t>(tail[index - 1]) << ((index - 9) * 8);
+	if(remaining > 8) { k2 *= c2; k2 = Rotate(k2, 33); k2 *= c1; h2 ^= k2; }
+
+	for(size_t index = (remaining > 8) ? 8 : remaining; index > 0; index--) k1 ^= static_cast<uint64_t>(tail[index - 1]) << ((index - 1) * 8);
+	if(remaining > 0) { k1 *= c1; k1 = Rotate(k1, 31); k1 *= c2; h1 ^= k1; }
+
+	h1 ^= length; h2 ^= length;
+	h1 += h2; h2 += h1;
+	h1 = Mix(h1); h2 = Mix(h2);
+	h1 += h2; h2 += h1;
+
+	high = h2;
+	low = h1;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint Constructor (internal)
+//
+// Arguments:
+//
+//	high		- High 64 bits of the fingerprint
+//	low			- Low 64 bits of the fingerprint
+
+CompileCommandFingerprint::CompileCommandFingerprint(UInt64 high, UInt64 low) : m_high(high), m_low(low)
+{
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::operator == (static)
+
+bool CompileCommandFingerprint::operator==(CompileCommandFingerprint lhs, CompileCommandFingerprint rhs)
+{
+	return (lhs.m_high == rhs.m_high) && (lhs.m_low == rhs.m_low);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::operator != (static)
+
+bool CompileCommandFingerprint::operator!=(CompileCommandFingerprint lhs, CompileCommandFingerprint rhs)
+{
+	return !(lhs == rhs);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::Compute (internal, static)
+//
+// Computes the fingerprint of a set of normalized arguments
+//
+// Arguments:
+//
+//	arguments	- Normalized compile command arguments
+
+CompileCommandFingerprint CompileCommandFingerprint::Compute(IEnumerable<String^>^ arguments)
+{
+	uint64_t			high;				// High 64 bits of the hash
+	uint64_t			low;				// Low 64 bits of the hash
+
+	if(Object::ReferenceEquals(arguments, nullptr)) throw gcnew ArgumentNullException("arguments");
+
+	// Join the arguments with embedded nulls so that argument boundaries are
+	// significant ("-a -b" and "-a-b" must not produce the same fingerprint)
+	StringBuilder^ builder = gcnew StringBuilder();
+	for each(String^ argument in arguments) builder->Append(argument)->Append(L'\0');
+	String^ joined = builder->ToString();
+
+	pin_ptr<const wchar_t> pinjoined = PtrToStringChars(joined);
+	Hash128(reinterpret_cast<const uint8_t*>(pinjoined), joined->Length * sizeof(wchar_t), high, low);
+
+	return CompileCommandFingerprint(high, low);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::Equals
+//
+// Compares this CompileCommandFingerprint to another CompileCommandFingerprint
+//
+// Arguments:
+//
+//	rhs		- Right-hand CompileCommandFingerprint to compare against
+
+bool CompileCommandFingerprint::Equals(CompileCommandFingerprint rhs)
+{
+	return (*this == rhs);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::Equals
+//
+// Overrides Object::Equals()
+//
+// Arguments:
+//
+//	rhs		- Right-hand object instance to compare against
+
+bool CompileCommandFingerprint::Equals(Object^ rhs)
+{
+	if(Object::ReferenceEquals(rhs, nullptr)) return false;
+
+	// Convert the provided object into a CompileCommandFingerprint instance
+	CompileCommandFingerprint^ rhsref = dynamic_cast<CompileCommandFingerprint^>(rhs);
+	if(rhsref == nullptr) return false;
+
+	return (*this == *rhsref);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::GetHashCode
+//
+// Overrides Object::GetHashCode()
+//
+// Arguments:
+//
+//	NONE
+
+int CompileCommandFingerprint::GetHashCode(void)
+{
+	// The fingerprint is already a well distributed hash
+	return static_cast<int>(m_low);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::High::get
+//
+// Gets the high 64 bits of the fingerprint
+
+UInt64 CompileCommandFingerprint::High::get(void)
+{
+	return m_high;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::Low::get
+//
+// Gets the low 64 bits of the fingerprint
+
+UInt64 CompileCommandFingerprint::Low::get(void)
+{
+	return m_low;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandFingerprint::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ CompileCommandFingerprint::ToString(void)
+{
+	return String::Format("{0:x16}{1:x16}", m_high, m_low);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
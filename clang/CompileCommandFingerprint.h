@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPILECOMMANDFINGERPRINT_H_
+#define __COMPILECOMMANDFINGERPRINT_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class CompileCommandFingerprint
+//
+// Stable 128-bit fingerprint of a normalized compile command.  Commands with
+// the same fingerprint can share preambles, precompiled headers and so on
+//---------------------------------------------------------------------------
+
+public value class CompileCommandFingerprint
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Overloaded Operators
+
+	// operator== (static)
+	//
+	static bool operator==(CompileCommandFingerprint lhs, CompileCommandFingerprint rhs);
+
+	// operator!= (static)
+	//
+	static bool operator!=(CompileCommandFingerprint lhs, CompileCommandFingerprint rhs);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Equals
+	//
+	// Overrides Object::Equals()
+	virtual bool Equals(Object^ rhs) override;
+
+	// Equals
+	//
+	// Compares this CompileCommandFingerprint to another CompileCommandFingerprint
+	bool Equals(CompileCommandFingerprint rhs);
+
+	// GetHashCode
+	//
+	// Overrides Object::GetHashCode()
+	virtual int GetHashCode(void) override;
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// High
+	//
+	// Gets the high 64 bits of the fingerprint
+	property UInt64 High
+	{
+		UInt64 get(void);
+	}
+
+	// Low
+	//
+	// Gets the low 64 bits of the fingerprint
+	property UInt64 Low
+	{
+		UInt64 get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CompileCommandFingerprint(UInt64 high, UInt64 low);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compute (static)
+	//
+	// Computes the fingerprint of a set of normalized arguments
+	static CompileCommandFingerprint Compute(IEnumerable<String^>^ arguments);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	UInt64					m_high;			// High 64 bits
+	UInt64					m_low;			// Low 64 bits
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPILECOMMANDFINGERPRINT_H_
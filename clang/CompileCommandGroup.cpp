@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompileCommandGroup.h"
+
+#include "CompileCommand.h"
+#include "CompileCommandArgumentCollection.h"
+#include "CompileCommandCollection.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompileCommandGroup Constructor (private)
+//
+// Arguments:
+//
+//	fingerprint		- Fingerprint of the normalized arguments
+//	arguments		- Normalized arguments
+//	commands		- Commands that belong to the group
+
+CompileCommandGroup::CompileCommandGroup(CompileCommandFingerprint fingerprint, array<String^>^ arguments, array<CompileCommand^>^ commands) :
+	m_fingerprint(fingerprint), m_commands(commands)
+{
+	if(Object::ReferenceEquals(arguments, nullptr)) throw gcnew ArgumentNullException("arguments");
+	if(Object::ReferenceEquals(commands, nullptr)) throw gcnew ArgumentNullException("commands");
+
+	m_arguments = CompileCommandArgumentCollection::Create(arguments);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandGroup::Arguments::get
+//
+// Gets the normalized arguments shared by every command in the group
+
+CompileCommandArgumentCollection^ CompileCommandGroup::Arguments::get(void)
+{
+	return m_arguments;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandGroup::Commands::get
+//
+// Gets the compile commands that belong to the group
+
+CompileCommandCollection^ CompileCommandGroup::Commands::get(void)
+{
+	// A new collection is returned each time so that disposing of one has
+	// no effect on the group; the command instances themselves are shared
+	return CompileCommandCollection::Create(m_commands);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandGroup::Create (internal, static)
+//
+// Creates a new CompileCommandGroup instance
+//
+// Arguments:
+//
+//	fingerprint		- Fingerprint of the normalized arguments
+//	arguments		- Normalized arguments
+//	commands		- Commands that belong to the group
+
+CompileCommandGroup^ CompileCommandGroup::Create(CompileCommandFingerprint fingerprint, array<String^>^ arguments, array<CompileCommand^>^ commands)
+{
+	return gcnew CompileCommandGroup(fingerprint, arguments, commands);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandGroup::Fingerprint::get
+//
+// Gets the fingerprint of the normalized arguments
+
+CompileCommandFingerprint CompileCommandGroup::Fingerprint::get(void)
+{
+	return m_fingerprint;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
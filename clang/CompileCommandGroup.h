@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPILECOMMANDGROUP_H_
+#define __COMPILECOMMANDGROUP_H_
+#pragma once
+
+#include "CompileCommandFingerprint.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompileCommand;
+ref class	CompileCommandArgumentCollection;
+ref class	CompileCommandCollection;
+
+//---------------------------------------------------------------------------
+// Class CompileCommandGroup
+//
+// Set of compile commands that share the same normalized flags
+//---------------------------------------------------------------------------
+
+public ref class CompileCommandGroup
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Arguments
+	//
+	// Gets the normalized arguments shared by every command in the group
+	property CompileCommandArgumentCollection^ Arguments
+	{
+		CompileCommandArgumentCollection^ get(void);
+	}
+
+	// Commands
+	//
+	// Gets the compile commands that belong to the group
+	property CompileCommandCollection^ Commands
+	{
+		CompileCommandCollection^ get(void);
+	}
+
+	// Fingerprint
+	//
+	// Gets the fingerprint of the normalized arguments
+	property CompileCommandFingerprint Fingerprint
+	{
+		CompileCommandFingerprint get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new CompileCommandGroup instance
+	static CompileCommandGroup^ Create(CompileCommandFingerprint fingerprint, array<String^>^ arguments, array<CompileCommand^>^ commands);
+
+private:
+
+	// Instance Constructor
+	//
+	CompileCommandGroup(CompileCommandFingerprint fingerprint, array<String^>^ arguments, array<CompileCommand^>^ commands);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CompileCommandFingerprint			m_fingerprint;	// Group fingerprint
+	CompileCommandArgumentCollection^	m_arguments;	// Normalized arguments
+	array<CompileCommand^>^				m_commands;		// Member commands
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPILECOMMANDGROUP_H_
@@ -0,0 +1,296 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompileCommandNormalizer.h"
+
+#include "CompilationDatabaseIndex.h"
+#include "CompileCommand.h"
+#include "CompileCommandArgumentCollection.h"
+
+using namespace System::IO;
+using namespace System::Linq;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::GetMacroName (private, static)
+//
+// Gets the macro name from a joined -D or -U argument
+//
+// Arguments:
+//
+//	argument	- Joined -D or -U argument
+
+String^ CompileCommandNormalizer::GetMacroName(String^ argument)
+{
+	int equals = argument->IndexOf(L'=', 2);
+	return (equals < 0) ? argument->Substring(2) : argument->Substring(2, equals - 2);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::GetHeaderLanguage (private, static)
+//
+// Gets the -x language to use when compiling a header file on its own, or
+// nullptr if the file is not a header file
+//
+// Arguments:
+//
+//	filename	- File name being compiled
+//	donor		- Source file name of the command being retargeted
+
+String^ CompileCommandNormalizer::GetHeaderLanguage(String^ filename, String^ donor)
+{
+	String^ extension = Path::GetExtension(filename);
+
+	// Extensionless files are treated as headers (<vector>, <string>, etc)
+	if(extension->Length > 0 && Array::IndexOf(s_headerexts, extension->ToLowerInvariant()) < 0) return nullptr;
+
+	// The language of the header is taken from the language of the donor
+	String^ source = Path::GetExtension(donor);
+	if(String::Equals(source, ".c", StringComparison::OrdinalIgnoreCase)) return "c-header";
+	if(String::Equals(source, ".m", StringComparison::OrdinalIgnoreCase)) return "objective-c-header";
+	if(String::Equals(source, ".mm", StringComparison::OrdinalIgnoreCase)) return "objective-c++-header";
+
+	return "c++-header";
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::GetPathOption (private, static)
+//
+// Determines if an argument is an option that takes a path, returns the
+// option or nullptr if the argument is not a path option
+//
+// Arguments:
+//
+//	argument	- Argument to be checked
+//	cl			- Flag if the compiler accepts cl-style options
+//	separate	- Set to true if the path is provided as the following argument
+
+String^ CompileCommandNormalizer::GetPathOption(String^ argument, bool cl, bool% separate)
+{
+	for each(String^ option in s_separatepaths) {
+
+		if(String::Equals(argument, option, StringComparison::Ordinal)) { separate = true; return option; }
+	}
+
+	for each(String^ option in s_joinablepaths) {
+
+		if(!argument->StartsWith(option, StringComparison::Ordinal)) continue;
+
+		separate = (argument->Length == option->Length);
+		return option;
+	}
+
+	// cl-style options are indistinguishable from absolute POSIX paths for other compilers
+	if(!cl) return nullptr;
+
+	for each(String^ option in s_cljoinablepaths) {
+
+		if(!argument->StartsWith(option, StringComparison::Ordinal)) continue;
+
+		separate = (argument->Length == option->Length);
+		return option;
+	}
+
+	return nullptr;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::IsClDriver (private, static)
+//
+// Determines if a compiler executable accepts cl-style options
+//
+// Arguments:
+//
+//	executable	- Compiler executable from the command line
+
+bool CompileCommandNormalizer::IsClDriver(String^ executable)
+{
+	if(Object::ReferenceEquals(executable, nullptr)) return false;
+
+	// The executable is not necessarily a valid path, strip it manually
+	String^ name = executable->Substring(executable->LastIndexOfAny(gcnew array<wchar_t> { L'/', L'\\' }) + 1);
+	if(name->EndsWith(".exe", StringComparison::OrdinalIgnoreCase)) name = name->Substring(0, name->Length - 4);
+
+	return String::Equals(name, "cl", StringComparison::OrdinalIgnoreCase) || 
+		name->StartsWith("clang-cl", StringComparison::OrdinalIgnoreCase);
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::IsOutputOption (static)
+//
+// Determines if an argument names an output file
+//
+// Arguments:
+//
+//	argument	- Argument to be checked
+//	cl			- Flag if the compiler accepts cl-style options
+//	separate	- Set to true if the file name is provided as the following argument
+
+bool CompileCommandNormalizer::IsOutputOption(String^ argument, bool cl, bool% separate)
+{
+	separate = false;
+	if(Object::ReferenceEquals(argument, nullptr)) return false;
+
+	if(String::Equals(argument, "-o", StringComparison::Ordinal)) { separate = true; return true; }
+
+	for each(String^ option in s_joinableoutputs) {
+
+		if(!argument->StartsWith(option, StringComparison::Ordinal)) continue;
+
+		separate = (argument->Length == option->Length);
+		return true;
+	}
+
+	for each(String^ option in s_joinedoutputs) if(argument->StartsWith(option, StringComparison::Ordinal)) return true;
+	if(cl) for each(String^ option in s_cljoinedoutputs) if(argument->StartsWith(option, StringComparison::Ordinal)) return true;
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::Normalize (static)
+//
+// Normalizes the arguments of a compile command
+//
+// Arguments:
+//
+//	command		- Compile command to be normalized
+
+array<String^>^ CompileCommandNormalizer::Normalize(CompileCommand^ command)
+{
+	bool				separate;			// Flag if option value is separate
+
+	if(Object::ReferenceEquals(command, nullptr)) throw gcnew ArgumentNullException("command");
+
+	String^ workdir = command->WorkingDirectory;
+	String^ input = CompilationDatabaseIndex::NormalizePath(workdir, command->Filename);
+	CompileCommandArgumentCollection^ arguments = command->Arguments;
+	bool cl = (arguments->Count > 0) && IsClDriver(arguments[0]);
+
+	List<String^>^ normalized = gcnew List<String^>(arguments->Count);
+	List<String^>^ macros = gcnew List<String^>();
+
+	for(int index = 0; index < arguments->Count; index++) {
+
+		String^ argument = arguments[index];
+
+		// The compiler executable is always kept as-is
+		if(index == 0) { normalized->Add(argument); continue; }
+
+		// Output files are different for every command, drop them and their values
+		if(IsOutputOption(argument, cl, separate)) { if(separate) index++; continue; }
+
+		// Macro definitions are collected and put into a canonical order
+		if(argument->StartsWith("-D", StringComparison::Ordinal) || argument->StartsWith("-U", StringComparison::Ordinal)) {
+
+			if((argument->Length == 2) && (index + 1 < arguments->Count)) argument = String::Concat(argument, arguments[++index]);
+			macros->Add(argument);
+			continue;
+		}
+
+		// Path options are resolved against the working directory and always joined
+		String^ option = GetPathOption(argument, cl, separate);
+		if(!Object::ReferenceEquals(option, nullptr)) {
+
+			String^ path = (separate) ? ((index + 1 < arguments->Count) ? arguments[++index] : String::Empty) : argument->Substring(option->Length);
+			normalized->Add(String::Concat(option, (path->Length == 0) ? path : CompilationDatabaseIndex::NormalizePath(workdir, path)));
+			continue;
+		}
+
+		// The input file itself is dropped
+		if(!argument->StartsWith("-", StringComparison::Ordinal) && 
+			String::Equals(CompilationDatabaseIndex::NormalizePath(workdir, argument), input, StringComparison::OrdinalIgnoreCase)) continue;
+
+		normalized->Add(argument);
+	}
+
+	// Definitions of different macros are independent of each other, but the order of -D
+	// and -U for the same macro is significant; a stable sort by name respects both
+	normalized->AddRange(Enumerable::OrderBy(macros, gcnew Func<String^, String^>(&CompileCommandNormalizer::GetMacroName), StringComparer::Ordinal));
+
+	return normalized->ToArray();
+}
+
+//---------------------------------------------------------------------------
+// CompileCommandNormalizer::Retarget (static)
+//
+// Rewrites the arguments of a compile command to compile a different file
+//
+// Arguments:
+//
+//	command		- Compile command to be retargeted
+//	filename	- Normalized name of the file to be compiled instead
+
+array<String^>^ CompileCommandNormalizer::Retarget(CompileCommand^ command, String^ filename)
+{
+	bool				separate;			// Flag if option value is separate
+
+	if(Object::ReferenceEquals(command, nullptr)) throw gcnew ArgumentNullException("command");
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+
+	String^ workdir = command->WorkingDirectory;
+	String^ input = CompilationDatabaseIndex::NormalizePath(workdir, command->Filename);
+	String^ language = GetHeaderLanguage(filename, input);
+	CompileCommandArgumentCollection^ arguments = command->Arguments;
+	bool cl = (arguments->Count > 0) && IsClDriver(arguments[0]);
+
+	List<String^>^ retargeted = gcnew List<String^>(arguments->Count + 3);
+
+	for(int index = 0; index < arguments->Count; index++) {
+
+		String^ argument = arguments[index];
+
+		// The compiler executable is always kept as-is
+		if(index == 0) { retargeted->Add(argument); continue; }
+
+		// Output files belong to the original file, drop them and their values
+		if(IsOutputOption(argument, cl, separate)) { if(separate) index++; continue; }
+
+		// An explicit language is replaced when the new file is a header
+		if(!Object::ReferenceEquals(language, nullptr) && argument->StartsWith("-x", StringComparison::Ordinal)) {
+
+			if(argument->Length == 2) index++;
+			continue;
+		}
+
+		// The original input file is dropped and the new one added at the end
+		if(!argument->StartsWith("-", StringComparison::Ordinal) && 
+			String::Equals(CompilationDatabaseIndex::NormalizePath(workdir, argument), input, StringComparison::OrdinalIgnoreCase)) continue;
+
+		retargeted->Add(argument);
+	}
+
+	if(!Object::ReferenceEquals(language, nullptr)) { retargeted->Add("-x"); retargeted->Add(language); }
+	retargeted->Add(filename);
+
+	return retargeted->ToArray();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
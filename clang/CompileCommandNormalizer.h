@@ -0,0 +1,126 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPILECOMMANDNORMALIZER_H_
+#define __COMPILECOMMANDNORMALIZER_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompileCommand;
+
+//---------------------------------------------------------------------------
+// Class CompileCommandNormalizer (internal)
+//
+// Reduces a compile command to the set of flags that affect how a source
+// file is parsed: the input and output files are removed, path arguments
+// are resolved against the working directory and macro definitions are put
+// into a canonical order
+//---------------------------------------------------------------------------
+
+ref class CompileCommandNormalizer abstract sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// IsOutputOption (static)
+	//
+	// Determines if an argument names an output file, and if the file name
+	// is provided as the following argument
+	static bool IsOutputOption(String^ argument, bool cl, bool% separate);
+
+	// Normalize (static)
+	//
+	// Normalizes the arguments of a compile command
+	static array<String^>^ Normalize(CompileCommand^ command);
+
+	// Retarget (static)
+	//
+	// Rewrites the arguments of a compile command to compile a different file
+	static array<String^>^ Retarget(CompileCommand^ command, String^ filename);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetMacroName (static)
+	//
+	// Gets the macro name from a joined -D or -U argument
+	static String^ GetMacroName(String^ argument);
+
+	// GetHeaderLanguage (static)
+	//
+	// Gets the -x language to use when compiling a header file on its own
+	static String^ GetHeaderLanguage(String^ filename, String^ donor);
+
+	// GetPathOption (static)
+	//
+	// Determines if an argument is an option that takes a path
+	static String^ GetPathOption(String^ argument, bool cl, bool% separate);
+
+	// IsClDriver (static)
+	//
+	// Determines if a compiler executable accepts cl-style options
+	static bool IsClDriver(String^ executable);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	// Path options that accept a joined or a separate path
+	static initonly array<String^>^ s_joinablepaths = gcnew array<String^> { "-I", "-isystem", "-iquote", "-idirafter" };
+
+	// cl-style path options that accept a joined or a separate path
+	static initonly array<String^>^ s_cljoinablepaths = gcnew array<String^> { "/I" };
+
+	// Path options that only accept a separate path
+	static initonly array<String^>^ s_separatepaths = gcnew array<String^> { "-include", "-include-pch", "-imacros" };
+
+	// Output options that accept a joined or a separate file name
+	static initonly array<String^>^ s_joinableoutputs = gcnew array<String^> { "-MF", "-MT", "-MQ" };
+
+	// Output options that only accept a joined file name
+	static initonly array<String^>^ s_joinedoutputs = gcnew array<String^> { "-Fo" };
+
+	// cl-style output options that only accept a joined file name
+	static initonly array<String^>^ s_cljoinedoutputs = gcnew array<String^> { "/Fo" };
+
+	// File extensions that identify header files
+	static initonly array<String^>^ s_headerexts = gcnew array<String^> { ".h", ".hh", ".hpp", ".hxx", ".h++", ".inc", ".inl", ".ipp", ".tcc" };
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPILECOMMANDNORMALIZER_H_
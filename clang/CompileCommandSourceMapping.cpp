@@ -72,6 +72,21 @@ CompileCommandSourceMapping^ CompileCommandSourceMapping::Create(SafeHandle^ own
 		StringUtil::ToString(clang_CompileCommand_getMappedSourceContent(command, index)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandSourceMapping::Create (internal, static)
+//
+// Creates a new CompileCommandSourceMapping instance
+//
+// Arguments:
+//
+//	path			- Mapped source path string
+//	content			- Mapped source content string
+
+CompileCommandSourceMapping^ CompileCommandSourceMapping::Create(String^ path, String^ content)
+{
+	return gcnew CompileCommandSourceMapping(path, content);
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandSourceMapping::Path::get
 //
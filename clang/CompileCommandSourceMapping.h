@@ -69,6 +69,7 @@ internal:
 	//
 	// Creates a new CompileCommandSourceMapping instance
 	static CompileCommandSourceMapping^ Create(SafeHandle^ owner, CXCompileCommand command, unsigned int index);
+	static CompileCommandSourceMapping^ Create(String^ path, String^ content);
 
 private:
 
@@ -44,6 +44,18 @@ CompileCommandSourceMappingCollection::CompileCommandSourceMappingCollection(Com
 	m_cache = gcnew array<CompileCommandSourceMapping^>(clang_CompileCommand_getNumMappedSources(CompileCommandHandle::Reference(m_handle)));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandSourceMappingCollection Constructor (private)
+//
+// Arguments:
+//
+//	mappings		- Materialized source mappings
+
+CompileCommandSourceMappingCollection::CompileCommandSourceMappingCollection(array<CompileCommandSourceMapping^>^ mappings) : m_cache(mappings)
+{
+	if(Object::ReferenceEquals(mappings, nullptr)) throw gcnew ArgumentNullException("mappings");
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandSourceMappingCollection::default[int]::get
 //
@@ -86,6 +98,20 @@ CompileCommandSourceMappingCollection^ CompileCommandSourceMappingCollection::Cr
 	return gcnew CompileCommandSourceMappingCollection(gcnew CompileCommandHandle(owner, command));
 }
 
+//---------------------------------------------------------------------------
+// CompileCommandSourceMappingCollection::Create (static, internal)
+//
+// Creates a new CompileCommandSourceMappingCollection instance
+//
+// Arguments:
+//
+//	mappings		- Materialized source mappings; the array is not copied
+
+CompileCommandSourceMappingCollection^ CompileCommandSourceMappingCollection::Create(array<CompileCommandSourceMapping^>^ mappings)
+{
+	return gcnew CompileCommandSourceMappingCollection(mappings);
+}
+
 //---------------------------------------------------------------------------
 // CompileCommandSourceMappingCollection::GetEnumerator
 //
@@ -84,6 +84,7 @@ internal:
 	//
 	// Creates a new CompileCommandSourceMappingCollection instance
 	static CompileCommandSourceMappingCollection^ Create(SafeHandle^ owner, CXCompileCommand command);
+	static CompileCommandSourceMappingCollection^ Create(array<CompileCommandSourceMapping^>^ mappings);
 
 private:
 
@@ -95,6 +96,7 @@ private:
 	// Instance Constructor
 	//
 	CompileCommandSourceMappingCollection(CompileCommandHandle^ handle);
+	CompileCommandSourceMappingCollection(array<CompileCommandSourceMapping^>^ mappings);
 
 	//-----------------------------------------------------------------------
 	// Private Member Functions
@@ -0,0 +1,196 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompletionChunkTable.h"
+
+#include "CompletionChunkKind.h"
+#include "StringInterner.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable Constructor (private)
+//
+// Arguments:
+//
+//	results		- Result index of each chunk
+//	kinds		- Kind of each chunk
+//	texts		- Text of each chunk
+//	depths		- Nesting depth of each chunk
+//	offsets		- Index of the first chunk of each result
+
+CompletionChunkTable::CompletionChunkTable(array<int>^ results, array<CompletionChunkKind>^ kinds, array<String^>^ texts, array<int>^ depths, array<int>^ offsets) :
+	m_results(results), m_kinds(kinds), m_texts(texts), m_depths(depths), m_offsets(offsets)
+{
+	if(Object::ReferenceEquals(results, nullptr)) throw gcnew ArgumentNullException("results");
+	if(Object::ReferenceEquals(kinds, nullptr)) throw gcnew ArgumentNullException("kinds");
+	if(Object::ReferenceEquals(texts, nullptr)) throw gcnew ArgumentNullException("texts");
+	if(Object::ReferenceEquals(depths, nullptr)) throw gcnew ArgumentNullException("depths");
+	if(Object::ReferenceEquals(offsets, nullptr)) throw gcnew ArgumentNullException("offsets");
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::AppendChunks (private, static)
+//
+// Appends the chunks of a completion string to the table columns
+//
+// Arguments:
+//
+//	string		- Completion string to be flattened
+//	result		- Index of the result that owns the completion string
+//	depth		- Nesting depth of the completion string
+//	strings		- String interner for the chunk texts
+//	results		- Result index column
+//	kinds		- Chunk kind column
+//	texts		- Chunk text column
+//	depths		- Nesting depth column
+
+void CompletionChunkTable::AppendChunks(CXCompletionString string, int result, int depth, StringInterner^ strings, List<int>^ results, 
+	List<CompletionChunkKind>^ kinds, List<String^>^ texts, List<int>^ depths)
+{
+	unsigned int numchunks = clang_getNumCompletionChunks(string);
+
+	for(unsigned int index = 0; index < numchunks; index++) {
+
+		CXCompletionChunkKind kind = clang_getCompletionChunkKind(string, index);
+
+		results->Add(result);
+		kinds->Add(CompletionChunkKind(kind));
+		texts->Add(strings->Intern(clang_getCompletionChunkText(string, index)));
+		depths->Add(depth);
+
+		// Optional chunks are followed immediately by their own chunks at the next depth
+		if(kind == CXCompletionChunk_Optional) {
+
+			CXCompletionString optional = clang_getCompletionChunkCompletionString(string, index);
+			if(optional != __nullptr) AppendChunks(optional, result, depth + 1, strings, results, kinds, texts, depths);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::Count::get
+//
+// Gets the number of chunks in the table
+
+int CompletionChunkTable::Count::get(void)
+{
+	return m_kinds->Length;
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::Depths::get
+//
+// Gets the nesting depth of each chunk
+
+array<int>^ CompletionChunkTable::Depths::get(void)
+{
+	return m_depths;
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::Extract (internal, static)
+//
+// Extracts the chunks of a set of code completion results
+//
+// Arguments:
+//
+//	results		- Code completion results
+//	indices		- Indices of the selected results, or nullptr for all results
+
+CompletionChunkTable^ CompletionChunkTable::Extract(CXCodeCompleteResults* results, array<int>^ indices)
+{
+	int count = (results == __nullptr) ? 0 : static_cast<int>(results->NumResults);
+	if(!Object::ReferenceEquals(indices, nullptr)) count = indices->Length;
+
+	// Completion strings typically consist of a handful of chunks, use that as the
+	// initial capacity to avoid repeatedly growing the columns for large result sets
+	int capacity = count * 4;
+
+	StringInterner^ strings = gcnew StringInterner();
+	List<int>^ resultindices = gcnew List<int>(capacity);
+	List<CompletionChunkKind>^ kinds = gcnew List<CompletionChunkKind>(capacity);
+	List<String^>^ texts = gcnew List<String^>(capacity);
+	List<int>^ depths = gcnew List<int>(capacity);
+	array<int>^ offsets = gcnew array<int>(count + 1);
+
+	for(int index = 0; index < count; index++) {
+
+		int result = (Object::ReferenceEquals(indices, nullptr)) ? index : indices[index];
+
+		offsets[index] = kinds->Count;
+		AppendChunks(results->Results[result].CompletionString, index, 0, strings, resultindices, kinds, texts, depths);
+	}
+
+	offsets[count] = kinds->Count;
+
+	return gcnew CompletionChunkTable(resultindices->ToArray(), kinds->ToArray(), texts->ToArray(), depths->ToArray(), offsets);
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::Kinds::get
+//
+// Gets the kind of each chunk
+
+array<CompletionChunkKind>^ CompletionChunkTable::Kinds::get(void)
+{
+	return m_kinds;
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::ResultIndices::get
+//
+// Gets the index of the result that each chunk belongs to
+
+array<int>^ CompletionChunkTable::ResultIndices::get(void)
+{
+	return m_results;
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::ResultOffsets::get
+//
+// Gets the index of the first chunk of each result
+
+array<int>^ CompletionChunkTable::ResultOffsets::get(void)
+{
+	return m_offsets;
+}
+
+//---------------------------------------------------------------------------
+// CompletionChunkTable::Texts::get
+//
+// Gets the text of each chunk
+
+array<String^>^ CompletionChunkTable::Texts::get(void)
+{
+	return m_texts;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
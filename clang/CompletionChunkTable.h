@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPLETIONCHUNKTABLE_H_
+#define __COMPLETIONCHUNKTABLE_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+enum class	CompletionChunkKind;
+ref class	StringInterner;
+
+//---------------------------------------------------------------------------
+// Class CompletionChunkTable
+//
+// Flattened chunks of every completion string in a set of code completion
+// results.  Each row describes one chunk: the index of the result it belongs
+// to, the kind of chunk, its text and its nesting depth.  Optional chunks
+// are followed by the rows of their nested completion string at the next
+// depth.  Identical strings share a single System::String instance
+//---------------------------------------------------------------------------
+
+public ref class CompletionChunkTable
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of chunks in the table
+	property int Count
+	{
+		int get(void);
+	}
+
+	// Depths
+	//
+	// Gets the nesting depth of each chunk, top-level chunks are at depth zero
+	property array<int>^ Depths
+	{
+		array<int>^ get(void);
+	}
+
+	// Kinds
+	//
+	// Gets the kind of each chunk
+	property array<CompletionChunkKind>^ Kinds
+	{
+		array<CompletionChunkKind>^ get(void);
+	}
+
+	// ResultIndices
+	//
+	// Gets the index of the result that each chunk belongs to
+	property array<int>^ ResultIndices
+	{
+		array<int>^ get(void);
+	}
+
+	// ResultOffsets
+	//
+	// Gets the index of the first chunk of each result; the array has one
+	// more element than there are results so that the chunks of result N
+	// are always in the range [ResultOffsets[N], ResultOffsets[N + 1])
+	property array<int>^ ResultOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// Texts
+	//
+	// Gets the text of each chunk
+	property array<String^>^ Texts
+	{
+		array<String^>^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Extract (static)
+	//
+	// Extracts the chunks of a set of code completion results
+	static CompletionChunkTable^ Extract(CXCodeCompleteResults* results, array<int>^ indices);
+
+private:
+
+	// Instance Constructor
+	//
+	CompletionChunkTable(array<int>^ results, array<CompletionChunkKind>^ kinds, array<String^>^ texts, array<int>^ depths, array<int>^ offsets);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AppendChunks (static)
+	//
+	// Appends the chunks of a completion string to the table columns
+	static void AppendChunks(CXCompletionString string, int result, int depth, StringInterner^ strings, List<int>^ results, 
+		List<CompletionChunkKind>^ kinds, List<String^>^ texts, List<int>^ depths);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	array<int>^						m_results;			// Result indices
+	array<CompletionChunkKind>^		m_kinds;			// Chunk kinds
+	array<String^>^					m_texts;			// Chunk texts
+	array<int>^						m_depths;			// Chunk nesting depths
+	array<int>^						m_offsets;			// First chunk of each result
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPLETIONCHUNKTABLE_H_
@@ -0,0 +1,355 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompletionFilter.h"
+
+#include <emmintrin.h>
+
+#include "StringUtil.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+// MAX_TEXT (local)
+//
+// Maximum number of characters of typed text or filter that are considered
+static const size_t MAX_TEXT = 256;
+
+//---------------------------------------------------------------------------
+// UNMANAGED SCORER
+//
+// The scorer is compiled as native code so that case folding can use SSE2
+// intrinsics and so that the selection loop never crosses into managed code
+// for each of the (potentially tens of thousands of) results
+//---------------------------------------------------------------------------
+
+#pragma managed(push, off)
+
+// CompletionCandidate
+//
+// Scored code completion result
+struct CompletionCandidate
+{
+	unsigned int		index;			// Index of the result
+	unsigned int		priority;		// Completion priority (lower is better)
+	int					score;			// Fuzzy match score (higher is better)
+};
+
+//---------------------------------------------------------------------------
+// IsBetter (local)
+//
+// Determines if one candidate ranks ahead of another
+//
+// Arguments:
+//
+//	lhs			- Left-hand candidate
+//	rhs			- Right-hand candidate
+
+static inline bool IsBetter(const CompletionCandidate& lhs, const CompletionCandidate& rhs)
+{
+	if(lhs.score != rhs.score) return lhs.score > rhs.score;
+	if(lhs.priority != rhs.priority) return lhs.priority < rhs.priority;
+	return lhs.index < rhs.index;
+}
+
+//---------------------------------------------------------------------------
+// IsWordStart (local)
+//
+// Determines if a character starts a word within an identifier
+//
+// Arguments:
+//
+//	text		- Original (not case folded) text
+//	position	- Position of the character within the text
+
+static inline bool IsWordStart(const char* text, size_t position)
+{
+	if(position == 0) return true;
+
+	char previous = text[position - 1];
+	char current = text[position];
+
+	if(previous == '_' || previous == ':' || previous == '.') return true;
+	if((current >= 'A' && current <= 'Z') && (previous >= 'a' && previous <= 'z')) return true;
+	return ((current < '0' || current > '9') && (previous >= '0' && previous <= '9'));
+}
+
+//---------------------------------------------------------------------------
+// LowerCase (local)
+//
+// Folds ASCII upper case characters to lower case
+//
+// Arguments:
+//
+//	text		- Text to be case folded
+//	length		- Length of the text
+//	lower		- Destination buffer, must be at least length bytes
+
+static inline void LowerCase(const char* text, size_t length, uint8_t* lower)
+{
+	const __m128i before = _mm_set1_epi8('A' - 1);
+	const __m128i after = _mm_set1_epi8('Z' + 1);
+	const __m128i casebit = _mm_set1_epi8(0x20);
+
+	size_t index = 0;
+
+	// Bytes above 0x7F compare as negative and are never folded, which leaves
+	// UTF-8 multibyte sequences intact
+	for(; index + 16 <= length; index += 16) {
+
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + index));
+		__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, before), _mm_cmplt_epi8(block, after));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lower + index), _mm_or_si128(block, _mm_and_si128(upper, casebit)));
+	}
+
+	for(; index < length; index++) {
+
+		uint8_t ch = static_cast<uint8_t>(text[index]);
+		lower[index] = (ch >= 'A' && ch <= 'Z') ? (ch | 0x20) : ch;
+	}
+}
+
+//---------------------------------------------------------------------------
+// ScoreText (local)
+//
+// Scores typed text against a filter, or returns -1 if the filter characters
+// do not all appear in the text in order
+//
+// Arguments:
+//
+//	text		- Typed text of the completion result
+//	length		- Length of the typed text
+//	filter		- Original filter text
+//	lowered		- Case folded filter text
+//	filterlen	- Length of the filter text
+
+static int ScoreText(const char* text, size_t length, const char* filter, const uint8_t* lowered, size_t filterlen)
+{
+	uint8_t			lower[MAX_TEXT];		// Case folded text
+
+	if(filterlen == 0) return 0;
+	if(length > MAX_TEXT) length = MAX_TEXT;
+	if(filterlen > length) return -1;
+
+	LowerCase(text, length, lower);
+
+	int score = 0;
+	size_t position = 0;
+	bool prefix = true;
+
+	for(size_t index = 0; index < filterlen; index++) {
+
+		// Locate the next occurrence of the filter character
+		size_t found = position;
+		while((found < length) && (lower[found] != lowered[index])) found++;
+		if(found == length) return -1;
+
+		score += 16;
+		if(found == position && index > 0) score += 16;			// Consecutive
+		if(IsWordStart(text, found)) score += 24;				// Word start
+		if(text[found] == filter[index]) score += 2;			// Exact case
+		
+		// Skipped characters are penalized, but a single long gap should not
+		// outweigh the bonuses earned by the rest of the match
+		size_t gap = found - position;
+		score -= static_cast<int>((gap > 16) ? 16 : gap);
+
+		if(found != index) prefix = false;
+		position = found + 1;
+	}
+
+	// Prefix and exact matches rank ahead of everything else
+	if(prefix) score += (filterlen == length) ? 128 : 64;
+
+	return score;
+}
+
+//---------------------------------------------------------------------------
+// SiftDown (local)
+//
+// Restores the heap property below a node; the root is the worst candidate
+//
+// Arguments:
+//
+//	heap		- Candidate heap
+//	count		- Number of candidates in the heap
+//	index		- Index of the node to sift down
+
+static inline void SiftDown(CompletionCandidate* heap, unsigned int count, unsigned int index)
+{
+	for(;;) {
+
+		unsigned int worst = index;
+		unsigned int left = (index * 2) + 1;
+		unsigned int right = left + 1;
+
+		if((left < count) && IsBetter(heap[worst], heap[left])) worst = left;
+		if((right < count) && IsBetter(heap[worst], heap[right])) worst = right;
+		if(worst == index) return;
+
+		CompletionCandidate swap = heap[index];
+		heap[index] = heap[worst];
+		heap[worst] = swap;
+
+		index = worst;
+	}
+}
+
+//---------------------------------------------------------------------------
+// SiftUp (local)
+//
+// Restores the heap property above a node; the root is the worst candidate
+//
+// Arguments:
+//
+//	heap		- Candidate heap
+//	index		- Index of the node to sift up
+
+static inline void SiftUp(CompletionCandidate* heap, unsigned int index)
+{
+	while(index > 0) {
+
+		unsigned int parent = (index - 1) / 2;
+		if(!IsBetter(heap[parent], heap[index])) return;
+
+		CompletionCandidate swap = heap[index];
+		heap[index] = heap[parent];
+		heap[parent] = swap;
+
+		index = parent;
+	}
+}
+
+//---------------------------------------------------------------------------
+// SelectCandidates (local)
+//
+// Scores every code completion result and keeps the best candidates in a
+// bounded heap, which is then sorted best-first
+//
+// Arguments:
+//
+//	results		- Code completion results
+//	filter		- Filter text
+//	filterlen	- Length of the filter text
+//	heap		- Candidate buffer
+//	capacity	- Maximum number of candidates to select
+
+static unsigned int SelectCandidates(CXCodeCompleteResults* results, const char* filter, size_t filterlen, CompletionCandidate* heap, unsigned int capacity)
+{
+	uint8_t				lowered[MAX_TEXT];		// Case folded filter
+
+	if(filterlen > MAX_TEXT) filterlen = MAX_TEXT;
+	LowerCase(filter, filterlen, lowered);
+
+	unsigned int count = 0;
+
+	for(unsigned int index = 0; index < results->NumResults; index++) {
+
+		CXCompletionString string = results->Results[index].CompletionString;
+		CompletionCandidate candidate = { index, clang_getCompletionPriority(string), (filterlen == 0) ? 0 : -1 };
+
+		// Only the typed text chunk is matched against the filter; results without
+		// typed text (code patterns) only survive an empty filter
+		unsigned int numchunks = clang_getNumCompletionChunks(string);
+		for(unsigned int chunk = 0; (chunk < numchunks) && (filterlen > 0); chunk++) {
+
+			if(clang_getCompletionChunkKind(string, chunk) != CXCompletionChunk_TypedText) continue;
+
+			CXString text = clang_getCompletionChunkText(string, chunk);
+			const char* psz = clang_getCString(text);
+			if(psz != __nullptr) candidate.score = ScoreText(psz, strlen(psz), filter, lowered, filterlen);
+			clang_disposeString(text);
+			break;
+		}
+
+		if(candidate.score < 0) continue;
+
+		// Fill the heap first, then only replace the worst candidate with better ones
+		if(count < capacity) { heap[count] = candidate; SiftUp(heap, count++); }
+		else if(IsBetter(candidate, heap[0])) { heap[0] = candidate; SiftDown(heap, count, 0); }
+	}
+
+	// Repeatedly moving the worst remaining candidate to the end sorts best-first
+	for(unsigned int end = count; end > 1; end--) {
+
+		CompletionCandidate swap = heap[0];
+		heap[0] = heap[end - 1];
+		heap[end - 1] = swap;
+
+		SiftDown(heap, end - 1, 0);
+	}
+
+	return count;
+}
+
+#pragma managed(pop)
+
+//---------------------------------------------------------------------------
+// CompletionFilter::Apply (static)
+//
+// Selects the indices of the best matching results
+//
+// Arguments:
+//
+//	results		- Code completion results to be filtered
+//	filter		- Filter text to match against the typed text of each result
+//	maxresults	- Maximum number of results to select
+
+array<int>^ CompletionFilter::Apply(CXCodeCompleteResults* results, String^ filter, int maxresults)
+{
+	CompletionCandidate*		candidates = __nullptr;		// Selected candidates
+
+	if(Object::ReferenceEquals(filter, nullptr)) throw gcnew ArgumentNullException("filter");
+	if(maxresults <= 0) throw gcnew ArgumentOutOfRangeException("maxresults");
+
+	if((results == __nullptr) || (results->NumResults == 0)) return gcnew array<int>(0);
+	unsigned int capacity = Math::Min(static_cast<unsigned int>(maxresults), results->NumResults);
+
+	try { candidates = new CompletionCandidate[capacity]; }
+	catch(Exception^) { throw gcnew OutOfMemoryException(); }
+
+	char* pszfilter = StringUtil::ToCharPointer(filter, CP_UTF8);
+
+	try {
+
+		unsigned int count = SelectCandidates(results, pszfilter, strlen(pszfilter), candidates, capacity);
+
+		array<int>^ indices = gcnew array<int>(count);
+		for(unsigned int index = 0; index < count; index++) indices[index] = static_cast<int>(candidates[index].index);
+
+		return indices;
+	}
+
+	finally {
+
+		StringUtil::FreeCharPointer(pszfilter);
+		delete[] candidates;
+	}
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
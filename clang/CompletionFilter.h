@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPLETIONFILTER_H_
+#define __COMPLETIONFILTER_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class CompletionFilter (internal)
+//
+// Fuzzy matches the typed text of each code completion result against a
+// filter string and selects the best matches.  Scoring and selection are
+// performed in native code directly against the CXCodeCompleteResults so
+// that no managed objects are created for results that are discarded
+//---------------------------------------------------------------------------
+
+ref class CompletionFilter abstract sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Apply (static)
+	//
+	// Selects the indices of the best matching results, ranked by score
+	// and then by completion priority
+	static array<int>^ Apply(CXCodeCompleteResults* results, String^ filter, int maxresults);
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPLETIONFILTER_H_
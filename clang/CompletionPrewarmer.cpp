@@ -0,0 +1,397 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompletionPrewarmer.h"
+
+#include "TranslationUnit.h"
+#include "UnsavedFile.h"
+
+using namespace System::IO;
+using namespace System::Text;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+// MAX_POINTS (local)
+//
+// Maximum number of positions that are pre-warmed, including the caret
+static const int MAX_POINTS = 4;
+
+// SCAN_LINES (local)
+//
+// Number of lines above and below the caret that are scanned for trigger points
+static const int SCAN_LINES = 8;
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer Constructor (private)
+//
+// Arguments:
+//
+//	unit		- Parent TranslationUnit instance
+
+CompletionPrewarmer::CompletionPrewarmer(TranslationUnit^ unit) : m_unit(unit), m_hits(0)
+{
+	if(Object::ReferenceEquals(unit, nullptr)) throw gcnew ArgumentNullException("unit");
+
+	m_cache = gcnew Dictionary<String^, IntPtr>(StringComparer::Ordinal);
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Create (internal, static)
+//
+// Creates a new CompletionPrewarmer instance
+//
+// Arguments:
+//
+//	unit		- Parent TranslationUnit instance
+
+CompletionPrewarmer^ CompletionPrewarmer::Create(TranslationUnit^ unit)
+{
+	return gcnew CompletionPrewarmer(unit);
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Discard (private)
+//
+// Releases all of the cached results
+//
+// Arguments:
+//
+//	NONE
+
+void CompletionPrewarmer::Discard(void)
+{
+	Monitor::Enter(m_cache);
+
+	try {
+
+		for each(IntPtr results in m_cache->Values) clang_disposeCodeCompleteResults(reinterpret_cast<CXCodeCompleteResults*>(results.ToPointer()));
+		m_cache->Clear();
+	}
+
+	finally { Monitor::Exit(m_cache); }
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::FindTriggerPoints (private, static)
+//
+// Locates the positions after member access and scope resolution operators
+// near the caret, ordered by their distance from the caret
+//
+// Arguments:
+//
+//	content		- Content of the file being completed
+//	line		- Line position of the caret
+//	column		- Column position of the caret
+
+List<KeyValuePair<int, int>>^ CompletionPrewarmer::FindTriggerPoints(String^ content, int line, int column)
+{
+	List<KeyValuePair<int, int>>^ points = gcnew List<KeyValuePair<int, int>>();
+	List<Int64>^ distances = gcnew List<Int64>();
+
+	if(Object::ReferenceEquals(content, nullptr)) return points;
+
+	array<String^>^ lines = content->Split('\n');
+
+	for(int current = Math::Max(1, line - SCAN_LINES); current <= Math::Min(lines->Length, line + SCAN_LINES); current++) {
+
+		String^ text = lines[current - 1];
+
+		for(int index = 0; index < text->Length; index++) {
+
+			int end = -1;
+			wchar_t ch = text[index];
+			wchar_t next = (index + 1 < text->Length) ? text[index + 1] : L'\0';
+			wchar_t previous = (index > 0) ? text[index - 1] : L'\0';
+
+			// Member access (excluding ellipses and floating point literals) and scope resolution;
+			// this is purely lexical, operators inside of comments and strings are not excluded
+			if((ch == L'.') && (next != L'.') && (previous != L'.') && !Char::IsDigit(next) && !Char::IsDigit(previous)) end = index + 1;
+			else if((ch == L'-') && (next == L'>')) end = index + 2;
+			else if((ch == L':') && (next == L':')) end = index + 2;
+
+			if(end < 0) continue;
+			index = end - 1;
+
+			// Columns are 1-based byte offsets into the UTF-8 representation of the line
+			int position = Encoding::UTF8->GetByteCount(text->Substring(0, end)) + 1;
+
+			points->Add(KeyValuePair<int, int>(current, position));
+			distances->Add((static_cast<Int64>(Math::Abs(current - line)) << 32) | Math::Abs(position - column));
+		}
+	}
+
+	// Order the points by distance from the caret, lines first and then columns
+	array<Int64>^ keys = distances->ToArray();
+	array<KeyValuePair<int, int>>^ items = points->ToArray();
+	Array::Sort(keys, items);
+
+	return gcnew List<KeyValuePair<int, int>>(items);
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::GetKey (private, static)
+//
+// Generates the cache key for a completion request
+//
+// Arguments:
+//
+//	filename	- Name of the file being completed
+//	line		- Line position of the completion
+//	column		- Column position of the completion
+//	options		- Code completion options
+//	version		- Hash of the unsaved files
+
+String^ CompletionPrewarmer::GetKey(String^ filename, int line, int column, CompletionOptions options, UInt64 version)
+{
+	return String::Format("{0}|{1}|{2}|{3:X8}|{4:X16}", filename, line, column, static_cast<int>(options), version);
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::GetVersion (private, static)
+//
+// Generates a hash of the names and contents of a set of unsaved files
+//
+// Arguments:
+//
+//	unsavedfiles	- Unsaved files to be hashed
+
+UInt64 CompletionPrewarmer::GetVersion(IEnumerable<UnsavedFile^>^ unsavedfiles)
+{
+	UInt64 hash = 14695981039346656037ULL;			// FNV-1a offset basis
+	if(Object::ReferenceEquals(unsavedfiles, nullptr)) return hash;
+
+	for each(UnsavedFile^ file in unsavedfiles) {
+
+		if(Object::ReferenceEquals(file, nullptr)) continue;
+
+		// The file name and the content are each terminated so that moving text
+		// between the two (or between files) changes the hash
+		for each(String^ part in gcnew array<String^> { file->FileName, file->Content }) {
+
+			if(!Object::ReferenceEquals(part, nullptr)) for each(wchar_t ch in part) { hash ^= ch; hash *= 1099511628211ULL; }
+			hash ^= 0xFFFF; hash *= 1099511628211ULL;
+		}
+	}
+
+	return hash;
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::HitCount::get
+//
+// Gets the number of completion requests that were served from the cache
+
+int CompletionPrewarmer::HitCount::get(void)
+{
+	return m_hits;
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Start
+//
+// Starts pre-warming completions around a position
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position of the caret
+//	column			- Column position of the caret
+//	unsavedfiles	- Collection of unsaved code files
+
+Task<int>^ CompletionPrewarmer::Start(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles)
+{
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+	if(line < 0) throw gcnew ArgumentOutOfRangeException("line");
+	if(column < 0) throw gcnew ArgumentOutOfRangeException("column");
+
+	// Results from a previous position are unlikely to be requested now, cancel the
+	// operation in progress without waiting for it and release anything it cached
+	CancellationTokenSource^ previous = m_cancel;
+	if(!Object::ReferenceEquals(previous, nullptr)) previous->Cancel();
+	Discard();
+
+	// The unsaved files are captured as they are right now, UnsavedFile is mutable
+	List<UnsavedFile^>^ snapshot = gcnew List<UnsavedFile^>();
+	String^ content = nullptr;
+
+	if(!Object::ReferenceEquals(unsavedfiles, nullptr)) {
+
+		for each(UnsavedFile^ file in unsavedfiles) {
+
+			if(Object::ReferenceEquals(file, nullptr)) continue;
+
+			snapshot->Add(gcnew UnsavedFile(file->FileName, file->Content));
+			if(String::Equals(file->FileName, filename, StringComparison::OrdinalIgnoreCase)) content = file->Content;
+		}
+	}
+
+	// If the file has not been modified it is read from disk; if it cannot be read
+	// only the caret position will be pre-warmed
+	if(Object::ReferenceEquals(content, nullptr)) {
+
+		try { content = File::ReadAllText(filename); }
+		catch(Exception^) { content = nullptr; }
+	}
+
+	// The caret is always the most likely position, followed by the nearest trigger points
+	List<KeyValuePair<int, int>>^ points = gcnew List<KeyValuePair<int, int>>(MAX_POINTS);
+	points->Add(KeyValuePair<int, int>(line, column));
+
+	for each(KeyValuePair<int, int> point in FindTriggerPoints(content, line, column)) {
+
+		if(points->Count == MAX_POINTS) break;
+		if((point.Key != line) || (point.Value != column)) points->Add(point);
+	}
+
+	m_cancel = gcnew CancellationTokenSource();
+
+	Request^ request = gcnew Request(this, filename, points, snapshot, static_cast<CompletionOptions>(clang_defaultCodeCompleteOptions()), 
+		GetVersion(snapshot), m_cancel->Token, previous);
+
+	// A dedicated thread is used so that its priority can be lowered without affecting the thread pool
+	if(Object::ReferenceEquals(m_task, nullptr)) 
+		m_task = Task<int>::Factory->StartNew(gcnew Func<int>(request, &Request::Run), m_cancel->Token, TaskCreationOptions::LongRunning, TaskScheduler::Default);
+
+	// Otherwise the new operation runs after the cancelled one has finished, which keeps Stop() waiting on
+	// every operation and releases the previous cancellation source only once nothing can observe it.  The
+	// continuation must not be cancellable, a cancelled continuation would complete before its predecessor
+	else m_task = m_task->ContinueWith<int>(gcnew Func<Task<int>^, int>(request, &Request::Continue), CancellationToken::None, 
+		TaskContinuationOptions::LongRunning, TaskScheduler::Default);
+
+	return m_task;
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Stop
+//
+// Stops any pre-warming operation and releases all cached results
+//
+// Arguments:
+//
+//	NONE
+
+void CompletionPrewarmer::Stop(void)
+{
+	if(!Object::ReferenceEquals(m_cancel, nullptr)) m_cancel->Cancel();
+
+	// Wait for the operation to finish, it may be in the middle of a libclang call
+	// against the translation unit that is about to be released; earlier operations
+	// always finish before the current one starts
+	if(!Object::ReferenceEquals(m_task, nullptr)) {
+
+		try { m_task->Wait(); }
+		catch(AggregateException^) { /* DO NOTHING */ }
+	}
+
+	Discard();
+
+	delete m_cancel;
+	m_cancel = nullptr;
+	m_task = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Take
+//
+// Removes and returns cached results that match a completion request
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position of the completion
+//	column			- Column position of the completion
+//	unsavedfiles	- Collection of unsaved code files
+//	options			- Code completion options
+
+CXCodeCompleteResults* CompletionPrewarmer::Take(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options)
+{
+	IntPtr			results;			// Cached completion results
+
+	// Avoid hashing the unsaved files when there is nothing to be found
+	if(m_cache->Count == 0) return __nullptr;
+
+	String^ key = GetKey(filename, line, column, options, GetVersion(unsavedfiles));
+
+	Monitor::Enter(m_cache);
+
+	try {
+
+		// Ownership of the results is transferred to the caller
+		if(!m_cache->TryGetValue(key, results)) return __nullptr;
+
+		m_cache->Remove(key);
+		m_hits++;
+
+		return reinterpret_cast<CXCodeCompleteResults*>(results.ToPointer());
+	}
+
+	finally { Monitor::Exit(m_cache); }
+}
+
+//---------------------------------------------------------------------------
+// CompletionPrewarmer::Warm (private)
+//
+// Performs code completion at each position of a pre-warming request
+//
+// Arguments:
+//
+//	request		- Pre-warming request
+
+int CompletionPrewarmer::Warm(Request^ request)
+{
+	int warmed = 0;
+
+	Thread::CurrentThread->Priority = ThreadPriority::BelowNormal;
+
+	for each(KeyValuePair<int, int> point in request->Points) {
+
+		if(request->Cancel.IsCancellationRequested) break;
+
+		// TranslationUnit serializes this call with any foreground completion request
+		CXCodeCompleteResults* results = m_unit->CodeCompleteAt(request->Filename, point.Key, point.Value, request->UnsavedFiles, request->Options);
+		if(results == __nullptr) continue;
+
+		String^ key = GetKey(request->Filename, point.Key, point.Value, request->Options, request->Version);
+
+		Monitor::Enter(m_cache);
+
+		try {
+
+			// Results from a cancelled operation are discarded rather than cached
+			if(request->Cancel.IsCancellationRequested || m_cache->ContainsKey(key)) clang_disposeCodeCompleteResults(results);
+			else { m_cache->Add(key, IntPtr(results)); warmed++; }
+		}
+
+		finally { Monitor::Exit(m_cache); }
+	}
+
+	return warmed;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
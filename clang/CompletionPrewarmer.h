@@ -0,0 +1,186 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPLETIONPREWARMER_H_
+#define __COMPLETIONPREWARMER_H_
+#pragma once
+
+#include "CompletionOptions.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	TranslationUnit;
+ref class	UnsavedFile;
+
+//---------------------------------------------------------------------------
+// Class CompletionPrewarmer (internal)
+//
+// Performs code completion in the background at the positions around the
+// caret where completion is likely to be requested next: the caret itself
+// and the nearest member access and scope resolution operators.  Results
+// are cached against the position and a hash of the unsaved file contents
+// and handed over to the next matching foreground completion request
+//---------------------------------------------------------------------------
+
+ref class CompletionPrewarmer
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Start
+	//
+	// Starts pre-warming completions around a position, cancelling any
+	// pre-warming operation that is still in progress
+	Task<int>^ Start(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles);
+
+	// Stop
+	//
+	// Stops any pre-warming operation and releases all cached results
+	void Stop(void);
+
+	// Take
+	//
+	// Removes and returns cached results that match a completion request
+	CXCodeCompleteResults* Take(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// HitCount
+	//
+	// Gets the number of completion requests that were served from the cache
+	property int HitCount
+	{
+		int get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new CompletionPrewarmer instance
+	static CompletionPrewarmer^ Create(TranslationUnit^ unit);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Class Request
+	//
+	// Parameters of a single pre-warming operation
+	ref class Request
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Request(CompletionPrewarmer^ owner, String^ filename, List<KeyValuePair<int, int>>^ points, List<UnsavedFile^>^ unsavedfiles, 
+			CompletionOptions options, UInt64 version, CancellationToken cancel, CancellationTokenSource^ previous) : Owner(owner), 
+			Filename(filename), Points(points), UnsavedFiles(unsavedfiles), Options(options), Version(version), Cancel(cancel), Previous(previous) {}
+
+		// Continue
+		//
+		// Entry point for a pre-warming task that follows a previous one
+		int Continue(Task<int>^) { delete Previous; return Owner->Warm(this); }
+
+		// Run
+		//
+		// Entry point for the pre-warming task
+		int Run(void) { return Owner->Warm(this); }
+
+		// Fields
+		//
+		initonly CompletionPrewarmer^				Owner;			// Owning prewarmer
+		initonly String^							Filename;		// File to complete in
+		initonly List<KeyValuePair<int, int>>^		Points;			// Line/column positions
+		initonly List<UnsavedFile^>^				UnsavedFiles;	// Unsaved file snapshot
+		initonly CompletionOptions					Options;		// Completion options
+		initonly UInt64								Version;		// Unsaved file hash
+		initonly CancellationToken					Cancel;			// Cancellation token
+		initonly CancellationTokenSource^			Previous;		// Previous cancellation source
+	};
+
+	// Instance Constructor
+	//
+	CompletionPrewarmer(TranslationUnit^ unit);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Discard
+	//
+	// Releases all of the cached results
+	void Discard(void);
+
+	// FindTriggerPoints (static)
+	//
+	// Locates the positions after member access and scope resolution operators
+	// near the caret, ordered by their distance from the caret
+	static List<KeyValuePair<int, int>>^ FindTriggerPoints(String^ content, int line, int column);
+
+	// GetKey (static)
+	//
+	// Generates the cache key for a completion request
+	static String^ GetKey(String^ filename, int line, int column, CompletionOptions options, UInt64 version);
+
+	// GetVersion (static)
+	//
+	// Generates a hash of the names and contents of a set of unsaved files
+	static UInt64 GetVersion(IEnumerable<UnsavedFile^>^ unsavedfiles);
+
+	// Warm
+	//
+	// Performs code completion at each position of a pre-warming request
+	int Warm(Request^ request);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	TranslationUnit^					m_unit;			// Parent translation unit
+	Dictionary<String^, IntPtr>^		m_cache;		// Cached completion results
+	CancellationTokenSource^			m_cancel;		// Current cancellation source
+	Task<int>^							m_task;			// Current pre-warming task
+	int									m_hits;			// Number of cache hits
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPLETIONPREWARMER_H_
@@ -23,7 +23,9 @@
 #include "stdafx.h"
 #include "CompletionResultCollection.h"
 
+#include "CompletionChunkTable.h"
 #include "CompletionContext.h"
+#include "CompletionFilter.h"
 #include "CompletionResult.h"
 #include "CompletionResultDiagnosticCollection.h"
 #include "CursorKind.h"
@@ -43,13 +45,18 @@ namespace zuki::tools::llvm::clang {
 //
 //	handle		- CodeCompleteResults safe handle
 //	transunit	- Parent TranslationUnitHandle instance
+//	indices		- Indices of the selected results, or nullptr for all results
+//	ownshandle	- Flag if the collection owns (and disposes of) the handle
 
-CompletionResultCollection::CompletionResultCollection(CodeCompleteResultsHandle^ handle, TranslationUnitHandle^ transunit) : m_handle(handle), m_transunit(transunit)
+CompletionResultCollection::CompletionResultCollection(CodeCompleteResultsHandle^ handle, TranslationUnitHandle^ transunit, array<int>^ indices, bool ownshandle) : 
+	m_handle(handle), m_transunit(transunit), m_indices(indices), m_ownshandle(ownshandle)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
 	if(Object::ReferenceEquals(transunit, nullptr)) throw gcnew ArgumentNullException("transunit");
 
-	m_cache = gcnew array<CompletionResult^>(CodeCompleteResultsHandle::Reference(m_handle)->NumResults);
+	// When a subset of the results has been selected, only that subset is exposed
+	m_cache = gcnew array<CompletionResult^>((Object::ReferenceEquals(indices, nullptr)) ? 
+		CodeCompleteResultsHandle::Reference(m_handle)->NumResults : indices->Length);
 }
 
 //---------------------------------------------------------------------------
@@ -59,7 +66,7 @@ CompletionResultCollection::~CompletionResultCollection()
 {
 	if(m_disposed) return;
 
-	delete m_handle;					// Release the safe handle
+	if(m_ownshandle) delete m_handle;	// Release the safe handle
 	m_disposed = true;					// Object is now in a disposed state
 }
 
@@ -78,7 +85,8 @@ CompletionResult^ CompletionResultCollection::default::get(int index)
 	if(!Object::ReferenceEquals(cached, nullptr)) return cached;
 
 	// Create a new CompletionResult and cache it to prevent multiple creations
-	m_cache[index] = CompletionResult::Create(m_handle, CodeCompleteResultsHandle::Reference(m_handle)->Results[index]);
+	int result = (Object::ReferenceEquals(m_indices, nullptr)) ? index : m_indices[index];
+	m_cache[index] = CompletionResult::Create(m_handle, CodeCompleteResultsHandle::Reference(m_handle)->Results[result]);
 	return m_cache[index];
 }
 
@@ -132,7 +140,47 @@ int CompletionResultCollection::Count::get(void)
 
 CompletionResultCollection^ CompletionResultCollection::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCodeCompleteResults*&& results)
 {
-	return gcnew CompletionResultCollection(gcnew CodeCompleteResultsHandle(owner, std::move(results)), transunit);
+	return gcnew CompletionResultCollection(gcnew CodeCompleteResultsHandle(owner, std::move(results)), transunit, nullptr, true);
+}
+
+//---------------------------------------------------------------------------
+// CompletionResultCollection::Create (internal, static)
+//
+// Creates a new CompletionResultCollection instance that exposes only the
+// best fuzzy matches for a filter string
+//
+// Arguments:
+//
+//	owner		- Owning safe handle instance
+//	transunit	- Parent TranslationUnitHandle instance
+//	results		- Unmanaged CXCodeCompleteResults instance
+//	filter		- Filter text to match against the typed text of each result
+//	maxresults	- Maximum number of results to expose
+
+CompletionResultCollection^ CompletionResultCollection::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCodeCompleteResults*&& results, String^ filter, int maxresults)
+{
+	// Take ownership of the results before filtering so they are not leaked on failure
+	CodeCompleteResultsHandle^ handle = gcnew CodeCompleteResultsHandle(owner, std::move(results));
+	return gcnew CompletionResultCollection(handle, transunit, CompletionFilter::Apply(CodeCompleteResultsHandle::Reference(handle), filter, maxresults), true);
+}
+
+//---------------------------------------------------------------------------
+// CompletionResultCollection::Create (internal, static)
+//
+// Creates a new CompletionResultCollection instance that exposes only the
+// best fuzzy matches for a filter string from a shared set of results; the
+// shared results handle is not disposed of by the collection
+//
+// Arguments:
+//
+//	shared		- Shared CXCodeCompleteResults safe handle
+//	transunit	- Parent TranslationUnitHandle instance
+//	filter		- Filter text to match against the typed text of each result
+//	maxresults	- Maximum number of results to expose
+
+CompletionResultCollection^ CompletionResultCollection::Create(CodeCompleteResultsHandle^ shared, TranslationUnitHandle^ transunit, String^ filter, int maxresults)
+{
+	return gcnew CompletionResultCollection(shared, transunit, CompletionFilter::Apply(CodeCompleteResultsHandle::Reference(shared), filter, maxresults), false);
 }
 
 //---------------------------------------------------------------------------
@@ -150,6 +198,21 @@ DiagnosticCollection^ CompletionResultCollection::Diagnostics::get(void)
 	return m_diags;
 }
 
+//---------------------------------------------------------------------------
+// CompletionResultCollection::ExtractChunks
+//
+// Flattens the chunks of every result into a single table
+//
+// Arguments:
+//
+//	NONE
+
+CompletionChunkTable^ CompletionResultCollection::ExtractChunks(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return CompletionChunkTable::Extract(CodeCompleteResultsHandle::Reference(m_handle), m_indices);
+}
+
 //---------------------------------------------------------------------------
 // Completion::GetContainerCursorKind
 //
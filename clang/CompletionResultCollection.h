@@ -36,6 +36,7 @@ namespace zuki::tools::llvm::clang {
 
 // FORWARD DECLARATIONS
 //
+ref class	CompletionChunkTable;
 enum class	CompletionContext;
 ref class	CompletionResult;
 value class	CursorKind;
@@ -56,6 +57,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// ExtractChunks
+	//
+	// Flattens the chunks of every result into a single table
+	CompletionChunkTable^ ExtractChunks(void);
+
 	// GetContainerCursorKind
 	//
 	// Returns the cursor kind for the container for the code completion context
@@ -120,6 +126,11 @@ public:
 
 internal:
 
+	// CodeCompleteResultsHandle
+	//
+	// Specialization of UnmanagedTypeSafeHandle for CXCodeCompleteResults*
+	using CodeCompleteResultsHandle = UnmanagedTypeSafeHandle<CXCodeCompleteResults*, clang_disposeCodeCompleteResults>;
+
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
@@ -127,17 +138,14 @@ internal:
 	//
 	// Creates a new CompletionResultCollection instance
 	static CompletionResultCollection^ Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCodeCompleteResults*&& results);
+	static CompletionResultCollection^ Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCodeCompleteResults*&& results, String^ filter, int maxresults);
+	static CompletionResultCollection^ Create(CodeCompleteResultsHandle^ shared, TranslationUnitHandle^ transunit, String^ filter, int maxresults);
 
 private:
 
-	// CodeCompleteResultsHandle
-	//
-	// Specialization of UnmanagedTypeSafeHandle for CXCodeCompleteResults*
-	using CodeCompleteResultsHandle = UnmanagedTypeSafeHandle<CXCodeCompleteResults*, clang_disposeCodeCompleteResults>;
-
 	// Instance Constructor
 	//
-	CompletionResultCollection(CodeCompleteResultsHandle^ handle, TranslationUnitHandle^ transunit);
+	CompletionResultCollection(CodeCompleteResultsHandle^ handle, TranslationUnitHandle^ transunit, array<int>^ indices, bool ownshandle);
 
 	// Destructor
 	//
@@ -157,7 +165,9 @@ private:
 	CodeCompleteResultsHandle^			m_handle;			// Underlying safe handle
 	TranslationUnitHandle^				m_transunit;		// Translation unit instance
 	bool								m_disposed;			// Object disposal flag
+	bool								m_ownshandle;		// Flag if handle is owned
 	array<CompletionResult^>^			m_cache;			// Element object cache
+	array<int>^							m_indices;			// Selected result indices
 	UnifiedSymbolResolution^			m_usr;				// Cached container USR
 	String^								m_objcselector;		// Cached obj-C selector
 	DiagnosticCollection^				m_diags;			// Cached diagnostics
@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CompletionSession.h"
+
+#include "TranslationUnit.h"
+#include "TranslationUnitHandle.h"
+#include "UnsavedFile.h"
+
+using namespace System::Text;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CompletionSession Constructor (private)
+//
+// Arguments:
+//
+//	unit		- Parent TranslationUnit instance
+//	filename	- Name of the file within the translation unit
+//	options		- Code completion options
+
+CompletionSession::CompletionSession(TranslationUnit^ unit, String^ filename, CompletionOptions options) : 
+	m_unit(unit), m_filename(filename), m_options(options)
+{
+	if(Object::ReferenceEquals(unit, nullptr)) throw gcnew ArgumentNullException("unit");
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession Destructor
+
+CompletionSession::~CompletionSession()
+{
+	if(m_disposed) return;
+
+	delete m_results;					// Release the cached results
+	m_disposed = true;					// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::CompleteAt
+//
+// Performs code completion for the identifier ending at the specified position
+//
+// Arguments:
+//
+//	line			- Line position within the file
+//	column			- Column position of the caret within the file
+//	filterText		- Portion of the identifier that has already been typed
+//	maxResults		- Maximum number of results to return
+
+CompletionResultCollection^ CompletionSession::CompleteAt(int line, int column, String^ filterText, int maxResults)
+{
+	CHECK_DISPOSED(m_disposed);
+	return CompleteAt(line, column, nullptr, filterText, maxResults);
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::CompleteAt
+//
+// Performs code completion for the identifier ending at the specified position
+//
+// Arguments:
+//
+//	line			- Line position within the file
+//	column			- Column position of the caret within the file
+//	unsavedfiles	- Collection of unsaved code files
+//	filterText		- Portion of the identifier that has already been typed
+//	maxResults		- Maximum number of results to return
+
+CompletionResultCollection^ CompletionSession::CompleteAt(int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, String^ filterText, int maxResults)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(filterText, nullptr)) throw gcnew ArgumentNullException("filterText");
+	if(maxResults <= 0) throw gcnew ArgumentOutOfRangeException("maxResults");
+
+	// Completion is always performed at the start of the identifier; columns are byte offsets
+	int start = column - Encoding::UTF8->GetByteCount(filterText);
+	if(start < 0) throw gcnew ArgumentOutOfRangeException("column");
+
+	// The cached results can be re-filtered as long as the identifier is being extended,
+	// anything else (a different identifier, or characters being removed) requires a new
+	// query since the context at the start position may no longer be the same
+	bool refine = !Object::ReferenceEquals(m_results, nullptr) && (line == m_line) && (start == m_start) && 
+		filterText->StartsWith(m_filter, StringComparison::Ordinal);
+
+	if(!refine) {
+
+		Reset();
+
+		CXCodeCompleteResults* results = m_unit->CodeCompleteAt(m_filename, line, start, unsavedfiles, m_options);
+		m_results = gcnew CodeCompleteResultsHandle(m_unit->Handle, std::move(results));
+
+		m_line = line;
+		m_start = start;
+		m_queries++;
+	}
+
+	m_filter = filterText;
+	return CompletionResultCollection::Create(m_results, m_unit->Handle, filterText, maxResults);
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::Create (internal, static)
+//
+// Creates a new CompletionSession instance
+//
+// Arguments:
+//
+//	unit		- Parent TranslationUnit instance
+//	filename	- Name of the file within the translation unit
+//	options		- Code completion options
+
+CompletionSession^ CompletionSession::Create(TranslationUnit^ unit, String^ filename, CompletionOptions options)
+{
+	return gcnew CompletionSession(unit, filename, options);
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::Filename::get
+//
+// Gets the name of the file that completions are performed in
+
+String^ CompletionSession::Filename::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_filename;
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::QueryCount::get
+//
+// Gets the number of times the session has invoked libclang code completion
+
+int CompletionSession::QueryCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_queries;
+}
+
+//---------------------------------------------------------------------------
+// CompletionSession::Reset
+//
+// Releases the cached results; the next completion will query libclang
+//
+// Arguments:
+//
+//	NONE
+
+void CompletionSession::Reset(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	delete m_results;
+	m_results = nullptr;
+	m_filter = nullptr;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __COMPLETIONSESSION_H_
+#define __COMPLETIONSESSION_H_
+#pragma once
+
+#include "CompletionOptions.h"
+#include "CompletionResultCollection.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	TranslationUnit;
+ref class	UnsavedFile;
+
+//---------------------------------------------------------------------------
+// Class CompletionSession
+//
+// Performs code completion for the identifier being typed in a file.  The
+// results from libclang are kept for as long as the caret is extending the
+// same identifier and are re-filtered rather than recomputed.  Collections
+// returned by the session are only valid until the session queries libclang
+// again, is reset or is disposed of
+//---------------------------------------------------------------------------
+
+public ref class CompletionSession
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// CompleteAt
+	//
+	// Performs code completion for the identifier ending at the specified
+	// position, filterText being the portion of the identifier already typed
+	CompletionResultCollection^ CompleteAt(int line, int column, String^ filterText, int maxResults);
+	CompletionResultCollection^ CompleteAt(int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, String^ filterText, int maxResults);
+
+	// Reset
+	//
+	// Releases the cached results; the next completion will query libclang
+	void Reset(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Filename
+	//
+	// Gets the name of the file that completions are performed in
+	property String^ Filename
+	{
+		String^ get(void);
+	}
+
+	// QueryCount
+	//
+	// Gets the number of times the session has invoked libclang code completion
+	property int QueryCount
+	{
+		int get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new CompletionSession instance
+	static CompletionSession^ Create(TranslationUnit^ unit, String^ filename, CompletionOptions options);
+
+private:
+
+	// CodeCompleteResultsHandle
+	//
+	// Specialization of UnmanagedTypeSafeHandle for CXCodeCompleteResults*
+	using CodeCompleteResultsHandle = CompletionResultCollection::CodeCompleteResultsHandle;
+
+	// Instance Constructor
+	//
+	CompletionSession(TranslationUnit^ unit, String^ filename, CompletionOptions options);
+
+	// Destructor
+	//
+	~CompletionSession();
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool							m_disposed;		// Object disposal flag
+	TranslationUnit^				m_unit;			// Parent translation unit
+	String^							m_filename;		// Completion file name
+	CompletionOptions				m_options;		// Completion options
+	CodeCompleteResultsHandle^		m_results;		// Cached completion results
+	int								m_line;			// Line of cached results
+	int								m_start;		// Column of cached results
+	String^							m_filter;		// Previous filter text
+	int								m_queries;		// Number of libclang queries
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __COMPLETIONSESSION_H_
@@ -29,8 +29,10 @@
 #include "CompletionString.h"
 #include "CursorCollection.h"
 #include "CursorComment.h"
+#include "CursorIdentityMap.h"
 #include "CursorKind.h"
 #include "CursorVisibility.h"
+#include "DescendantCursorEnumerable.h"
 #include "CxxAccessSpecifier.h"
 #include "EnumConstant.h"
 #include "EnumerateChildrenFunc.h"
@@ -51,6 +53,7 @@
 #include "OverloadedDeclarationCursorCollection.h"
 #include "OverriddenCursorCollection.h"
 #include "ParsedComment.h"
+#include "PerformanceCounters.h"
 #include "PlatformAvailabilityCollection.h"
 #include "ReferenceNameExtent.h"
 #include "StorageClass.h"
@@ -60,6 +63,8 @@
 #include "TokenCollection.h"
 #include "Type.h"
 #include "UnifiedSymbolResolution.h"
+#include "UnifiedSymbolResolutionInterner.h"
+#include "Utf8String.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -122,7 +127,7 @@ static Cursor::Cursor()
 //
 //	handle		- Underlying CursorHandle instance
 
-Cursor::Cursor(CursorHandle^ handle) : m_handle(handle)
+Cursor::Cursor(CursorHandle^ handle) : m_handle(handle), m_usrid(-1)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
 }
@@ -239,7 +244,23 @@ local::CompletionString^ Cursor::CompletionString::get(void)
 
 Cursor^ Cursor::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCursor cursor)
 {
-	return gcnew Cursor(gcnew CursorHandle(owner, transunit, cursor));
+	// Only cursors owned directly by the translation unit can be shared, cursors
+	// owned by another object (completion results, etc) must keep that owner alive
+	CursorIdentityMap^ map = (Object::ReferenceEquals(owner, transunit)) ? transunit->Cursors : nullptr;
+	if(Object::ReferenceEquals(map, nullptr)) {
+
+		PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Cursor);
+		return gcnew Cursor(gcnew CursorHandle(owner, transunit, cursor));
+	}
+
+	Cursor^ instance = map->Find(cursor);
+	if(Object::ReferenceEquals(instance, nullptr)) {
+
+		PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Cursor);
+		instance = map->Add(cursor, gcnew Cursor(gcnew CursorHandle(owner, transunit, cursor)));
+	}
+
+	return instance;
 }
 
 //---------------------------------------------------------------------------
@@ -278,6 +299,20 @@ Cursor^ Cursor::DefinitionCursor::get(void)
 	return m_definition;
 }
 
+//---------------------------------------------------------------------------
+// Cursor::Descendants
+//
+// Lazily enumerates the descendant cursors of this cursor in preorder
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Cursor^>^ Cursor::Descendants(void)
+{
+	return DescendantCursorEnumerable::Create(m_handle);
+}
+
 //---------------------------------------------------------------------------
 // Cursor::DisplayName::get
 //
@@ -545,6 +580,46 @@ ExtentCollection^ Cursor::GetSpellingNameExtents(void)
 	return ExtentCollection::Create(extents);
 }
 
+//---------------------------------------------------------------------------
+// Cursor::GetSpellingUtf8
+//
+// Gets the spelling of the entity pointed at by the cursor as raw UTF-8
+//
+// Arguments:
+//
+//	NONE
+
+Utf8String^ Cursor::GetSpellingUtf8(void)
+{
+	// This is a method not a property, the caller owns the returned object
+	return Utf8String::Create(clang_getCursorSpelling(CursorHandle::Reference(m_handle)));
+}
+
+//---------------------------------------------------------------------------
+// Cursor::GetUnifiedSymbolResolutionUtf8
+//
+// Gets the Unified Symbol Resolution (USR) string for the entity as raw UTF-8
+//
+// Arguments:
+//
+//	NONE
+
+Utf8String^ Cursor::GetUnifiedSymbolResolutionUtf8(void)
+{
+	// This is a method not a property, the caller owns the returned object
+	return Utf8String::Create(clang_getCursorUSR(CursorHandle::Reference(m_handle)));
+}
+
+//---------------------------------------------------------------------------
+// Cursor::Handle::get (internal)
+//
+// Exposes the underlying CursorHandle
+
+Cursor::CursorHandle^ Cursor::Handle::get(void)
+{
+	return m_handle;
+}
+
 //---------------------------------------------------------------------------
 // Cursor::HasAttributes::Get
 //
@@ -1174,6 +1249,21 @@ local::UnifiedSymbolResolution^ Cursor::UnifiedSymbolResolution::get(void)
 
 	return m_usr;
 }
+
+//---------------------------------------------------------------------------
+// Cursor::UnifiedSymbolResolutionId::get
+//
+// Gets the identifier assigned to the USR by UnifiedSymbolResolutionInterner::Default
+
+int Cursor::UnifiedSymbolResolutionId::get(void)
+{
+	// Intern directly from the CXString unless the USR has already been converted
+	if(m_usrid < 0) m_usrid = (Object::ReferenceEquals(m_usr, nullptr)) ? 
+		UnifiedSymbolResolutionInterner::Default->Intern(clang_getCursorUSR(CursorHandle::Reference(m_handle))) : 
+		UnifiedSymbolResolutionInterner::Default->GetId(m_usr);
+
+	return m_usrid;
+}
 	
 //---------------------------------------------------------------------------
 // Cursor::Visibility::get
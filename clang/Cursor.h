@@ -29,6 +29,7 @@
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
+using namespace System::Collections::Generic;
 
 namespace zuki::tools::llvm::clang {
 namespace local = zuki::tools::llvm::clang;
@@ -64,6 +65,7 @@ ref class	TemplateArgumentCollection;
 ref class	TokenCollection;
 ref class	Type;
 ref class	UnifiedSymbolResolution;
+ref class	Utf8String;
 
 //---------------------------------------------------------------------------
 // Class Cursor
@@ -89,6 +91,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// Descendants
+	//
+	// Lazily enumerates the descendant cursors of this cursor in preorder
+	IEnumerable<Cursor^>^ Descendants(void);
+
 	// EnumerateChildren
 	//
 	// Enumerates descendant cursors of this cursor
@@ -129,6 +136,16 @@ public:
 	// Creates a collection of extent that covers part of the spelling (Objective-C)
 	ExtentCollection^ GetSpellingNameExtents(void);
 
+	// GetSpellingUtf8
+	//
+	// Gets the spelling of the entity pointed at by the cursor as raw UTF-8
+	Utf8String^ GetSpellingUtf8(void);
+
+	// GetUnifiedSymbolResolutionUtf8
+	//
+	// Gets the Unified Symbol Resolution (USR) string for the entity as raw UTF-8
+	Utf8String^ GetUnifiedSymbolResolutionUtf8(void);
+
 	// IsNull (static)
 	//
 	// Determines if the specified cursor object is null
@@ -670,6 +687,14 @@ public:
 		local::UnifiedSymbolResolution^ get(void);
 	}
 
+	// UnifiedSymbolResolutionId
+	//
+	// Gets the identifier assigned to the USR by UnifiedSymbolResolutionInterner::Default
+	property int UnifiedSymbolResolutionId
+	{
+		int get(void);
+	}
+
 	// Visibility
 	//
 	// Gets the visibility of the entity referred to by a cursor
@@ -688,6 +713,11 @@ public:
 
 internal:
 
+	// CursorHandle
+	//
+	// TranslationUnitReferenceHandle specialization for CXCursor
+	using CursorHandle = TranslationUnitReferenceHandle<CXCursor>;
+
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
@@ -696,12 +726,18 @@ internal:
 	// Creates a new Cursor instance
 	static Cursor^ Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXCursor cursor);
 
-private:
+	//-----------------------------------------------------------------------
+	// Internal Properties
 
-	// CursorHandle
+	// Handle
 	//
-	// TranslationUnitReferenceHandle specialization for CXCursor
-	using CursorHandle = TranslationUnitReferenceHandle<CXCursor>;
+	// Exposes the underlying CursorHandle
+	property CursorHandle^ Handle
+	{
+		CursorHandle^ get(void);
+	}
+
+private:
 
 	// Instance Constructor
 	//
@@ -723,6 +759,7 @@ private:
 	String^								m_mangled;			// Cached mangled name
 	String^								m_spelling;			// Cached cursor spelling
 	local::UnifiedSymbolResolution^		m_usr;				// Cached cursor USR
+	int									m_usrid;			// Cached cursor USR identifier
 	String^								m_displayname;		// Cached display name
 	local::Type^						m_type;				// Cached cursor type
 	Cursor^								m_canonical;		// Cached canonical cursor
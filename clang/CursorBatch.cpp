@@ -0,0 +1,265 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CursorBatch.h"
+
+#include "Cursor.h"
+#include "CursorFields.h"
+#include "CursorKind.h"
+#include "CxxAccessSpecifier.h"
+#include "Linkage.h"
+#include "StringInterner.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CursorBatch Constructor (private)
+//
+// Arguments:
+//
+//	fields		- Fields to be extracted into the batch
+//	count		- Number of cursors in the batch
+
+CursorBatch::CursorBatch(CursorFields fields, int count) : m_fields(fields), m_count(count)
+{
+	// Only allocate the columns that have been requested by the caller
+	if((fields & CursorFields::Kind) == CursorFields::Kind) m_kinds = gcnew array<CursorKind>(count);
+	if((fields & CursorFields::Spelling) == CursorFields::Spelling) m_spellings = gcnew array<String^>(count);
+	if((fields & CursorFields::DisplayName) == CursorFields::DisplayName) m_displaynames = gcnew array<String^>(count);
+	if((fields & CursorFields::TypeSpelling) == CursorFields::TypeSpelling) m_typespellings = gcnew array<String^>(count);
+	if((fields & CursorFields::UnifiedSymbolResolution) == CursorFields::UnifiedSymbolResolution) m_usrs = gcnew array<String^>(count);
+	if((fields & CursorFields::Linkage) == CursorFields::Linkage) m_linkages = gcnew array<Linkage>(count);
+	if((fields & CursorFields::CxxAccessSpecifier) == CursorFields::CxxAccessSpecifier) m_access = gcnew array<CxxAccessSpecifier>(count);
+
+	if((fields & CursorFields::Extent) == CursorFields::Extent) {
+
+		m_extentfiles = gcnew array<String^>(count);
+		m_extentstarts = gcnew array<int>(count);
+		m_extentends = gcnew array<int>(count);
+	}
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Count::get
+//
+// Gets the number of cursors in the batch
+
+int CursorBatch::Count::get(void)
+{
+	return m_count;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::CxxAccessSpecifiers::get
+//
+// Gets the C++ access specifier of each cursor
+
+array<CxxAccessSpecifier>^ CursorBatch::CxxAccessSpecifiers::get(void)
+{
+	return m_access;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::DisplayNames::get
+//
+// Gets the display name of each cursor
+
+array<String^>^ CursorBatch::DisplayNames::get(void)
+{
+	return m_displaynames;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::ExtentEndOffsets::get
+//
+// Gets the file offset at which each cursor extent ends
+
+array<int>^ CursorBatch::ExtentEndOffsets::get(void)
+{
+	return m_extentends;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::ExtentFileNames::get
+//
+// Gets the name of the file in which each cursor extent starts
+
+array<String^>^ CursorBatch::ExtentFileNames::get(void)
+{
+	return m_extentfiles;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::ExtentStartOffsets::get
+//
+// Gets the file offset at which each cursor extent starts
+
+array<int>^ CursorBatch::ExtentStartOffsets::get(void)
+{
+	return m_extentstarts;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Extract (static)
+//
+// Extracts the requested properties from a list of cursors
+//
+// Arguments:
+//
+//	cursors		- List of cursors to be extracted
+//	fields		- Fields to be extracted from each cursor
+
+CursorBatch^ CursorBatch::Extract(IReadOnlyList<Cursor^>^ cursors, CursorFields fields)
+{
+	if(Object::ReferenceEquals(cursors, nullptr)) throw gcnew ArgumentNullException("cursors");
+
+	int count = cursors->Count;
+	CursorBatch^ batch = gcnew CursorBatch(fields, count);
+
+	// Strings are interned across the entire batch, file names are additionally
+	// cached against the unmanaged CXFile to avoid generating a CXString for each
+	StringInterner^ strings = gcnew StringInterner();
+	Dictionary<IntPtr, String^>^ filenames = gcnew Dictionary<IntPtr, String^>();
+
+	for(int index = 0; index < count; index++) {
+
+		Cursor^ item = cursors[index];
+		if(Object::ReferenceEquals(item, nullptr)) throw gcnew ArgumentNullException("cursors");
+
+		// Unwrap the cursor handle only once for all of the fields being extracted
+		Cursor::CursorHandle::Reference cursor(item->Handle);
+
+		if(!Object::ReferenceEquals(batch->m_kinds, nullptr)) 
+			batch->m_kinds[index] = CursorKind(clang_getCursorKind(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_spellings, nullptr)) 
+			batch->m_spellings[index] = strings->Intern(clang_getCursorSpelling(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_displaynames, nullptr)) 
+			batch->m_displaynames[index] = strings->Intern(clang_getCursorDisplayName(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_typespellings, nullptr)) 
+			batch->m_typespellings[index] = strings->Intern(clang_getTypeSpelling(clang_getCursorType(cursor)));
+
+		if(!Object::ReferenceEquals(batch->m_usrs, nullptr)) 
+			batch->m_usrs[index] = strings->Intern(clang_getCursorUSR(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_linkages, nullptr)) 
+			batch->m_linkages[index] = local::Linkage(clang_getCursorLinkage(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_access, nullptr)) 
+			batch->m_access[index] = local::CxxAccessSpecifier(clang_getCXXAccessSpecifier(cursor));
+
+		if(!Object::ReferenceEquals(batch->m_extentfiles, nullptr)) {
+
+			CXFile					startfile, endfile;			// CXFile instances
+			unsigned int			startoffset, endoffset;		// Location offsets
+			String^					filename;					// Cached file name
+
+			// Use the same start and end file locations that Cursor::Extent reports to the caller
+			CXSourceRange extent = clang_getCursorExtent(cursor);
+			clang_getFileLocation(clang_getRangeStart(extent), &startfile, __nullptr, __nullptr, &startoffset);
+			clang_getFileLocation(clang_getRangeEnd(extent), &endfile, __nullptr, __nullptr, &endoffset);
+
+			if(!filenames->TryGetValue(IntPtr(startfile), filename)) {
+
+				filename = strings->Intern(clang_getFileName(startfile));
+				filenames->Add(IntPtr(startfile), filename);
+			}
+
+			batch->m_extentfiles[index] = filename;
+			batch->m_extentstarts[index] = static_cast<int>(startoffset);
+			batch->m_extentends[index] = static_cast<int>(endoffset);
+		}
+	}
+
+	return batch;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Fields::get
+//
+// Gets the set of fields that were extracted
+
+CursorFields CursorBatch::Fields::get(void)
+{
+	return m_fields;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Kinds::get
+//
+// Gets the kind of each cursor
+
+array<CursorKind>^ CursorBatch::Kinds::get(void)
+{
+	return m_kinds;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Linkages::get
+//
+// Gets the linkage of each cursor
+
+array<Linkage>^ CursorBatch::Linkages::get(void)
+{
+	return m_linkages;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::Spellings::get
+//
+// Gets the spelling of each cursor
+
+array<String^>^ CursorBatch::Spellings::get(void)
+{
+	return m_spellings;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::TypeSpellings::get
+//
+// Gets the spelling of the type of each cursor
+
+array<String^>^ CursorBatch::TypeSpellings::get(void)
+{
+	return m_typespellings;
+}
+
+//---------------------------------------------------------------------------
+// CursorBatch::UnifiedSymbolResolutions::get
+//
+// Gets the Unified Symbol Resolution (USR) string of each cursor
+
+array<String^>^ CursorBatch::UnifiedSymbolResolutions::get(void)
+{
+	return m_usrs;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
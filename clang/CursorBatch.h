@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CURSORBATCH_H_
+#define __CURSORBATCH_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+namespace local = zuki::tools::llvm::clang;
+
+// FORWARD DECLARATIONS
+//
+ref class	Cursor;
+enum class	CursorFields;
+value class CursorKind;
+enum class	CxxAccessSpecifier;
+enum class	Linkage;
+
+//---------------------------------------------------------------------------
+// Class CursorBatch
+//
+// Columnar snapshot of the properties of a set of cursors.  Extraction is
+// performed in a single pass that unwraps each cursor handle only once, and
+// identical strings share a single System::String instance.  Columns that
+// were not requested via the CursorFields mask are null
+//---------------------------------------------------------------------------
+
+public ref class CursorBatch
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Extract (static)
+	//
+	// Extracts the requested properties from a list of cursors
+	static CursorBatch^ Extract(IReadOnlyList<Cursor^>^ cursors, CursorFields fields);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of cursors in the batch
+	property int Count
+	{
+		int get(void);
+	}
+
+	// CxxAccessSpecifiers
+	//
+	// Gets the C++ access specifier of each cursor
+	property array<CxxAccessSpecifier>^ CxxAccessSpecifiers
+	{
+		array<CxxAccessSpecifier>^ get(void);
+	}
+
+	// DisplayNames
+	//
+	// Gets the display name of each cursor
+	property array<String^>^ DisplayNames
+	{
+		array<String^>^ get(void);
+	}
+
+	// ExtentEndOffsets
+	//
+	// Gets the file offset at which each cursor extent ends
+	property array<int>^ ExtentEndOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// ExtentFileNames
+	//
+	// Gets the name of the file in which each cursor extent starts
+	property array<String^>^ ExtentFileNames
+	{
+		array<String^>^ get(void);
+	}
+
+	// ExtentStartOffsets
+	//
+	// Gets the file offset at which each cursor extent starts
+	property array<int>^ ExtentStartOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// Fields
+	//
+	// Gets the set of fields that were extracted
+	property CursorFields Fields
+	{
+		CursorFields get(void);
+	}
+
+	// Kinds
+	//
+	// Gets the kind of each cursor
+	property array<CursorKind>^ Kinds
+	{
+		array<CursorKind>^ get(void);
+	}
+
+	// Linkages
+	//
+	// Gets the linkage of each cursor
+	property array<Linkage>^ Linkages
+	{
+		array<Linkage>^ get(void);
+	}
+
+	// Spellings
+	//
+	// Gets the spelling of each cursor
+	property array<String^>^ Spellings
+	{
+		array<String^>^ get(void);
+	}
+
+	// TypeSpellings
+	//
+	// Gets the spelling of the type of each cursor
+	property array<String^>^ TypeSpellings
+	{
+		array<String^>^ get(void);
+	}
+
+	// UnifiedSymbolResolutions
+	//
+	// Gets the Unified Symbol Resolution (USR) string of each cursor
+	property array<String^>^ UnifiedSymbolResolutions
+	{
+		array<String^>^ get(void);
+	}
+
+private:
+
+	// Instance Constructor
+	//
+	CursorBatch(CursorFields fields, int count);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CursorFields					m_fields;			// Extracted fields
+	int								m_count;			// Number of cursors
+	array<CursorKind>^				m_kinds;			// Cursor kinds
+	array<String^>^					m_spellings;		// Cursor spellings
+	array<String^>^					m_displaynames;		// Cursor display names
+	array<String^>^					m_typespellings;	// Cursor type spellings
+	array<String^>^					m_usrs;				// Cursor USRs
+	array<Linkage>^					m_linkages;			// Cursor linkages
+	array<CxxAccessSpecifier>^		m_access;			// Cursor access specifiers
+	array<String^>^					m_extentfiles;		// Extent file names
+	array<int>^						m_extentstarts;		// Extent start offsets
+	array<int>^						m_extentends;		// Extent end offsets
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __CURSORBATCH_H_
@@ -0,0 +1,60 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CURSORFIELDS_H_
+#define __CURSORFIELDS_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Enum CursorFields
+//
+// Flags used to select the cursor properties extracted by CursorBatch
+//---------------------------------------------------------------------------
+
+[FlagsAttribute]
+public enum class CursorFields
+{
+	None						= 0x0000,
+	Kind						= 0x0001,
+	Spelling					= 0x0002,
+	DisplayName					= 0x0004,
+	TypeSpelling				= 0x0008,
+	UnifiedSymbolResolution		= 0x0010,
+	Linkage						= 0x0020,
+	CxxAccessSpecifier			= 0x0040,
+	Extent						= 0x0080,
+	All							= 0x00FF,
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __CURSORFIELDS_H_
@@ -0,0 +1,169 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CursorIdentityMap.h"
+
+#include "Cursor.h"
+
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap Constructor
+//
+// Arguments:
+//
+//	NONE
+
+CursorIdentityMap::CursorIdentityMap() : m_buckets(gcnew Dictionary<unsigned int, List<Cursor^>^>()), m_count(0)
+{
+}
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap::Add
+//
+// Adds a cursor instance to the map, returns the instance that was mapped
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor that the instance wraps
+//	instance	- Cursor instance to be shared
+
+Cursor^ CursorIdentityMap::Add(CXCursor cursor, Cursor^ instance)
+{
+	if(Object::ReferenceEquals(instance, nullptr)) throw gcnew ArgumentNullException("instance");
+
+	unsigned int hash = clang_hashCursor(cursor);
+
+	// Cursors for the same translation unit are routinely created from more than
+	// one thread at a time (visitors, completion prewarming, indexer callbacks)
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		List<Cursor^>^ bucket = nullptr;
+		if(!m_buckets->TryGetValue(hash, bucket)) {
+
+			bucket = gcnew List<Cursor^>(1);
+			m_buckets->Add(hash, bucket);
+		}
+
+		// If an equal cursor was mapped in the meantime, that instance wins
+		Cursor^ existing = Find(bucket, cursor);
+		if(!Object::ReferenceEquals(existing, nullptr)) return existing;
+
+		bucket->Add(instance);
+		m_count++;
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+
+	return instance;
+}
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap::Clear
+//
+// Removes all cursor instances from the map
+//
+// Arguments:
+//
+//	NONE
+
+void CursorIdentityMap::Clear(void)
+{
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		m_buckets->Clear();
+		m_count = 0;
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+}
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap::Count::get
+//
+// Gets the number of cursor instances held by the map
+
+int CursorIdentityMap::Count::get(void)
+{
+	return m_count;
+}
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap::Find
+//
+// Locates the shared instance for a cursor, or nullptr if not mapped
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor to locate
+
+Cursor^ CursorIdentityMap::Find(CXCursor cursor)
+{
+	unsigned int hash = clang_hashCursor(cursor);
+
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		List<Cursor^>^ bucket = nullptr;
+		if(!m_buckets->TryGetValue(hash, bucket)) return nullptr;
+
+		return Find(bucket, cursor);
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+}
+
+//---------------------------------------------------------------------------
+// CursorIdentityMap::Find (private, static)
+//
+// Locates a shared instance within a single hash bucket
+//
+// Arguments:
+//
+//	bucket		- Hash bucket to be searched
+//	cursor		- Unmanaged cursor to locate
+
+Cursor^ CursorIdentityMap::Find(List<Cursor^>^ bucket, CXCursor cursor)
+{
+	for each(Cursor^ instance in bucket) {
+
+		if(clang_equalCursors(cursor, Cursor::CursorHandle::Reference(instance->Handle)) != 0) return instance;
+	}
+
+	return nullptr;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CURSORIDENTITYMAP_H_
+#define __CURSORIDENTITYMAP_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	Cursor;
+
+//---------------------------------------------------------------------------
+// Class CursorIdentityMap (internal)
+//
+// Maps unmanaged cursors to a single shared Cursor instance so that equal
+// cursors retrieved through different paths share their cached properties.
+// Lookups are keyed by clang_hashCursor and verified with clang_equalCursors;
+// all access is synchronized as cursors can be created from multiple threads
+//---------------------------------------------------------------------------
+
+ref class CursorIdentityMap
+{
+public:
+
+	// Instance Constructor
+	//
+	CursorIdentityMap();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Add
+	//
+	// Adds a cursor instance to the map, returns the instance that was mapped
+	Cursor^ Add(CXCursor cursor, Cursor^ instance);
+
+	// Clear
+	//
+	// Removes all cursor instances from the map
+	void Clear(void);
+
+	// Find
+	//
+	// Locates the shared instance for a cursor, or nullptr if not mapped
+	Cursor^ Find(CXCursor cursor);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of cursor instances held by the map
+	property int Count
+	{
+		int get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Find
+	//
+	// Locates a shared instance within a single hash bucket
+	static Cursor^ Find(List<Cursor^>^ bucket, CXCursor cursor);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<unsigned int, List<Cursor^>^>^	m_buckets;	// Cursors by hash
+	int											m_count;	// Number of cursors
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __CURSORIDENTITYMAP_H_
@@ -0,0 +1,91 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DescendantCursorEnumerable.h"
+
+#include "Cursor.h"
+#include "DescendantCursorEnumerator.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerable Constructor (private)
+//
+// Arguments:
+//
+//	root		- Handle to the cursor whose descendants are enumerated
+
+DescendantCursorEnumerable::DescendantCursorEnumerable(CursorHandle^ root) : m_root(root)
+{
+	if(Object::ReferenceEquals(root, nullptr)) throw gcnew ArgumentNullException("root");
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerable::Create (internal, static)
+//
+// Creates a new DescendantCursorEnumerable instance
+//
+// Arguments:
+//
+//	root		- Handle to the cursor whose descendants are enumerated
+
+DescendantCursorEnumerable^ DescendantCursorEnumerable::Create(CursorHandle^ root)
+{
+	return gcnew DescendantCursorEnumerable(root);
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerable::GetEnumerator
+//
+// Returns a generic IEnumerator<T> for the descendant cursors
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerator<Cursor^>^ DescendantCursorEnumerable::GetEnumerator(void)
+{
+	return gcnew DescendantCursorEnumerator(m_root);
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerable::IEnumerable_GetEnumerator
+//
+// Returns a non-generic IEnumerator for the descendant cursors
+//
+// Arguments:
+//
+//	NONE
+
+System::Collections::IEnumerator^ DescendantCursorEnumerable::IEnumerable_GetEnumerator(void)
+{
+	return GetEnumerator();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
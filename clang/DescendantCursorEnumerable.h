@@ -0,0 +1,100 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DESCENDANTCURSORENUMERABLE_H_
+#define __DESCENDANTCURSORENUMERABLE_H_
+#pragma once
+
+#include "TranslationUnitReferenceHandle.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	Cursor;
+
+//---------------------------------------------------------------------------
+// Class DescendantCursorEnumerable (internal)
+//
+// Lazily evaluated preorder enumeration of the descendants of a cursor.  No
+// traversal takes place until the enumerator is advanced
+//---------------------------------------------------------------------------
+
+ref class DescendantCursorEnumerable : public IEnumerable<Cursor^>
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetEnumerator
+	//
+	// Returns a generic IEnumerator<T> for the descendant cursors
+	virtual IEnumerator<Cursor^>^ GetEnumerator(void);
+
+internal:
+
+	// CursorHandle
+	//
+	// TranslationUnitReferenceHandle specialization for CXCursor
+	using CursorHandle = TranslationUnitReferenceHandle<CXCursor>;
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create
+	//
+	// Creates a new DescendantCursorEnumerable instance
+	static DescendantCursorEnumerable^ Create(CursorHandle^ root);
+
+private:
+
+	// Instance Constructor
+	//
+	DescendantCursorEnumerable(CursorHandle^ root);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetEnumerator (IEnumerable)
+	//
+	// Returns a non-generic IEnumerator for the descendant cursors
+	virtual System::Collections::IEnumerator^ IEnumerable_GetEnumerator(void) sealed = System::Collections::IEnumerable::GetEnumerator;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CursorHandle^			m_root;				// Root cursor handle
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DESCENDANTCURSORENUMERABLE_H_
@@ -0,0 +1,237 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DescendantCursorEnumerator.h"
+
+#include "AutoGCHandle.h"
+#include "Cursor.h"
+#include "GCHandleRef.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// PushChildCallback (local)
+//
+// Callback for clang_visitChildren() that pushes each immediate child cursor
+// onto the enumerator traversal stack
+//
+// Arguments:
+//
+//	cursor			- Current unmanaged CXCursor instance being enumerated
+//	parent			- Parent CXCursor instance (unused)
+//	context			- Context pointer passed into clang_visitChildren
+
+static CXChildVisitResult PushChildCallback(CXCursor cursor, CXCursor parent, CXClientData context)
+{
+	UNREFERENCED_PARAMETER(parent);
+
+	GCHandleRef<DescendantCursorEnumerator^> enumerator(context);
+	return (enumerator->Push(cursor)) ? CXChildVisitResult::CXChildVisit_Continue : CXChildVisitResult::CXChildVisit_Break;
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator Constructor
+//
+// Arguments:
+//
+//	root		- Handle to the cursor whose descendants are enumerated
+
+DescendantCursorEnumerator::DescendantCursorEnumerator(CursorHandle^ root) : m_root(root), m_stack(__nullptr), m_capacity(0), m_count(0)
+{
+	if(Object::ReferenceEquals(root, nullptr)) throw gcnew ArgumentNullException("root");
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator Destructor
+
+DescendantCursorEnumerator::~DescendantCursorEnumerator()
+{
+	if(m_disposed) return;
+
+	m_current = nullptr;					// Release the current cursor
+	m_root = nullptr;						// Release the root cursor handle
+	this->!DescendantCursorEnumerator();	// Release the unmanaged memory
+	m_disposed = true;						// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator Finalizer
+
+DescendantCursorEnumerator::!DescendantCursorEnumerator()
+{
+	if(m_stack != __nullptr) delete[] m_stack;
+	m_stack = __nullptr;
+	m_capacity = m_count = 0;
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::Current::get
+//
+// Gets the current descendant cursor
+
+Cursor^ DescendantCursorEnumerator::Current::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(m_current, nullptr)) throw gcnew InvalidOperationException();
+	return m_current;
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::IEnumerator_Current::get
+//
+// Gets the current element in the collection as an untyped Object^
+
+Object^ DescendantCursorEnumerator::IEnumerator_Current::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return Current::get();
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::MoveNext
+//
+// Advances the enumerator to the next descendant cursor
+//
+// Arguments:
+//
+//	NONE
+
+bool DescendantCursorEnumerator::MoveNext(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	CursorHandle::Reference root(m_root);		// Keep the translation unit alive
+
+	// The children of a cursor are not visited until the enumerator advances past
+	// it; the current unmanaged cursor remains just above the top of the stack
+	if(!m_started) {
+
+		m_started = true;
+		if(!clang_Cursor_isNull(root)) PushChildren(root);
+	}
+
+	else if(!Object::ReferenceEquals(m_current, nullptr)) {
+
+		CXCursor current = m_stack[m_count];
+		PushChildren(current);
+	}
+
+	if(m_count == 0) { m_current = nullptr; return false; }
+
+	m_current = Cursor::Create(m_root->Owner, m_root->TranslationUnit, m_stack[--m_count]);
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::Push (internal)
+//
+// Pushes an unmanaged cursor onto the traversal stack
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor to be pushed onto the stack
+
+bool DescendantCursorEnumerator::Push(const CXCursor& cursor)
+{
+	// The slot above the top of the stack must always be available, see MoveNext
+	if((m_count + 1) >= m_capacity) {
+
+		size_t capacity = (m_capacity == 0) ? 64 : m_capacity * 2;
+		CXCursor* stack = __nullptr;
+
+		try { stack = new CXCursor[capacity]; }
+		catch(Exception^) { return false; }
+
+		if(m_stack != __nullptr) {
+
+			memcpy(stack, m_stack, m_capacity * sizeof(CXCursor));
+			delete[] m_stack;
+		}
+
+		m_stack = stack;
+		m_capacity = capacity;
+	}
+
+	m_stack[m_count++] = cursor;
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::PushChildren (private)
+//
+// Pushes the immediate children of a cursor onto the stack in reverse order
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor whose children should be pushed
+
+void DescendantCursorEnumerator::PushChildren(const CXCursor& cursor)
+{
+	size_t first = m_count;
+
+	// Only the immediate children are visited, recursion is driven by MoveNext
+	if(clang_visitChildren(cursor, PushChildCallback, AutoGCHandle(this)) != 0) {
+
+		m_count = first;
+		throw gcnew OutOfMemoryException();
+	}
+
+	// The children were pushed in document order, reverse them so that the
+	// first child is at the top of the stack and is popped first
+	size_t lo = first;
+	size_t hi = m_count;
+
+	while((hi - lo) > 1) {
+
+		CXCursor temp = m_stack[lo];
+		m_stack[lo++] = m_stack[--hi];
+		m_stack[hi] = temp;
+	}
+}
+
+//---------------------------------------------------------------------------
+// DescendantCursorEnumerator::Reset
+//
+// Sets the enumerator to its initial position
+//
+// Arguments:
+//
+//	NONE
+
+void DescendantCursorEnumerator::Reset(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	m_started = false;
+	m_current = nullptr;
+	m_count = 0;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
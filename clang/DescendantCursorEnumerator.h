@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DESCENDANTCURSORENUMERATOR_H_
+#define __DESCENDANTCURSORENUMERATOR_H_
+#pragma once
+
+#include "TranslationUnitReferenceHandle.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	Cursor;
+
+//---------------------------------------------------------------------------
+// Class DescendantCursorEnumerator (internal)
+//
+// Implements a pull-based preorder enumerator of descendant cursors.  Rather
+// than recursing with clang_visitChildren, the immediate children of a cursor
+// are pushed onto an unmanaged stack only when the enumerator advances past
+// it, so abandoning the enumeration abandons the rest of the traversal
+//---------------------------------------------------------------------------
+
+ref class DescendantCursorEnumerator : public IEnumerator<Cursor^>
+{
+public:
+
+	// CursorHandle
+	//
+	// TranslationUnitReferenceHandle specialization for CXCursor
+	using CursorHandle = TranslationUnitReferenceHandle<CXCursor>;
+
+	// Instance Constructor
+	//
+	DescendantCursorEnumerator(CursorHandle^ root);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// MoveNext
+	//
+	// Advances the enumerator to the next descendant cursor
+	virtual bool MoveNext(void);
+
+	// Reset
+	//
+	// Sets the enumerator to its initial position 
+	virtual void Reset(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Current
+	//
+	// Gets the current descendant cursor
+	property Cursor^ Current
+	{
+		virtual Cursor^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Push
+	//
+	// Pushes an unmanaged cursor onto the traversal stack
+	bool Push(const CXCursor& cursor);
+
+private:
+
+	// Destructor / Finalizer
+	//
+	~DescendantCursorEnumerator();
+	!DescendantCursorEnumerator();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// PushChildren
+	//
+	// Pushes the immediate children of a cursor onto the stack in reverse order
+	void PushChildren(const CXCursor& cursor);
+
+	//-----------------------------------------------------------------------
+	// Private Properties
+
+	// IEnumerator_Current (IEnumerator)
+	//
+	// Gets the current element in the collection as an untyped Object^
+	property Object^ IEnumerator_Current
+	{
+		virtual Object^ get(void) sealed = System::Collections::IEnumerator::Current::get;
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CursorHandle^			m_root;				// Root cursor handle
+	bool					m_disposed;			// Object disposal flag
+	bool					m_started;			// Flag if enumeration has started
+	Cursor^					m_current;			// Current Cursor instance
+	CXCursor*				m_stack;			// Unmanaged traversal stack
+	size_t					m_capacity;			// Traversal stack capacity
+	size_t					m_count;			// Traversal stack depth
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DESCENDANTCURSORENUMERATOR_H_
@@ -32,6 +32,7 @@
 #include "DiagnosticSeverity.h"
 #include "Location.h"
 #include "LocationKind.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
@@ -86,6 +87,7 @@ DiagnosticCollection^ Diagnostic::Children::get(void)
 
 Diagnostic^ Diagnostic::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXDiagnostic diagnostic)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Diagnostic);
 	return gcnew Diagnostic(gcnew DiagnosticHandle(owner, transunit, diagnostic));
 }
 
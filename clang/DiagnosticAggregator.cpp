@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DiagnosticAggregator.h"
+
+#include "AggregatedDiagnostic.h"
+#include "DiagnosticSeverity.h"
+#include "StringInterner.h"
+#include "StringUtil.h"
+#include "TranslationUnit.h"
+#include "TranslationUnitHandle.h"
+
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator Constructor
+//
+// Arguments:
+//
+//	NONE
+
+DiagnosticAggregator::DiagnosticAggregator() : m_occurrences(0), m_transunits(0)
+{
+	m_unique = gcnew Dictionary<Key, AggregatedDiagnostic^>();
+	m_ordered = gcnew List<AggregatedDiagnostic^>();
+	m_strings = gcnew StringInterner();
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::Add
+//
+// Adds the diagnostics of a translation unit to the aggregator
+//
+// Arguments:
+//
+//	transunit	- Translation unit whose diagnostics are to be aggregated
+
+int DiagnosticAggregator::Add(TranslationUnit^ transunit)
+{
+	AggregatedDiagnostic^		existing;			// Existing unique diagnostic
+	int							added = 0;			// Number of new diagnostics
+
+	if(Object::ReferenceEquals(transunit, nullptr)) throw gcnew ArgumentNullException("transunit");
+
+	TranslationUnitHandle::Reference handle(transunit->Handle);
+
+	// Generate the keys before acquiring the lock, this is the expensive part of the
+	// operation and can proceed in parallel when translation units are added concurrently
+	int count = static_cast<int>(clang_getNumDiagnostics(handle));
+	array<IntPtr>^ diagnostics = gcnew array<IntPtr>(count);
+	array<Key>^ keys = gcnew array<Key>(count);
+
+	for(int index = 0; index < count; index++) {
+
+		CXDiagnostic diagnostic = clang_getDiagnostic(handle, static_cast<unsigned int>(index));
+		diagnostics[index] = IntPtr(diagnostic);
+		keys[index] = GetKey(diagnostic);
+	}
+
+	Monitor::Enter(m_unique);
+
+	try {
+
+		for(int index = 0; index < count; index++) {
+
+			CXDiagnostic diagnostic = static_cast<CXDiagnostic>(diagnostics[index].ToPointer());
+
+			// Managed objects are only created for the first occurrence of each diagnostic
+			if(m_unique->TryGetValue(keys[index], existing)) existing->AddOccurrence(DiagnosticSeverity(clang_getDiagnosticSeverity(diagnostic)));
+			else {
+
+				AggregatedDiagnostic^ aggregated = AggregatedDiagnostic::Create(diagnostic, m_strings);
+				m_unique->Add(keys[index], aggregated);
+				m_ordered->Add(aggregated);
+				added++;
+			}
+		}
+
+		m_occurrences += count;
+		m_transunits++;
+	}
+
+	finally { Monitor::Exit(m_unique); }
+
+	return added;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::Count::get
+//
+// Gets the number of unique diagnostics
+
+int DiagnosticAggregator::Count::get(void)
+{
+	Monitor::Enter(m_unique);
+	try { return m_ordered->Count; }
+	finally { Monitor::Exit(m_unique); }
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::Diagnostics::get
+//
+// Gets a snapshot of the unique diagnostics in the order they were first reported
+
+ReadOnlyCollection<AggregatedDiagnostic^>^ DiagnosticAggregator::Diagnostics::get(void)
+{
+	Monitor::Enter(m_unique);
+	try { return gcnew ReadOnlyCollection<AggregatedDiagnostic^>(m_ordered->ToArray()); }
+	finally { Monitor::Exit(m_unique); }
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::GetKey (private, static)
+//
+// Generates the key that identifies an unmanaged diagnostic
+//
+// Arguments:
+//
+//	diagnostic	- Unmanaged diagnostic
+
+DiagnosticAggregator::Key DiagnosticAggregator::GetKey(CXDiagnostic diagnostic)
+{
+	CXFile					file;				// Location file
+	unsigned int			offset;				// Location offset
+	CXFileUniqueID			fileid;				// Unique file identifier
+	CXString				disableopt;			// Disable option string
+	Key						key;				// Generated key
+
+	// Use the same spelling location that Diagnostic::Location reports to the caller
+	clang_getSpellingLocation(clang_getDiagnosticLocation(diagnostic), &file, __nullptr, __nullptr, &offset);
+
+	// The unique file identifier is the same for every translation unit that includes the
+	// file, regardless of how the path used to include it was spelled
+	memset(&fileid, 0, sizeof(CXFileUniqueID));
+	if((file != __nullptr) && (clang_getFileUniqueID(file, &fileid) != 0)) memset(&fileid, 0, sizeof(CXFileUniqueID));
+
+	key.File0 = fileid.data[0];
+	key.File1 = fileid.data[1];
+	key.File2 = fileid.data[2];
+	key.Offset = static_cast<int>(offset);
+	key.Category = static_cast<int>(clang_getDiagnosticCategory(diagnostic));
+
+	// clang_getDiagnosticOption returns both strings, and they both have to be disposed of
+	key.Option = Hash(clang_getDiagnosticOption(diagnostic, &disableopt));
+	clang_disposeString(disableopt);
+
+	key.Spelling = Hash(clang_getDiagnosticSpelling(diagnostic));
+
+	return key;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::Hash (private, static)
+//
+// Generates a hash of a CXString and disposes of it
+//
+// Arguments:
+//
+//	string		- CXString rvalue reference
+
+UInt64 DiagnosticAggregator::Hash(CXString&& string)
+{
+	try {
+
+		const char* psz = clang_getCString(string);
+		return StringUtil::Hash(psz, (psz == __nullptr) ? 0 : strlen(psz));
+	}
+
+	finally { clang_disposeString(string); memset(&string, 0, sizeof(CXString)); }
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::OccurrenceCount::get
+//
+// Gets the total number of diagnostics that have been added
+
+int DiagnosticAggregator::OccurrenceCount::get(void)
+{
+	Monitor::Enter(m_unique);
+	try { return m_occurrences; }
+	finally { Monitor::Exit(m_unique); }
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticAggregator::TranslationUnitCount::get
+//
+// Gets the number of translation units that have been added
+
+int DiagnosticAggregator::TranslationUnitCount::get(void)
+{
+	Monitor::Enter(m_unique);
+	try { return m_transunits; }
+	finally { Monitor::Exit(m_unique); }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DIAGNOSTICAGGREGATOR_H_
+#define __DIAGNOSTICAGGREGATOR_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	AggregatedDiagnostic;
+ref class	StringInterner;
+ref class	TranslationUnit;
+
+//---------------------------------------------------------------------------
+// Class DiagnosticAggregator
+//
+// Collects the diagnostics of many translation units, counting each unique
+// diagnostic only once.  Diagnostics are identified by the unique identifier
+// of the file they are located in, their offset within that file, their
+// category, their enabling option and a hash of their text.  The key is
+// computed from the unmanaged diagnostic and managed objects are created
+// only for the first occurrence.  Translation units may be added from
+// multiple threads concurrently
+//---------------------------------------------------------------------------
+
+public ref class DiagnosticAggregator
+{
+public:
+
+	// Instance Constructor
+	//
+	DiagnosticAggregator();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Add
+	//
+	// Adds the diagnostics of a translation unit to the aggregator and returns
+	// the number of diagnostics that had not been previously reported
+	int Add(TranslationUnit^ transunit);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of unique diagnostics
+	property int Count
+	{
+		int get(void);
+	}
+
+	// Diagnostics
+	//
+	// Gets a snapshot of the unique diagnostics in the order they were first reported
+	property ReadOnlyCollection<AggregatedDiagnostic^>^ Diagnostics
+	{
+		ReadOnlyCollection<AggregatedDiagnostic^>^ get(void);
+	}
+
+	// OccurrenceCount
+	//
+	// Gets the total number of diagnostics that have been added
+	property int OccurrenceCount
+	{
+		int get(void);
+	}
+
+	// TranslationUnitCount
+	//
+	// Gets the number of translation units that have been added
+	property int TranslationUnitCount
+	{
+		int get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Value Class Key
+	//
+	// Identifies a unique diagnostic
+	value class Key : public IEquatable<Key>
+	{
+	public:
+
+		// Equals
+		//
+		// Compares this key to another key
+		virtual bool Equals(Key rhs)
+		{
+			return (File0 == rhs.File0) && (File1 == rhs.File1) && (File2 == rhs.File2) && (Offset == rhs.Offset) &&
+				(Category == rhs.Category) && (Option == rhs.Option) && (Spelling == rhs.Spelling);
+		}
+
+		// GetHashCode
+		//
+		// Overrides Object::GetHashCode()
+		virtual int GetHashCode(void) override
+		{
+			return (File0 ^ File1 ^ File2 ^ Option ^ Spelling ^ (static_cast<UInt64>(Category) << 32) ^ static_cast<UInt64>(Offset)).GetHashCode();
+		}
+
+		// Fields
+		//
+		UInt64		File0;			// File unique identifier
+		UInt64		File1;			// File unique identifier
+		UInt64		File2;			// File unique identifier
+		int			Offset;			// Location file offset
+		int			Category;		// Category number
+		UInt64		Option;			// Enable option hash
+		UInt64		Spelling;		// Spelling hash
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetKey (static)
+	//
+	// Generates the key that identifies an unmanaged diagnostic
+	static Key GetKey(CXDiagnostic diagnostic);
+
+	// Hash (static)
+	//
+	// Generates a hash of a CXString and disposes of it
+	static UInt64 Hash(CXString&& string);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<Key, AggregatedDiagnostic^>^	m_unique;		// Unique diagnostics
+	List<AggregatedDiagnostic^>^			m_ordered;		// Diagnostics in order
+	StringInterner^							m_strings;		// Shared strings
+	int										m_occurrences;	// Total occurrences
+	int										m_transunits;	// Translation units
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DIAGNOSTICAGGREGATOR_H_
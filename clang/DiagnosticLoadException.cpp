@@ -56,6 +56,18 @@ DiagnosticLoadException::DiagnosticLoadException(DiagnosticLoadErrorCode code, C
 {
 }
 
+//---------------------------------------------------------------------------
+// DiagnosticLoadException Constructor (internal)
+//
+// Arguments:
+//
+//	code		- The load error code
+//	message		- The load error message
+
+DiagnosticLoadException::DiagnosticLoadException(DiagnosticLoadErrorCode code, String^ message) : m_code(code), Exception(message)
+{
+}
+
 //---------------------------------------------------------------------------
 // DiagnosticLoadException Constructor (private)
 //
@@ -77,6 +77,7 @@ internal:
 	//
 	DiagnosticLoadException(CXLoadDiag_Error code, CXString&& message);
 	DiagnosticLoadException(DiagnosticLoadErrorCode code, CXString&& message);
+	DiagnosticLoadException(DiagnosticLoadErrorCode code, String^ message);
 
 private:
 
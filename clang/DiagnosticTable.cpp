@@ -0,0 +1,441 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DiagnosticTable.h"
+
+#include "DiagnosticFields.h"
+#include "DiagnosticSeverity.h"
+#include "StringInterner.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// DiagnosticTable Constructor (private)
+//
+// Arguments:
+//
+//	fields			- Fields to be extracted into the table
+//	parents			- Parent row index of each diagnostic
+//	fixitoffsets	- Index of the first fix-it of each diagnostic, or nullptr
+
+DiagnosticTable::DiagnosticTable(DiagnosticFields fields, array<int>^ parents, array<int>^ fixitoffsets) : 
+	m_fields(fields), m_parents(parents), m_fixitoffsets(fixitoffsets)
+{
+	if(Object::ReferenceEquals(parents, nullptr)) throw gcnew ArgumentNullException("parents");
+
+	int count = parents->Length;
+
+	// Only allocate the columns that have been requested by the caller
+	if((fields & DiagnosticFields::Severity) == DiagnosticFields::Severity) m_severities = gcnew array<DiagnosticSeverity>(count);
+	if((fields & DiagnosticFields::Spelling) == DiagnosticFields::Spelling) m_spellings = gcnew array<String^>(count);
+
+	if((fields & DiagnosticFields::Location) == DiagnosticFields::Location) {
+
+		m_fileids = gcnew array<int>(count);
+		m_lines = gcnew array<int>(count);
+		m_columns = gcnew array<int>(count);
+		m_offsets = gcnew array<int>(count);
+	}
+
+	if((fields & DiagnosticFields::Category) == DiagnosticFields::Category) {
+
+		m_categories = gcnew array<int>(count);
+		m_categorytexts = gcnew array<String^>(count);
+	}
+
+	if((fields & DiagnosticFields::Options) == DiagnosticFields::Options) {
+
+		m_enableopts = gcnew array<String^>(count);
+		m_disableopts = gcnew array<String^>(count);
+	}
+
+	if(!Object::ReferenceEquals(fixitoffsets, nullptr)) {
+
+		int fixits = fixitoffsets[count];
+
+		m_fixitfiles = gcnew array<int>(fixits);
+		m_fixitstarts = gcnew array<int>(fixits);
+		m_fixitends = gcnew array<int>(fixits);
+		m_fixittexts = gcnew array<String^>(fixits);
+	}
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::AppendDiagnostic (private, static)
+//
+// Appends a diagnostic and optionally its children to the flattened list
+//
+// Arguments:
+//
+//	diagnostic		- Diagnostic to be appended
+//	parent			- Row index of the parent diagnostic, or -1
+//	children		- Flag to append the child diagnostics as well
+//	diagnostics		- Flattened list of diagnostics
+//	parents			- Parent row index of each diagnostic
+
+void DiagnosticTable::AppendDiagnostic(CXDiagnostic diagnostic, int parent, bool children, List<IntPtr>^ diagnostics, List<int>^ parents)
+{
+	int row = diagnostics->Count;
+
+	diagnostics->Add(IntPtr(diagnostic));
+	parents->Add(parent);
+
+	if(!children) return;
+
+	// Child diagnostics are owned by the parent diagnostic set and immediately follow their parent
+	CXDiagnosticSet set = clang_getChildDiagnostics(diagnostic);
+	if(set == __nullptr) return;
+
+	unsigned int numchildren = clang_getNumDiagnosticsInSet(set);
+	for(unsigned int index = 0; index < numchildren; index++)
+		AppendDiagnostic(clang_getDiagnosticInSet(set, index), row, children, diagnostics, parents);
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::CategoryNumbers::get
+//
+// Gets the category number of each diagnostic
+
+array<int>^ DiagnosticTable::CategoryNumbers::get(void)
+{
+	return m_categories;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::CategoryTexts::get
+//
+// Gets the category text of each diagnostic
+
+array<String^>^ DiagnosticTable::CategoryTexts::get(void)
+{
+	return m_categorytexts;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Columns::get
+//
+// Gets the column number of the location of each diagnostic
+
+array<int>^ DiagnosticTable::Columns::get(void)
+{
+	return m_columns;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Count::get
+//
+// Gets the number of diagnostics in the table
+
+int DiagnosticTable::Count::get(void)
+{
+	return m_parents->Length;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::DisableOptions::get
+//
+// Gets the command line option that disables each diagnostic
+
+array<String^>^ DiagnosticTable::DisableOptions::get(void)
+{
+	return m_disableopts;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::EnableOptions::get
+//
+// Gets the command line option that enables each diagnostic
+
+array<String^>^ DiagnosticTable::EnableOptions::get(void)
+{
+	return m_enableopts;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Extract (internal, static)
+//
+// Extracts the requested properties of the diagnostics of a translation unit
+//
+// Arguments:
+//
+//	transunit	- Translation unit from which to extract the diagnostics
+//	fields		- Fields to be extracted from each diagnostic
+
+DiagnosticTable^ DiagnosticTable::Extract(CXTranslationUnit transunit, DiagnosticFields fields)
+{
+	bool children = ((fields & DiagnosticFields::Children) == DiagnosticFields::Children);
+	bool fixits = ((fields & DiagnosticFields::FixIts) == DiagnosticFields::FixIts);
+
+	// Flatten the diagnostic tree first so that every column can be allocated up front
+	unsigned int numdiagnostics = clang_getNumDiagnostics(transunit);
+	List<IntPtr>^ diagnostics = gcnew List<IntPtr>(static_cast<int>(numdiagnostics));
+	List<int>^ parents = gcnew List<int>(static_cast<int>(numdiagnostics));
+
+	for(unsigned int index = 0; index < numdiagnostics; index++)
+		AppendDiagnostic(clang_getDiagnostic(transunit, index), -1, children, diagnostics, parents);
+
+	int count = diagnostics->Count;
+
+	// Fix-its are stored in their own set of columns, indexed by the offset of each diagnostic's first fix-it
+	array<int>^ fixitoffsets = nullptr;
+	if(fixits) {
+
+		fixitoffsets = gcnew array<int>(count + 1);
+		for(int index = 0; index < count; index++) 
+			fixitoffsets[index + 1] = fixitoffsets[index] + static_cast<int>(clang_getDiagnosticNumFixIts(static_cast<CXDiagnostic>(diagnostics[index].ToPointer())));
+	}
+
+	DiagnosticTable^ table = gcnew DiagnosticTable(fields, parents->ToArray(), fixitoffsets);
+
+	// Strings are interned across the entire table, file names are additionally
+	// cached against the unmanaged CXFile to avoid generating a CXString for each
+	StringInterner^ strings = gcnew StringInterner();
+	Dictionary<IntPtr, int>^ fileids = gcnew Dictionary<IntPtr, int>();
+	List<String^>^ filenames = gcnew List<String^>();
+
+	for(int index = 0; index < count; index++) {
+
+		CXDiagnostic diagnostic = static_cast<CXDiagnostic>(diagnostics[index].ToPointer());
+
+		if(!Object::ReferenceEquals(table->m_severities, nullptr)) 
+			table->m_severities[index] = DiagnosticSeverity(clang_getDiagnosticSeverity(diagnostic));
+
+		if(!Object::ReferenceEquals(table->m_spellings, nullptr)) 
+			table->m_spellings[index] = strings->Intern(clang_getDiagnosticSpelling(diagnostic));
+
+		if(!Object::ReferenceEquals(table->m_fileids, nullptr)) {
+
+			CXFile					file;					// Location file
+			unsigned int			line, column, offset;	// Location information
+
+			// Use the same spelling location that Diagnostic::Location reports to the caller
+			clang_getSpellingLocation(clang_getDiagnosticLocation(diagnostic), &file, &line, &column, &offset);
+
+			table->m_fileids[index] = GetFileId(file, fileids, filenames, strings);
+			table->m_lines[index] = static_cast<int>(line);
+			table->m_columns[index] = static_cast<int>(column);
+			table->m_offsets[index] = static_cast<int>(offset);
+		}
+
+		if(!Object::ReferenceEquals(table->m_categories, nullptr)) {
+
+			table->m_categories[index] = static_cast<int>(clang_getDiagnosticCategory(diagnostic));
+			table->m_categorytexts[index] = strings->Intern(clang_getDiagnosticCategoryText(diagnostic));
+		}
+
+		if(!Object::ReferenceEquals(table->m_enableopts, nullptr)) {
+
+			CXString			disableopt;				// Disable option string
+
+			// clang_getDiagnosticOption returns both strings, and they both have to be disposed of
+			table->m_enableopts[index] = strings->Intern(clang_getDiagnosticOption(diagnostic, &disableopt));
+			table->m_disableopts[index] = strings->Intern(std::move(disableopt));
+		}
+
+		if(fixits) {
+
+			for(int fixit = fixitoffsets[index]; fixit < fixitoffsets[index + 1]; fixit++) {
+
+				CXSourceRange			extent;					// Fix-it extent
+				CXFile					startfile;				// Fix-it file
+				unsigned int			startoffset, endoffset;	// Fix-it offsets
+
+				table->m_fixittexts[fixit] = strings->Intern(clang_getDiagnosticFixIt(diagnostic, static_cast<unsigned int>(fixit - fixitoffsets[index]), &extent));
+
+				clang_getSpellingLocation(clang_getRangeStart(extent), &startfile, __nullptr, __nullptr, &startoffset);
+				clang_getSpellingLocation(clang_getRangeEnd(extent), __nullptr, __nullptr, __nullptr, &endoffset);
+
+				table->m_fixitfiles[fixit] = GetFileId(startfile, fileids, filenames, strings);
+				table->m_fixitstarts[fixit] = static_cast<int>(startoffset);
+				table->m_fixitends[fixit] = static_cast<int>(endoffset);
+			}
+		}
+	}
+
+	table->m_filenames = filenames->ToArray();
+	return table;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Fields::get
+//
+// Gets the set of fields that were extracted
+
+DiagnosticFields DiagnosticTable::Fields::get(void)
+{
+	return m_fields;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FileIds::get
+//
+// Gets the index into FileNames of the file in which each diagnostic is located
+
+array<int>^ DiagnosticTable::FileIds::get(void)
+{
+	return m_fileids;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FileNames::get
+//
+// Gets the names of the files referred to by the table
+
+array<String^>^ DiagnosticTable::FileNames::get(void)
+{
+	return m_filenames;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FixItEndOffsets::get
+//
+// Gets the file offset at which the extent of each fix-it ends
+
+array<int>^ DiagnosticTable::FixItEndOffsets::get(void)
+{
+	return m_fixitends;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FixItFileIds::get
+//
+// Gets the index into FileNames of the file each fix-it applies to
+
+array<int>^ DiagnosticTable::FixItFileIds::get(void)
+{
+	return m_fixitfiles;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FixItOffsets::get
+//
+// Gets the index of the first fix-it of each diagnostic
+
+array<int>^ DiagnosticTable::FixItOffsets::get(void)
+{
+	return m_fixitoffsets;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FixItReplacements::get
+//
+// Gets the replacement text of each fix-it
+
+array<String^>^ DiagnosticTable::FixItReplacements::get(void)
+{
+	return m_fixittexts;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::FixItStartOffsets::get
+//
+// Gets the file offset at which the extent of each fix-it starts
+
+array<int>^ DiagnosticTable::FixItStartOffsets::get(void)
+{
+	return m_fixitstarts;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::GetFileId (private, static)
+//
+// Gets the index of a file in the file name list, adding it if necessary
+//
+// Arguments:
+//
+//	file		- Unmanaged CXFile instance
+//	fileids		- Existing file indices keyed on the CXFile
+//	filenames	- List of file names
+//	strings		- String interner for the file names
+
+int DiagnosticTable::GetFileId(CXFile file, Dictionary<IntPtr, int>^ fileids, List<String^>^ filenames, StringInterner^ strings)
+{
+	int					fileid;				// Existing file index
+
+	if(file == __nullptr) return -1;
+	if(fileids->TryGetValue(IntPtr(file), fileid)) return fileid;
+
+	fileid = filenames->Count;
+	filenames->Add(strings->Intern(clang_getFileName(file)));
+	fileids->Add(IntPtr(file), fileid);
+
+	return fileid;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Lines::get
+//
+// Gets the line number of the location of each diagnostic
+
+array<int>^ DiagnosticTable::Lines::get(void)
+{
+	return m_lines;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Offsets::get
+//
+// Gets the file offset of the location of each diagnostic
+
+array<int>^ DiagnosticTable::Offsets::get(void)
+{
+	return m_offsets;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::ParentIndices::get
+//
+// Gets the row index of the parent of each diagnostic
+
+array<int>^ DiagnosticTable::ParentIndices::get(void)
+{
+	return m_parents;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Severities::get
+//
+// Gets the severity of each diagnostic
+
+array<DiagnosticSeverity>^ DiagnosticTable::Severities::get(void)
+{
+	return m_severities;
+}
+
+//---------------------------------------------------------------------------
+// DiagnosticTable::Spellings::get
+//
+// Gets the text of each diagnostic
+
+array<String^>^ DiagnosticTable::Spellings::get(void)
+{
+	return m_spellings;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
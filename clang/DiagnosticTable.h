@@ -0,0 +1,272 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DIAGNOSTICTABLE_H_
+#define __DIAGNOSTICTABLE_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+enum class	DiagnosticFields;
+enum class	DiagnosticSeverity;
+ref class	StringInterner;
+
+//---------------------------------------------------------------------------
+// Class DiagnosticTable
+//
+// Columnar snapshot of the diagnostics generated for a translation unit.
+// Each row describes one diagnostic; child diagnostics immediately follow
+// their parent and refer back to it by row index.  Source files are listed
+// once in FileNames and referred to by index, and identical strings share a
+// single System::String instance.  Columns that were not requested via the
+// DiagnosticFields mask are null
+//---------------------------------------------------------------------------
+
+public ref class DiagnosticTable
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CategoryNumbers
+	//
+	// Gets the category number of each diagnostic
+	property array<int>^ CategoryNumbers
+	{
+		array<int>^ get(void);
+	}
+
+	// CategoryTexts
+	//
+	// Gets the category text of each diagnostic
+	property array<String^>^ CategoryTexts
+	{
+		array<String^>^ get(void);
+	}
+
+	// Columns
+	//
+	// Gets the column number of the location of each diagnostic
+	property array<int>^ Columns
+	{
+		array<int>^ get(void);
+	}
+
+	// Count
+	//
+	// Gets the number of diagnostics in the table
+	property int Count
+	{
+		int get(void);
+	}
+
+	// DisableOptions
+	//
+	// Gets the command line option that disables each diagnostic
+	property array<String^>^ DisableOptions
+	{
+		array<String^>^ get(void);
+	}
+
+	// EnableOptions
+	//
+	// Gets the command line option that enables each diagnostic
+	property array<String^>^ EnableOptions
+	{
+		array<String^>^ get(void);
+	}
+
+	// Fields
+	//
+	// Gets the set of fields that were extracted
+	property DiagnosticFields Fields
+	{
+		DiagnosticFields get(void);
+	}
+
+	// FileIds
+	//
+	// Gets the index into FileNames of the file in which each diagnostic is
+	// located, or -1 if the diagnostic has no associated file
+	property array<int>^ FileIds
+	{
+		array<int>^ get(void);
+	}
+
+	// FileNames
+	//
+	// Gets the names of the files referred to by the table
+	property array<String^>^ FileNames
+	{
+		array<String^>^ get(void);
+	}
+
+	// FixItEndOffsets
+	//
+	// Gets the file offset at which the extent of each fix-it ends
+	property array<int>^ FixItEndOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// FixItFileIds
+	//
+	// Gets the index into FileNames of the file each fix-it applies to
+	property array<int>^ FixItFileIds
+	{
+		array<int>^ get(void);
+	}
+
+	// FixItOffsets
+	//
+	// Gets the index of the first fix-it of each diagnostic; the array has
+	// one more element than there are diagnostics so that the fix-its of
+	// diagnostic N are always in the range [FixItOffsets[N], FixItOffsets[N + 1])
+	property array<int>^ FixItOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// FixItReplacements
+	//
+	// Gets the replacement text of each fix-it
+	property array<String^>^ FixItReplacements
+	{
+		array<String^>^ get(void);
+	}
+
+	// FixItStartOffsets
+	//
+	// Gets the file offset at which the extent of each fix-it starts
+	property array<int>^ FixItStartOffsets
+	{
+		array<int>^ get(void);
+	}
+
+	// Lines
+	//
+	// Gets the line number of the location of each diagnostic
+	property array<int>^ Lines
+	{
+		array<int>^ get(void);
+	}
+
+	// Offsets
+	//
+	// Gets the file offset of the location of each diagnostic
+	property array<int>^ Offsets
+	{
+		array<int>^ get(void);
+	}
+
+	// ParentIndices
+	//
+	// Gets the row index of the parent of each diagnostic, or -1 for the
+	// top-level diagnostics of the translation unit
+	property array<int>^ ParentIndices
+	{
+		array<int>^ get(void);
+	}
+
+	// Severities
+	//
+	// Gets the severity of each diagnostic
+	property array<DiagnosticSeverity>^ Severities
+	{
+		array<DiagnosticSeverity>^ get(void);
+	}
+
+	// Spellings
+	//
+	// Gets the text of each diagnostic
+	property array<String^>^ Spellings
+	{
+		array<String^>^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Extract (static)
+	//
+	// Extracts the requested properties of the diagnostics of a translation unit
+	static DiagnosticTable^ Extract(CXTranslationUnit transunit, DiagnosticFields fields);
+
+private:
+
+	// Instance Constructor
+	//
+	DiagnosticTable(DiagnosticFields fields, array<int>^ parents, array<int>^ fixitoffsets);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AppendDiagnostic (static)
+	//
+	// Appends a diagnostic and optionally its children to the flattened list
+	static void AppendDiagnostic(CXDiagnostic diagnostic, int parent, bool children, List<IntPtr>^ diagnostics, List<int>^ parents);
+
+	// GetFileId (static)
+	//
+	// Gets the index of a file in the file name list, adding it if necessary
+	static int GetFileId(CXFile file, Dictionary<IntPtr, int>^ fileids, List<String^>^ filenames, StringInterner^ strings);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	DiagnosticFields				m_fields;			// Extracted fields
+	array<int>^						m_parents;			// Parent row indices
+	array<DiagnosticSeverity>^		m_severities;		// Diagnostic severities
+	array<int>^						m_fileids;			// Location file indices
+	array<int>^						m_lines;			// Location line numbers
+	array<int>^						m_columns;			// Location column numbers
+	array<int>^						m_offsets;			// Location file offsets
+	array<String^>^					m_spellings;		// Diagnostic spellings
+	array<int>^						m_categories;		// Category numbers
+	array<String^>^					m_categorytexts;	// Category texts
+	array<String^>^					m_enableopts;		// Enable options
+	array<String^>^					m_disableopts;		// Disable options
+	array<int>^						m_fixitoffsets;		// First fix-it of each diagnostic
+	array<int>^						m_fixitfiles;		// Fix-it file indices
+	array<int>^						m_fixitstarts;		// Fix-it start offsets
+	array<int>^						m_fixitends;		// Fix-it end offsets
+	array<String^>^					m_fixittexts;		// Fix-it replacement texts
+	array<String^>^					m_filenames;		// Referenced file names
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DIAGNOSTICTABLE_H_
@@ -0,0 +1,469 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "DocumentationExtractor.h"
+
+#include "AutoGCHandle.h"
+#include "CompilationDatabase.h"
+#include "CompileCommand.h"
+#include "CompileCommandCollection.h"
+#include "CursorKind.h"
+#include "DocumentationRecord.h"
+#include "GCHandleRef.h"
+#include "Index.h"
+#include "StringUtil.h"
+#include "TranslationUnit.h"
+#include "TranslationUnitHandle.h"
+#include "TranslationUnitParseOptions.h"
+
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// VisitCallback (local)
+//
+// Callback for clang_visitChildren() that visits each cursor of a translation unit
+//
+// Arguments:
+//
+//	cursor			- Current unmanaged CXCursor instance being enumerated
+//	parent			- Parent CXCursor instance (unused)
+//	context			- Context pointer passed into clang_visitChildren
+
+static CXChildVisitResult VisitCallback(CXCursor cursor, CXCursor parent, CXClientData context)
+{
+	UNREFERENCED_PARAMETER(parent);
+
+	GCHandleRef<DocumentationExtractor::Visitor^> visitor(context);
+	return visitor->Visit(cursor);
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor Constructor
+//
+// Arguments:
+//
+//	sink		- Delegate to invoke for each extracted documentation record
+
+DocumentationExtractor::DocumentationExtractor(Action<DocumentationRecord^>^ sink) : m_sink(sink), m_sinklock(gcnew Object()),
+	m_files(gcnew Dictionary<unsigned __int64, Visitor^>()), m_symbols(gcnew HashSet<String^>()), m_records(0)
+{
+	if(Object::ReferenceEquals(sink, nullptr)) throw gcnew ArgumentNullException("sink");
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::AppendText (private, static)
+//
+// Appends the text of a comment node and its children
+//
+// Arguments:
+//
+//	comment		- Comment node to be appended
+//	builder		- StringBuilder to receive the text
+
+void DocumentationExtractor::AppendText(CXComment comment, StringBuilder^ builder)
+{
+	switch(clang_Comment_getKind(comment)) {
+
+		case CXCommentKind::CXComment_Text:
+			builder->Append(StringUtil::ToString(clang_TextComment_getText(comment)));
+			break;
+
+		// Inline commands (\c, \p, etc) are reduced to their arguments
+		case CXCommentKind::CXComment_InlineCommand:
+			for(unsigned int index = 0; index < clang_InlineCommandComment_getNumArgs(comment); index++)
+				builder->Append(L' ')->Append(StringUtil::ToString(clang_InlineCommandComment_getArgText(comment, index)));
+			break;
+
+		case CXCommentKind::CXComment_VerbatimBlockLine:
+			builder->Append(L' ')->Append(StringUtil::ToString(clang_VerbatimBlockLineComment_getText(comment)));
+			break;
+
+		case CXCommentKind::CXComment_VerbatimLine:
+			builder->Append(L' ')->Append(StringUtil::ToString(clang_VerbatimLineComment_getText(comment)));
+			break;
+
+		// HTML tags are not part of the text
+		case CXCommentKind::CXComment_HTMLStartTag:
+		case CXCommentKind::CXComment_HTMLEndTag:
+			break;
+
+		default:
+			for(unsigned int index = 0; index < clang_Comment_getNumChildren(comment); index++)
+				AppendText(clang_Comment_getChild(comment, index), builder);
+			break;
+	}
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::ClaimFile (private)
+//
+// Claims a source file on behalf of a visitor
+//
+// Arguments:
+//
+//	file		- Unmanaged file to be claimed
+//	visitor		- Visitor claiming the file
+
+bool DocumentationExtractor::ClaimFile(CXFile file, Visitor^ visitor)
+{
+	CXFileUniqueID			uniqueid;			// Unique file identifier
+	unsigned __int64		key;				// Hash of the file identifier
+	Visitor^				owner;				// Visitor that owns the file
+
+	// The unique identifier includes the modification time, so a header that changes between
+	// units is processed again; fall back to the file name if the identifier isn't available
+	if(clang_getFileUniqueID(file, &uniqueid) == 0) key = StringUtil::Hash(reinterpret_cast<const char*>(&uniqueid), sizeof(CXFileUniqueID));
+	else {
+
+		CXString filename = clang_getFileName(file);
+		const char* pszfilename = clang_getCString(filename);
+
+		try { key = (pszfilename == __nullptr) ? 0 : StringUtil::Hash(pszfilename, strlen(pszfilename)); }
+		finally { clang_disposeString(filename); }
+	}
+
+	Monitor::Enter(m_files);
+
+	try {
+
+		if(m_files->TryGetValue(key, owner)) return Object::ReferenceEquals(owner, visitor);
+
+		m_files->Add(key, visitor);
+		return true;
+	}
+
+	finally { Monitor::Exit(m_files); }
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::ClaimSymbol (private)
+//
+// Claims a USR, returns false if it has already been reported
+//
+// Arguments:
+//
+//	usr			- USR to be claimed
+
+bool DocumentationExtractor::ClaimSymbol(String^ usr)
+{
+	// Declarations without a USR cannot be matched across units
+	if(String::IsNullOrEmpty(usr)) return true;
+
+	Monitor::Enter(m_symbols);
+
+	try { return m_symbols->Add(usr); }
+	finally { Monitor::Exit(m_symbols); }
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Emit (private)
+//
+// Sends a record to the sink
+//
+// Arguments:
+//
+//	record		- Record to be sent to the sink
+
+void DocumentationExtractor::Emit(DocumentationRecord^ record)
+{
+	Monitor::Enter(m_sinklock);
+
+	try {
+
+		m_sink(record);
+		m_records++;
+	}
+
+	finally { Monitor::Exit(m_sinklock); }
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Extract
+//
+// Extracts the documentation comments from a set of translation units
+//
+// Arguments:
+//
+//	transunits		- Translation units to be extracted
+
+void DocumentationExtractor::Extract(IEnumerable<TranslationUnit^>^ transunits)
+{
+	Extract(transunits, -1);
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Extract
+//
+// Extracts the documentation comments from a set of translation units
+//
+// Arguments:
+//
+//	transunits		- Translation units to be extracted
+//	maxParallelism	- Maximum number of translation units to extract concurrently, or -1
+
+void DocumentationExtractor::Extract(IEnumerable<TranslationUnit^>^ transunits, int maxParallelism)
+{
+	if(Object::ReferenceEquals(transunits, nullptr)) throw gcnew ArgumentNullException("transunits");
+	if((maxParallelism == 0) || (maxParallelism < -1)) throw gcnew ArgumentOutOfRangeException("maxParallelism");
+
+	ParallelOptions^ options = gcnew ParallelOptions();
+	options->MaxDegreeOfParallelism = maxParallelism;
+
+	// Each translation unit is visited by a single thread; the units are the unit of parallelism
+	Parallel::ForEach(transunits, options, gcnew Action<TranslationUnit^>(this, &DocumentationExtractor::ExtractUnit));
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Extract
+//
+// Parses and extracts the documentation comments of every command in a compilation database
+//
+// Arguments:
+//
+//	index		- Index used to parse the translation units
+//	database	- Compilation database that contains the compile commands
+
+void DocumentationExtractor::Extract(Index^ index, CompilationDatabase^ database)
+{
+	Extract(index, database, -1);
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Extract
+//
+// Parses and extracts the documentation comments of every command in a compilation database
+//
+// Arguments:
+//
+//	index			- Index used to parse the translation units
+//	database		- Compilation database that contains the compile commands
+//	maxParallelism	- Maximum number of commands to parse concurrently, or -1
+
+void DocumentationExtractor::Extract(Index^ index, CompilationDatabase^ database, int maxParallelism)
+{
+	if(Object::ReferenceEquals(index, nullptr)) throw gcnew ArgumentNullException("index");
+	if(Object::ReferenceEquals(database, nullptr)) throw gcnew ArgumentNullException("database");
+	if((maxParallelism == 0) || (maxParallelism < -1)) throw gcnew ArgumentOutOfRangeException("maxParallelism");
+
+	ParallelOptions^ options = gcnew ParallelOptions();
+	options->MaxDegreeOfParallelism = maxParallelism;
+
+	// Each translation unit only lives as long as it takes to extract it
+	CommandWorker^ worker = gcnew CommandWorker(this, index);
+	Parallel::ForEach(database->GetCompileCommands(), options, gcnew Action<CompileCommand^>(worker, &CommandWorker::Extract));
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::ExtractUnit (private)
+//
+// Extracts the documentation comments from a single translation unit
+//
+// Arguments:
+//
+//	transunit	- Translation unit to be extracted
+
+void DocumentationExtractor::ExtractUnit(TranslationUnit^ transunit)
+{
+	if(Object::ReferenceEquals(transunit, nullptr)) throw gcnew ArgumentNullException("transunit");
+
+	TranslationUnitHandle::Reference handle(transunit->Handle);
+	Visitor^ visitor = gcnew Visitor(this);
+
+	clang_visitChildren(clang_getTranslationUnitCursor(handle), VisitCallback, AutoGCHandle(visitor));
+
+	// Check if an exception occurred during the visitation and re-throw it
+	if(!Object::ReferenceEquals(visitor->Error, nullptr)) throw visitor->Error;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::FileCount::get
+//
+// Gets the number of distinct source files that have been processed
+
+int DocumentationExtractor::FileCount::get(void)
+{
+	Monitor::Enter(m_files);
+
+	try { return m_files->Count; }
+	finally { Monitor::Exit(m_files); }
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::GetText (private, static)
+//
+// Gets the whitespace-normalized text of a comment node and its children
+//
+// Arguments:
+//
+//	comment		- Comment node from which to get the text
+
+String^ DocumentationExtractor::GetText(CXComment comment)
+{
+	StringBuilder^ builder = gcnew StringBuilder();
+	AppendText(comment, builder);
+
+	// Each line of a paragraph is a separate text node; collapse the line breaks and indentation
+	return String::Join(" ", builder->ToString()->Split(static_cast<array<wchar_t>^>(nullptr), StringSplitOptions::RemoveEmptyEntries));
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::RecordCount::get
+//
+// Gets the number of records that have been sent to the sink
+
+int DocumentationExtractor::RecordCount::get(void)
+{
+	return m_records;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::CommandWorker::Extract
+//
+// Parses and extracts a single compile command
+//
+// Arguments:
+//
+//	command		- Compile command to be parsed
+
+void DocumentationExtractor::CommandWorker::Extract(CompileCommand^ command)
+{
+	// Function bodies cannot contain anything that would be documented
+	TranslationUnit^ transunit = m_index->CreateTranslationUnit(nullptr, command->GetCommandLine(nullptr), 
+		TranslationUnitParseOptions::ArgumentsAreFullCommandLine | TranslationUnitParseOptions::SkipFunctionBodies);
+
+	try { m_owner->ExtractUnit(transunit); }
+	finally { delete transunit; }
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Visitor Constructor
+//
+// Arguments:
+//
+//	owner		- Owning DocumentationExtractor instance
+
+DocumentationExtractor::Visitor::Visitor(DocumentationExtractor^ owner) : m_owner(owner), m_files(gcnew Dictionary<IntPtr, String^>()),
+	m_skipped(gcnew HashSet<IntPtr>())
+{
+	if(Object::ReferenceEquals(owner, nullptr)) throw gcnew ArgumentNullException("owner");
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Visitor::CreateRecord (private)
+//
+// Creates the documentation record for a declaration, if it has a comment
+//
+// Arguments:
+//
+//	cursor		- Declaration cursor
+//	file		- File in which the declaration is located
+//	line		- Line number of the declaration location
+//	column		- Column number of the declaration location
+
+DocumentationRecord^ DocumentationExtractor::Visitor::CreateRecord(CXCursor cursor, CXFile file, unsigned int line, unsigned int column)
+{
+	CXComment comment = clang_Cursor_getParsedComment(cursor);
+	if(clang_Comment_getKind(comment) == CXCommentKind::CXComment_Null) return nullptr;
+
+	// Redeclarations share the same comment, only report the first one encountered
+	String^ usr = StringUtil::ToString(clang_getCursorUSR(cursor));
+	if(!m_owner->ClaimSymbol(usr)) return nullptr;
+
+	List<KeyValuePair<String^, String^>>^ params = gcnew List<KeyValuePair<String^, String^>>();
+	List<KeyValuePair<String^, String^>>^ tparams = gcnew List<KeyValuePair<String^, String^>>();
+
+	// Parameter documentation is only found among the immediate children of the full comment
+	for(unsigned int index = 0; index < clang_Comment_getNumChildren(comment); index++) {
+
+		CXComment child = clang_Comment_getChild(comment, index);
+		CXCommentKind kind = clang_Comment_getKind(child);
+
+		if(kind == CXCommentKind::CXComment_ParamCommand) 
+			params->Add(KeyValuePair<String^, String^>(StringUtil::ToString(clang_ParamCommandComment_getParamName(child)), GetText(child)));
+
+		else if(kind == CXCommentKind::CXComment_TParamCommand)
+			tparams->Add(KeyValuePair<String^, String^>(StringUtil::ToString(clang_TParamCommandComment_getParamName(child)), GetText(child)));
+	}
+
+	return DocumentationRecord::Create(CursorKind(clang_getCursorKind(cursor)), StringUtil::ToString(clang_getCursorSpelling(cursor)), usr, 
+		m_files[IntPtr(file)], static_cast<int>(line), static_cast<int>(column), StringUtil::ToString(clang_Cursor_getBriefCommentText(cursor)), 
+		params, tparams, StringUtil::ToString(clang_FullComment_getAsXML(comment)));
+}
+
+//---------------------------------------------------------------------------
+// DocumentationExtractor::Visitor::Visit
+//
+// Visits a single cursor within the translation unit
+//
+// Arguments:
+//
+//	cursor		- Cursor being visited
+
+CXChildVisitResult DocumentationExtractor::Visitor::Visit(CXCursor cursor)
+{
+	CXFile					file;				// Location file
+	unsigned int			line, column;		// Location information
+
+	// Statements and expressions cannot contain anything that would be documented
+	CXCursorKind kind = clang_getCursorKind(cursor);
+	if((clang_isStatement(kind) != 0) || (clang_isExpression(kind) != 0)) return CXChildVisitResult::CXChildVisit_Continue;
+
+	// Declarations without a file (built-ins, etc) are not documented.  The expansion location is used
+	// rather than the spelling location; a declaration produced by a macro from a shared header belongs
+	// to the file that expanded the macro, which is the only place it appears in an AST
+	clang_getExpansionLocation(clang_getCursorLocation(cursor), &file, &line, &column, __nullptr);
+	if(file == __nullptr) return CXChildVisitResult::CXChildVisit_Continue;
+
+	try {
+
+		// Skip the entire subtree if the file has been claimed by another translation unit
+		if(m_skipped->Contains(IntPtr(file))) return CXChildVisitResult::CXChildVisit_Continue;
+		if(!m_files->ContainsKey(IntPtr(file))) {
+
+			if(!m_owner->ClaimFile(file, this)) { m_skipped->Add(IntPtr(file)); return CXChildVisitResult::CXChildVisit_Continue; }
+			m_files->Add(IntPtr(file), StringUtil::ToString(clang_getFileName(file)));
+		}
+
+		if(clang_isDeclaration(kind) != 0) {
+
+			DocumentationRecord^ record = CreateRecord(cursor, file, line, column);
+			if(!Object::ReferenceEquals(record, nullptr)) m_owner->Emit(record);
+		}
+
+		return CXChildVisitResult::CXChildVisit_Recurse;
+	}
+
+	catch(Exception^ exception) { Error = exception; return CXChildVisitResult::CXChildVisit_Break; }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
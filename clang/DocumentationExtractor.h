@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __DOCUMENTATIONEXTRACTOR_H_
+#define __DOCUMENTATIONEXTRACTOR_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Text;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompilationDatabase;
+ref class	CompileCommand;
+ref class	DocumentationRecord;
+ref class	Index;
+ref class	TranslationUnit;
+
+//---------------------------------------------------------------------------
+// Class DocumentationExtractor
+//
+// Extracts the documentation comments of every declaration in a set of
+// translation units in parallel and streams them to a sink delegate.  Each
+// source file is only processed by the first translation unit that claims
+// it and each USR is only reported once, so headers shared between units
+// are not processed repeatedly.  The sink is never invoked concurrently
+//---------------------------------------------------------------------------
+
+public ref class DocumentationExtractor
+{
+public:
+
+	// Instance Constructor
+	//
+	DocumentationExtractor(Action<DocumentationRecord^>^ sink);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Extract
+	//
+	// Extracts the documentation comments from a set of translation units
+	void Extract(IEnumerable<TranslationUnit^>^ transunits);
+	void Extract(IEnumerable<TranslationUnit^>^ transunits, int maxParallelism);
+
+	// Extract
+	//
+	// Parses and extracts the documentation comments of every command in a compilation database
+	void Extract(Index^ index, CompilationDatabase^ database);
+	void Extract(Index^ index, CompilationDatabase^ database, int maxParallelism);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// FileCount
+	//
+	// Gets the number of distinct source files that have been processed
+	property int FileCount
+	{
+		int get(void);
+	}
+
+	// RecordCount
+	//
+	// Gets the number of records that have been sent to the sink
+	property int RecordCount
+	{
+		int get(void);
+	}
+
+internal:
+
+	// Class Visitor
+	//
+	// Visits the declarations of a single translation unit
+	ref class Visitor
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Visitor(DocumentationExtractor^ owner);
+
+		// Visit
+		//
+		// Visits a single cursor within the translation unit
+		CXChildVisitResult Visit(CXCursor cursor);
+
+		// Error
+		//
+		// Exception that occurred during visitation
+		Exception^ Error;
+
+	private:
+
+		// CreateRecord
+		//
+		// Creates the documentation record for a declaration, if it has a comment
+		DocumentationRecord^ CreateRecord(CXCursor cursor, CXFile file, unsigned int line, unsigned int column);
+
+		// Member Variables
+		//
+		DocumentationExtractor^			m_owner;		// Owning extractor
+		Dictionary<IntPtr, String^>^	m_files;		// Claimed file names
+		HashSet<IntPtr>^				m_skipped;		// Files claimed elsewhere
+	};
+
+private:
+
+	// Class CommandWorker
+	//
+	// Parses and extracts a single compile command on behalf of Extract
+	ref class CommandWorker
+	{
+	public:
+
+		// Instance Constructor
+		//
+		CommandWorker(DocumentationExtractor^ owner, Index^ index) : m_owner(owner), m_index(index) {}
+
+		// Extract
+		//
+		// Parses and extracts a single compile command
+		void Extract(CompileCommand^ command);
+
+	private:
+
+		// Member Variables
+		//
+		DocumentationExtractor^		m_owner;		// Owning extractor
+		Index^						m_index;		// Index used for parsing
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AppendText (static)
+	//
+	// Appends the text of a comment node and its children
+	static void AppendText(CXComment comment, StringBuilder^ builder);
+
+	// ClaimFile
+	//
+	// Claims a source file on behalf of a visitor
+	bool ClaimFile(CXFile file, Visitor^ visitor);
+
+	// ClaimSymbol
+	//
+	// Claims a USR, returns false if it has already been reported
+	bool ClaimSymbol(String^ usr);
+
+	// Emit
+	//
+	// Sends a record to the sink
+	void Emit(DocumentationRecord^ record);
+
+	// ExtractUnit
+	//
+	// Extracts the documentation comments from a single translation unit
+	void ExtractUnit(TranslationUnit^ transunit);
+
+	// GetText (static)
+	//
+	// Gets the whitespace-normalized text of a comment node and its children
+	static String^ GetText(CXComment comment);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Action<DocumentationRecord^>^			m_sink;		// Record sink
+	Object^									m_sinklock;	// Sink serialization
+	Dictionary<unsigned __int64, Visitor^>^	m_files;	// Claimed files
+	HashSet<String^>^						m_symbols;	// Reported USRs
+	int										m_records;	// Records sent to the sink
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DOCUMENTATIONEXTRACTOR_H_
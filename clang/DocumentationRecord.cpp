@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "DocumentationRecord.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// DocumentationRecord Constructor (private)
+//
+// Arguments:
+//
+//	kind		- Cursor kind of the declaration
+//	spelling	- Spelling of the declaration
+//	usr			- Unified Symbol Resolution string of the declaration
+//	filename	- Name of the file in which the declaration is located
+//	line		- Line number of the declaration location
+//	column		- Column number of the declaration location
+//	brief		- Brief documentation text
+//	params		- Documented function parameters
+//	tparams		- Documented template parameters
+//	xml			- Full comment converted into XML
+
+DocumentationRecord::DocumentationRecord(CursorKind kind, String^ spelling, String^ usr, String^ filename, int line, int column, 
+	String^ brief, List<KeyValuePair<String^, String^>>^ params, List<KeyValuePair<String^, String^>>^ tparams, String^ xml) : 
+	m_kind(kind), m_spelling(spelling), m_usr(usr), m_filename(filename), m_line(line), m_column(column), m_brief(brief), m_xml(xml)
+{
+	if(Object::ReferenceEquals(spelling, nullptr)) throw gcnew ArgumentNullException("spelling");
+	if(Object::ReferenceEquals(usr, nullptr)) throw gcnew ArgumentNullException("usr");
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+	if(Object::ReferenceEquals(brief, nullptr)) throw gcnew ArgumentNullException("brief");
+	if(Object::ReferenceEquals(params, nullptr)) throw gcnew ArgumentNullException("params");
+	if(Object::ReferenceEquals(tparams, nullptr)) throw gcnew ArgumentNullException("tparams");
+	if(Object::ReferenceEquals(xml, nullptr)) throw gcnew ArgumentNullException("xml");
+
+	m_params = params->AsReadOnly();
+	m_tparams = tparams->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::BriefText::get
+//
+// Gets the brief documentation text of the declaration
+
+String^ DocumentationRecord::BriefText::get(void)
+{
+	return m_brief;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Column::get
+//
+// Gets the column number of the declaration location
+
+int DocumentationRecord::Column::get(void)
+{
+	return m_column;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Create (internal, static)
+//
+// Creates a new DocumentationRecord instance
+//
+// Arguments:
+//
+//	kind		- Cursor kind of the declaration
+//	spelling	- Spelling of the declaration
+//	usr			- Unified Symbol Resolution string of the declaration
+//	filename	- Name of the file in which the declaration is located
+//	line		- Line number of the declaration location
+//	column		- Column number of the declaration location
+//	brief		- Brief documentation text
+//	params		- Documented function parameters
+//	tparams		- Documented template parameters
+//	xml			- Full comment converted into XML
+
+DocumentationRecord^ DocumentationRecord::Create(CursorKind kind, String^ spelling, String^ usr, String^ filename, int line, int column, 
+	String^ brief, List<KeyValuePair<String^, String^>>^ params, List<KeyValuePair<String^, String^>>^ tparams, String^ xml)
+{
+	return gcnew DocumentationRecord(kind, spelling, usr, filename, line, column, brief, params, tparams, xml);
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::FileName::get
+//
+// Gets the name of the file in which the declaration is located
+
+String^ DocumentationRecord::FileName::get(void)
+{
+	return m_filename;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Kind::get
+//
+// Gets the cursor kind of the declaration
+
+CursorKind DocumentationRecord::Kind::get(void)
+{
+	return m_kind;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Line::get
+//
+// Gets the line number of the declaration location
+
+int DocumentationRecord::Line::get(void)
+{
+	return m_line;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Parameters::get
+//
+// Gets the documented function parameter names and text, in comment order
+
+ReadOnlyCollection<KeyValuePair<String^, String^>>^ DocumentationRecord::Parameters::get(void)
+{
+	return m_params;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Spelling::get
+//
+// Gets the spelling of the declaration
+
+String^ DocumentationRecord::Spelling::get(void)
+{
+	return m_spelling;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::TemplateParameters::get
+//
+// Gets the documented template parameter names and text, in comment order
+
+ReadOnlyCollection<KeyValuePair<String^, String^>>^ DocumentationRecord::TemplateParameters::get(void)
+{
+	return m_tparams;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ DocumentationRecord::ToString(void)
+{
+	return m_spelling;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::UnifiedSymbolResolution::get
+//
+// Gets the Unified Symbol Resolution (USR) string of the declaration
+
+String^ DocumentationRecord::UnifiedSymbolResolution::get(void)
+{
+	return m_usr;
+}
+
+//---------------------------------------------------------------------------
+// DocumentationRecord::Xml::get
+//
+// Gets the full comment converted into XML
+
+String^ DocumentationRecord::Xml::get(void)
+{
+	return m_xml;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
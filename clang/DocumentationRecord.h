@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __DOCUMENTATIONRECORD_H_
+#define __DOCUMENTATIONRECORD_H_
+#pragma once
+
+#include "CursorKind.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class DocumentationRecord
+//
+// Represents the documentation comment of a single declaration as produced
+// by a DocumentationExtractor.  Instances do not refer to any unmanaged
+// resources and remain valid after the translation unit is disposed of
+//---------------------------------------------------------------------------
+
+public ref class DocumentationRecord
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// BriefText
+	//
+	// Gets the brief documentation text of the declaration
+	property String^ BriefText
+	{
+		String^ get(void);
+	}
+
+	// Column
+	//
+	// Gets the column number of the declaration location
+	property int Column
+	{
+		int get(void);
+	}
+
+	// FileName
+	//
+	// Gets the name of the file in which the declaration is located
+	property String^ FileName
+	{
+		String^ get(void);
+	}
+
+	// Kind
+	//
+	// Gets the cursor kind of the declaration
+	property CursorKind Kind
+	{
+		CursorKind get(void);
+	}
+
+	// Line
+	//
+	// Gets the line number of the declaration location
+	property int Line
+	{
+		int get(void);
+	}
+
+	// Parameters
+	//
+	// Gets the documented function parameter names and text, in comment order
+	property ReadOnlyCollection<KeyValuePair<String^, String^>>^ Parameters
+	{
+		ReadOnlyCollection<KeyValuePair<String^, String^>>^ get(void);
+	}
+
+	// Spelling
+	//
+	// Gets the spelling of the declaration
+	property String^ Spelling
+	{
+		String^ get(void);
+	}
+
+	// TemplateParameters
+	//
+	// Gets the documented template parameter names and text, in comment order
+	property ReadOnlyCollection<KeyValuePair<String^, String^>>^ TemplateParameters
+	{
+		ReadOnlyCollection<KeyValuePair<String^, String^>>^ get(void);
+	}
+
+	// UnifiedSymbolResolution
+	//
+	// Gets the Unified Symbol Resolution (USR) string of the declaration
+	property String^ UnifiedSymbolResolution
+	{
+		String^ get(void);
+	}
+
+	// Xml
+	//
+	// Gets the full comment converted into XML
+	property String^ Xml
+	{
+		String^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new DocumentationRecord instance
+	static DocumentationRecord^ Create(CursorKind kind, String^ spelling, String^ usr, String^ filename, int line, int column, 
+		String^ brief, List<KeyValuePair<String^, String^>>^ params, List<KeyValuePair<String^, String^>>^ tparams, String^ xml);
+
+private:
+
+	// Instance Constructor
+	//
+	DocumentationRecord(CursorKind kind, String^ spelling, String^ usr, String^ filename, int line, int column, 
+		String^ brief, List<KeyValuePair<String^, String^>>^ params, List<KeyValuePair<String^, String^>>^ tparams, String^ xml);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CursorKind					m_kind;				// Declaration kind
+	String^						m_spelling;			// Declaration spelling
+	String^						m_usr;				// Declaration USR
+	String^						m_filename;			// Location file name
+	int							m_line;				// Location line number
+	int							m_column;			// Location column number
+	String^						m_brief;			// Brief comment text
+	String^						m_xml;				// Full comment XML
+
+	ReadOnlyCollection<KeyValuePair<String^, String^>>^	m_params;	// Parameter text
+	ReadOnlyCollection<KeyValuePair<String^, String^>>^	m_tparams;	// Template parameter text
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __DOCUMENTATIONRECORD_H_
@@ -25,6 +25,7 @@
 
 #include "Location.h"
 #include "LocationKind.h"
+#include "PerformanceCounters.h"
 #include "TokenCollection.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
@@ -142,6 +143,7 @@ bool Extent::Contains(const CXSourceLocation& location)
 
 Extent^ Extent::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXSourceRange extent)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Extent);
 	return gcnew Extent(gcnew SourceRangeHandle(owner, transunit, extent));
 }
 
@@ -226,9 +228,13 @@ TokenCollection^ Extent::GetTokens(void)
 	unsigned int					numtokens = 0;			// Number of unmanaged tokens
 	SourceRangeHandle::Reference	extent(m_handle);		// Unwrap the safe handle
 
+	__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Tokenize);
+
 	// Tokenize the entire extent and generate a new TokenCollection from it
 	clang_tokenize(extent.TranslationUnit, extent, &tokens, &numtokens);
 
+	PerformanceCounters::EndOperation(PerformanceOperation::Tokenize, started, nullptr);
+
 #pragma message("CLANG WORKAROUND: https://llvm.org/bugs/show_bug.cgi?id=9069")
 	// Clang may return one too many tokens, check the last one's location.  Removing it from the
 	// collection size won't cause it to leak, clang_disposeTokens doesn't actually check the count
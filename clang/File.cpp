@@ -34,7 +34,9 @@
 #include "Location.h"
 #include "LocationKind.h"
 #include "Module.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
+#include "Utf8String.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -117,6 +119,7 @@ bool File::operator!=(File^ lhs, File^ rhs)
 
 File^ File::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXFile file)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::File);
 	return gcnew File(gcnew FileHandle(owner, transunit, file));
 }
 
@@ -268,6 +271,21 @@ Location^ File::GetLocation(int line, int column)
 	return Location::Create(m_handle->Owner, m_handle->TranslationUnit, clang_getLocation(file.TranslationUnit, file, line, column), LocationKind::Spelling);
 }
 
+//---------------------------------------------------------------------------
+// File::GetNameUtf8
+//
+// Gets the name of the file as raw UTF-8
+//
+// Arguments:
+//
+//	NONE
+
+Utf8String^ File::GetNameUtf8(void)
+{
+	// This is a method not a property, the caller owns the returned object
+	return Utf8String::Create(clang_getFileName(FileHandle::Reference(m_handle)));
+}
+
 //---------------------------------------------------------------------------
 // File::IsMultipleIncludeGuarded::get
 //
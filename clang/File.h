@@ -42,6 +42,7 @@ ref class	ExtentCollection;
 value class	FileUniqueIdentifier;
 ref class	Location;
 ref class	Module;
+ref class	Utf8String;
 
 //---------------------------------------------------------------------------
 // Class File
@@ -99,6 +100,11 @@ public:
 	Location^ GetLocation(int offset);
 	Location^ GetLocation(int line, int column);
 
+	// GetNameUtf8
+	//
+	// Gets the name of the file as raw UTF-8
+	Utf8String^ GetNameUtf8(void);
+
 	// IsNull (static)
 	//
 	// Determines if the specified file object is null
@@ -0,0 +1,304 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "ImplicitModuleCache.h"
+
+#include "Clang.h"
+#include "CompileCommand.h"
+#include "Index.h"
+#include "TranslationUnit.h"
+#include "TranslationUnitParseOptions.h"
+
+using namespace System::IO;
+using namespace System::Text;
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache Constructor
+//
+// Arguments:
+//
+//	cachedirectory	- Directory to contain the module maps and compiled modules
+
+ImplicitModuleCache::ImplicitModuleCache(String^ cachedirectory) : m_directories(gcnew Dictionary<String^, String^>(StringComparer::OrdinalIgnoreCase)),
+	m_names(gcnew HashSet<String^>(StringComparer::OrdinalIgnoreCase)), m_maps(gcnew List<String^>())
+{
+	if(Object::ReferenceEquals(cachedirectory, nullptr)) throw gcnew ArgumentNullException("cachedirectory");
+
+	m_cachedir = Path::GetFullPath(cachedirectory);
+	m_modulesdir = Path::Combine(m_cachedir, "modules");
+	m_mapsdir = Path::Combine(m_cachedir, "maps");
+
+	Directory::CreateDirectory(m_modulesdir);
+	Directory::CreateDirectory(m_mapsdir);
+
+	m_timestamp = Clang::GetBuildSessionTimestamp();
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::AddHeaderDirectory
+//
+// Generates a module map for a directory of headers and returns the module name
+//
+// Arguments:
+//
+//	directory		- Directory that contains the headers
+
+String^ ImplicitModuleCache::AddHeaderDirectory(String^ directory)
+{
+	if(Object::ReferenceEquals(directory, nullptr)) throw gcnew ArgumentNullException("directory");
+	return AddHeaderDirectory(directory, GetModuleName(directory));
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::AddHeaderDirectory
+//
+// Generates a module map for a directory of headers and returns the module name
+//
+// Arguments:
+//
+//	directory		- Directory that contains the headers
+//	modulename		- Requested name of the module
+
+String^ ImplicitModuleCache::AddHeaderDirectory(String^ directory, String^ modulename)
+{
+	String^					existing;				// Module already generated for the directory
+
+	if(Object::ReferenceEquals(directory, nullptr)) throw gcnew ArgumentNullException("directory");
+	if(Object::ReferenceEquals(modulename, nullptr)) throw gcnew ArgumentNullException("modulename");
+
+	directory = Path::GetFullPath(directory);
+	if(!Directory::Exists(directory)) throw gcnew DirectoryNotFoundException(directory);
+
+	modulename = GetModuleName(modulename);
+
+	Monitor::Enter(m_maps);
+
+	try {
+
+		if(m_directories->TryGetValue(directory, existing)) return existing;
+
+		// Module names have to be unique across all of the generated maps
+		String^ name = modulename;
+		for(int suffix = 2; m_names->Contains(name); suffix++) name = String::Concat(modulename, "_", suffix.ToString());
+
+		// libclang's ModuleMapDescriptor can only describe a framework module with an umbrella header,
+		// a plain header directory is described with an umbrella directory instead.  Module map string
+		// literals are not escaped, the path separators have to be forward slashes
+		StringBuilder^ builder = gcnew StringBuilder();
+		builder->Append("module ")->Append(name)->Append(" {\n");
+		builder->Append("  umbrella \"")->Append(directory->Replace('\\', '/'))->Append("\"\n");
+		builder->Append("  module * { export * }\n");
+		builder->Append("}\n");
+		String^ text = builder->ToString();
+
+		// Only rewrite an existing map if it changed, the compiled modules are invalidated by it
+		String^ mapfile = Path::Combine(m_mapsdir, String::Concat(name, ".modulemap"));
+		if((!File::Exists(mapfile)) || (!String::Equals(File::ReadAllText(mapfile), text))) File::WriteAllText(mapfile, text);
+
+		m_directories->Add(directory, name);
+		m_names->Add(name);
+		m_maps->Add(mapfile);
+
+		return name;
+	}
+
+	finally { Monitor::Exit(m_maps); }
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::BeginBuildSession
+//
+// Starts a new build session, modules are validated again on first use
+//
+// Arguments:
+//
+//	NONE
+
+void ImplicitModuleCache::BeginBuildSession(void)
+{
+	Monitor::Enter(m_maps);
+
+	try { m_timestamp = Clang::GetBuildSessionTimestamp(); }
+	finally { Monitor::Exit(m_maps); }
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::BuildSessionTimestamp::get
+//
+// Gets the timestamp of the current build session
+
+UInt64 ImplicitModuleCache::BuildSessionTimestamp::get(void)
+{
+	Monitor::Enter(m_maps);
+
+	try { return m_timestamp; }
+	finally { Monitor::Exit(m_maps); }
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::CacheDirectory::get
+//
+// Gets the directory that contains the module maps and compiled modules
+
+String^ ImplicitModuleCache::CacheDirectory::get(void)
+{
+	return m_cachedir;
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::Clear
+//
+// Removes all of the compiled modules from the cache; this must not be
+// called while translation units are being created from the cache
+//
+// Arguments:
+//
+//	NONE
+
+void ImplicitModuleCache::Clear(void)
+{
+	Monitor::Enter(m_maps);
+
+	try {
+
+		if(Directory::Exists(m_modulesdir)) Directory::Delete(m_modulesdir, true);
+		Directory::CreateDirectory(m_modulesdir);
+	}
+
+	finally { Monitor::Exit(m_maps); }
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::CreateTranslationUnit
+//
+// Creates a TranslationUnit by parsing a compile command with the module flags
+//
+// Arguments:
+//
+//	index		- Index instance to use for the parse
+//	command		- Compile command to be parsed
+
+TranslationUnit^ ImplicitModuleCache::CreateTranslationUnit(Index^ index, CompileCommand^ command)
+{
+	return CreateTranslationUnit(index, command, TranslationUnitParseOptions::None);
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::CreateTranslationUnit
+//
+// Creates a TranslationUnit by parsing a compile command with the module flags
+//
+// Arguments:
+//
+//	index		- Index instance to use for the parse
+//	command		- Compile command to be parsed
+//	options		- Options to control source code parsing behaviors
+
+TranslationUnit^ ImplicitModuleCache::CreateTranslationUnit(Index^ index, CompileCommand^ command, TranslationUnitParseOptions options)
+{
+	if(Object::ReferenceEquals(index, nullptr)) throw gcnew ArgumentNullException("index");
+	if(Object::ReferenceEquals(command, nullptr)) throw gcnew ArgumentNullException("command");
+
+	// The arguments include the compiler executable, they are always a full command line
+	return index->CreateTranslationUnit(nullptr, GetArguments(command), options | TranslationUnitParseOptions::ArgumentsAreFullCommandLine);
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::GetArguments
+//
+// Gets the full command line of a compile command with the working directory and module flags
+//
+// Arguments:
+//
+//	command		- Compile command to be modified
+
+array<String^>^ ImplicitModuleCache::GetArguments(CompileCommand^ command)
+{
+	if(Object::ReferenceEquals(command, nullptr)) throw gcnew ArgumentNullException("command");
+
+	List<String^>^ flags = gcnew List<String^>(m_maps->Count + 5);
+
+	Monitor::Enter(m_maps);
+
+	try {
+
+		// The module flags go immediately after the compiler executable; the compiled modules are
+		// only checked against their inputs on the first use in each build session
+		flags->Add("-fmodules");
+		flags->Add("-fimplicit-module-maps");
+		flags->Add(String::Concat("-fmodules-cache-path=", m_modulesdir));
+		flags->Add(String::Concat("-fbuild-session-timestamp=", m_timestamp.ToString()));
+		flags->Add("-fmodules-validate-once-per-build-session");
+		for each(String^ mapfile in m_maps) flags->Add(String::Concat("-fmodule-map-file=", mapfile));
+	}
+
+	finally { Monitor::Exit(m_maps); }
+
+	return command->GetCommandLine(flags->ToArray());
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::GetModuleName (private, static)
+//
+// Converts a directory name into a module identifier
+//
+// Arguments:
+//
+//	directory		- Directory name or requested module name
+
+String^ ImplicitModuleCache::GetModuleName(String^ directory)
+{
+	String^ name = Path::GetFileName(directory->TrimEnd(Path::DirectorySeparatorChar, Path::AltDirectorySeparatorChar));
+	StringBuilder^ builder = gcnew StringBuilder(name->Length + 1);
+
+	// Module names are identifiers, anything else is replaced with an underscore
+	for each(wchar_t ch in name) builder->Append(((ch < 0x80) && (Char::IsLetterOrDigit(ch))) ? ch : L'_');
+	if((builder->Length == 0) || (Char::IsDigit(builder[0]))) builder->Insert(0, L'_');
+
+	return builder->ToString();
+}
+
+//---------------------------------------------------------------------------
+// ImplicitModuleCache::ModuleMapFiles::get
+//
+// Gets the paths to the generated module maps
+
+ReadOnlyCollection<String^>^ ImplicitModuleCache::ModuleMapFiles::get(void)
+{
+	Monitor::Enter(m_maps);
+
+	try { return gcnew ReadOnlyCollection<String^>(m_maps->ToArray()); }
+	finally { Monitor::Exit(m_maps); }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
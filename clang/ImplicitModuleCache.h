@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __IMPLICITMODULECACHE_H_
+#define __IMPLICITMODULECACHE_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	CompileCommand;
+ref class	Index;
+ref class	TranslationUnit;
+enum class	TranslationUnitParseOptions;
+
+//---------------------------------------------------------------------------
+// Class ImplicitModuleCache
+//
+// Manages implicitly built modules for project header directories.  A module
+// map is generated for each header directory and the compile commands from
+// a CompilationDatabase are given the -fmodules flags required to import the
+// headers as modules, sharing the compiled modules in a cache directory that
+// is validated once per build session instead of on every parse
+//---------------------------------------------------------------------------
+
+public ref class ImplicitModuleCache
+{
+public:
+
+	// Instance Constructor
+	//
+	ImplicitModuleCache(String^ cachedirectory);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// AddHeaderDirectory
+	//
+	// Generates a module map for a directory of headers and returns the module name
+	String^ AddHeaderDirectory(String^ directory);
+	String^ AddHeaderDirectory(String^ directory, String^ modulename);
+
+	// BeginBuildSession
+	//
+	// Starts a new build session, modules are validated again on first use
+	void BeginBuildSession(void);
+
+	// Clear
+	//
+	// Removes all of the compiled modules from the cache
+	void Clear(void);
+
+	// CreateTranslationUnit
+	//
+	// Creates a TranslationUnit by parsing a compile command with the module flags
+	TranslationUnit^ CreateTranslationUnit(Index^ index, CompileCommand^ command);
+	TranslationUnit^ CreateTranslationUnit(Index^ index, CompileCommand^ command, TranslationUnitParseOptions options);
+
+	// GetArguments
+	//
+	// Gets the full command line of a compile command with the working directory and module flags
+	array<String^>^ GetArguments(CompileCommand^ command);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// BuildSessionTimestamp
+	//
+	// Gets the timestamp of the current build session
+	property UInt64 BuildSessionTimestamp
+	{
+		UInt64 get(void);
+	}
+
+	// CacheDirectory
+	//
+	// Gets the directory that contains the module maps and compiled modules
+	property String^ CacheDirectory
+	{
+		String^ get(void);
+	}
+
+	// ModuleMapFiles
+	//
+	// Gets the paths to the generated module maps
+	property ReadOnlyCollection<String^>^ ModuleMapFiles
+	{
+		ReadOnlyCollection<String^>^ get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetModuleName (static)
+	//
+	// Converts a directory name into a module identifier
+	static String^ GetModuleName(String^ directory);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	String^								m_cachedir;		// Cache directory
+	String^								m_modulesdir;	// Compiled module directory
+	String^								m_mapsdir;		// Module map directory
+	UInt64								m_timestamp;	// Build session timestamp
+	Dictionary<String^, String^>^		m_directories;	// Header directory modules
+	HashSet<String^>^					m_names;		// Module names in use
+	List<String^>^						m_maps;			// Module map files
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __IMPLICITMODULECACHE_H_
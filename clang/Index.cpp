@@ -34,6 +34,7 @@
 #include "IndexImportedASTFile.h"
 #include "IndexIncludedFile.h"
 #include "IndexOptions.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
 #include "TranslationUnit.h"
 #include "TranslationUnitParseOptions.h"
@@ -244,56 +245,15 @@ TranslationUnit^ Index::CreateTranslationUnit(String^ path, IEnumerable<UnsavedF
 
 TranslationUnit^ Index::CreateTranslationUnit(String^ path, IEnumerable<String^>^ args, IEnumerable<UnsavedFile^>^ unsavedfiles, TranslationUnitParseOptions options)
 {
-	CXTranslationUnit			tu;						// Resultant translation unit structure
-	int							numargs = 0;			// Number of argument strings
 	int							numunsaved = 0;			// Number of UnsavedFile object instances
-	bool						fullcmdline = false;	// Flag if args contains a full command line
 
 	CHECK_DISPOSED(m_disposed);
 
-	// If the special -1 option was specified, ask libclang to provide a default options mask
-	if(options == static_cast<TranslationUnitParseOptions>(-1)) 
-		options = static_cast<TranslationUnitParseOptions>(clang_defaultEditingTranslationUnitOptions());
-
-	// The custom TranslationUnitParseOptions::ArgumentsAreFullCommandLine has to be checked and
-	// removed from the flags before they are passed into clang -- this indicates a different method call
-	else if((options & TranslationUnitParseOptions::ArgumentsAreFullCommandLine) == TranslationUnitParseOptions::ArgumentsAreFullCommandLine) {
-
-		fullcmdline = true;
-		options = TranslationUnitParseOptions(options & ~TranslationUnitParseOptions::ArgumentsAreFullCommandLine);
-	}
-
-	// Convert the managed path string into a standard C-style string (NULL is OK here)
-	char* pszpath = StringUtil::ToCharPointer(path, CP_UTF8);
-
-	try { 
-		
-		// Convert the enumerable range of string arguments into an unmanaged array and check
-		// that there is at least one argument specified if necessary for argv[0]
-		char** rgszargs = StringUtil::ToCharPointerArray(args, CP_UTF8, &numargs);
-		if((fullcmdline) && (numargs == 0)) throw gcnew ArgumentNullException("args");
-
-		try { 
-			
-			// Convert the enumerable range of UnsavedFile objects into an unmanaged array
-			CXUnsavedFile* rgunsaved = UnsavedFile::UnsavedFilesToArray(unsavedfiles, &numunsaved);
+	// Convert the enumerable range of UnsavedFile objects into an unmanaged array
+	CXUnsavedFile* rgunsaved = UnsavedFile::UnsavedFilesToArray(unsavedfiles, &numunsaved);
 
-			try {
-
-				// Create the translation unit by parsing the specified file/unsaved file
-				CXErrorCode result = (fullcmdline) ?
-					clang_parseTranslationUnit2FullArgv(IndexHandle::Reference(m_handle), pszpath, rgszargs, numargs, rgunsaved, numunsaved, static_cast<unsigned int>(options), &tu) :
-					clang_parseTranslationUnit2(IndexHandle::Reference(m_handle), pszpath, rgszargs, numargs, rgunsaved, numunsaved, static_cast<unsigned int>(options), &tu);
-				if(result != CXError_Success) throw gcnew ClangException(result);
-
-				// Pass ownership of the resultant translation unit to TranslationUnit
-				return TranslationUnit::Create(m_handle, std::move(tu));
-
-			} finally { UnsavedFile::FreeUnsavedFilesArray(rgunsaved, numunsaved); }
-
-		} finally { StringUtil::FreeCharPointerArray(rgszargs);  }
-
-	} finally { StringUtil::FreeCharPointer(pszpath); }
+	try { return ParseTranslationUnit(path, args, rgunsaved, numunsaved, options); }
+	finally { UnsavedFile::FreeUnsavedFilesArray(rgunsaved, numunsaved); }
 }
 
 //---------------------------------------------------------------------------
@@ -909,6 +869,71 @@ TranslationUnit^ Index::LoadTranslationUnit(String^ path)
 	finally { StringUtil::FreeCharPointer(pszpath); }
 }
 
+//---------------------------------------------------------------------------
+// Index::ParseTranslationUnit (internal)
+//
+// Create a TranslationUnit by parsing source code against an unmanaged array of unsaved files
+//
+// Arguments:
+//
+//	path			- Path to the input source code file (optional)
+//	args			- Arguments to pass to the libclang engine
+//	rgunsaved		- Unmanaged array of unsaved files
+//	numunsaved		- Number of unsaved files in the array
+//	options			- Options to control source code parsing behaviors
+
+TranslationUnit^ Index::ParseTranslationUnit(String^ path, IEnumerable<String^>^ args, CXUnsavedFile* rgunsaved, int numunsaved, TranslationUnitParseOptions options)
+{
+	CXTranslationUnit			tu;						// Resultant translation unit structure
+	int							numargs = 0;			// Number of argument strings
+	bool						fullcmdline = false;	// Flag if args contains a full command line
+
+	CHECK_DISPOSED(m_disposed);
+
+	// If the special -1 option was specified, ask libclang to provide a default options mask
+	if(options == static_cast<TranslationUnitParseOptions>(-1)) 
+		options = static_cast<TranslationUnitParseOptions>(clang_defaultEditingTranslationUnitOptions());
+
+	// The custom TranslationUnitParseOptions::ArgumentsAreFullCommandLine has to be checked and
+	// removed from the flags before they are passed into clang -- this indicates a different method call
+	else if((options & TranslationUnitParseOptions::ArgumentsAreFullCommandLine) == TranslationUnitParseOptions::ArgumentsAreFullCommandLine) {
+
+		fullcmdline = true;
+		options = TranslationUnitParseOptions(options & ~TranslationUnitParseOptions::ArgumentsAreFullCommandLine);
+	}
+
+	// Convert the managed path string into a standard C-style string (NULL is OK here)
+	char* pszpath = StringUtil::ToCharPointer(path, CP_UTF8);
+
+	try { 
+		
+		// Convert the enumerable range of string arguments into an unmanaged array and check
+		// that there is at least one argument specified if necessary for argv[0]
+		char** rgszargs = StringUtil::ToCharPointerArray(args, CP_UTF8, &numargs);
+		if((fullcmdline) && (numargs == 0)) throw gcnew ArgumentNullException("args");
+
+		try { 
+			
+			__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Parse);
+
+			// Create the translation unit by parsing the specified file/unsaved file
+			CXErrorCode result = (fullcmdline) ?
+				clang_parseTranslationUnit2FullArgv(IndexHandle::Reference(m_handle), pszpath, rgszargs, numargs, rgunsaved, numunsaved, static_cast<unsigned int>(options), &tu) :
+				clang_parseTranslationUnit2(IndexHandle::Reference(m_handle), pszpath, rgszargs, numargs, rgunsaved, numunsaved, static_cast<unsigned int>(options), &tu);
+
+			// Full command lines carry the source file in the arguments, get the name from the result
+			if(started != 0) PerformanceCounters::EndOperation(PerformanceOperation::Parse, started, ((Object::ReferenceEquals(path, nullptr)) && 
+				(result == CXError_Success)) ? StringUtil::ToString(clang_getTranslationUnitSpelling(tu)) : path);
+			if(result != CXError_Success) throw gcnew ClangException(result);
+
+			// Pass ownership of the resultant translation unit to TranslationUnit
+			return TranslationUnit::Create(m_handle, std::move(tu));
+
+		} finally { StringUtil::FreeCharPointerArray(rgszargs);  }
+
+	} finally { StringUtil::FreeCharPointer(pszpath); }
+}
+
 //---------------------------------------------------------------------------
 // Index::StartedTranslationUnit::add
 //
@@ -262,6 +262,11 @@ internal:
 	// Creates a new Index instance
 	static Index^ Create(CXIndex&& index);
 
+	// ParseTranslationUnit
+	//
+	// Create a TranslationUnit by parsing source code against an unmanaged array of unsaved files
+	TranslationUnit^ ParseTranslationUnit(String^ path, IEnumerable<String^>^ args, CXUnsavedFile* rgunsaved, int numunsaved, TranslationUnitParseOptions options);
+
 private:
 
 	// IndexHandle
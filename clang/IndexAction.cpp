@@ -40,6 +40,7 @@
 #include "IndexIncludedFile.h"
 #include "IndexIncludedFileEventArgs.h"
 #include "IndexOptions.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
 #include "TranslationUnit.h"
 #include "TranslationUnitHandle.h"
@@ -195,11 +196,15 @@ void IndexAction::IndexSourceFile(String^ filename, IEnumerable<String^>^ args,
 
 				try {
 
+					__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Index);
+
 					// Index the source file using the provided arguments and unsaved file objects
 					int result = (fullcmdline) ?
 						clang_indexSourceFileFullArgv(IndexActionHandle::Reference(m_handle), gcstate.ToPointer(), &callbacks, sizeof(IndexerCallbacks), static_cast<unsigned int>(options), pszfilename, rgszargs, numargs, rgunsaved, numunsaved, __nullptr, transunitoptions) :
 						clang_indexSourceFile(IndexActionHandle::Reference(m_handle), gcstate.ToPointer(), &callbacks, sizeof(IndexerCallbacks), static_cast<unsigned int>(options), pszfilename, rgszargs, numargs, rgunsaved, numunsaved, __nullptr, transunitoptions);
 
+					PerformanceCounters::EndOperation(PerformanceOperation::Index, started, filename);
+
 					if(result != CXError_Success) throw gcnew ClangException(CXErrorCode(result));
 
 				} finally { UnsavedFile::FreeUnsavedFilesArray(rgunsaved, numunsaved); }
@@ -248,9 +253,13 @@ void IndexAction::IndexTranslationUnit(TranslationUnit^ transunit, IndexOptions
 			static_cast<OnIndexEntityReferencePointer>(Marshal::GetFunctionPointerForDelegate(m_onentityreference).ToPointer()),
 		};
 
+		__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Index);
+
 		// Atempt to index the provided translation unit instance using the specified callback pointers
 		int result = clang_indexTranslationUnit(IndexActionHandle::Reference(m_handle), gcstate.ToPointer(), &callbacks, sizeof(IndexerCallbacks),
 			static_cast<unsigned int>(options), TranslationUnitHandle::Reference(transunit->Handle));
+
+		PerformanceCounters::EndOperation(PerformanceOperation::Index, started, (started == 0) ? nullptr : transunit->Spelling);
  		if(result != CXErrorCode::CXError_Success) throw gcnew ClangException(static_cast<CXErrorCode>(result));
 	}
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "IndexAction.h"
+#include "PerformanceCounters.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -74,13 +75,18 @@ public:
 			// AddRef the safe handle that owns this reference
 			m_handle->m_owner->DangerousAddRef(m_release);
  			if(!m_release) throw gcnew ObjectDisposedException(m_handle->m_owner->GetType()->Name);
+
+			PerformanceCounters::HandleAddRef();
 		}
 
 		// Destructor
 		//
 		~Reference() 
 		{ 
-			if(m_release) m_handle->m_owner->DangerousRelease();
+			if(!m_release) return;
+
+			m_handle->m_owner->DangerousRelease();
+			PerformanceCounters::HandleRelease();
 		}
 
 		// operator !
@@ -31,6 +31,7 @@
 #include "IndexEntityLanguage.h"
 #include "StringUtil.h"
 #include "UnifiedSymbolResolution.h"
+#include "UnifiedSymbolResolutionInterner.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -43,7 +44,7 @@ namespace zuki::tools::llvm::clang {
 //
 //	handle		- Reference handle instance
 
-IndexEntity::IndexEntity(IdxEntityInfoHandle^ handle) : m_handle(handle)
+IndexEntity::IndexEntity(IdxEntityInfoHandle^ handle) : m_handle(handle), m_usrid(-1)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
 }
@@ -227,6 +228,22 @@ local::UnifiedSymbolResolution^ IndexEntity::UnifiedSymbolResolution::get(void)
 
 	return m_usr;
 }
+
+//---------------------------------------------------------------------------
+// IndexEntity::UnifiedSymbolResolutionId::get
+//
+// Gets the identifier assigned to the USR by UnifiedSymbolResolutionInterner::Default
+
+int IndexEntity::UnifiedSymbolResolutionId::get(void)
+{
+	if(m_usrid < 0) {
+
+		IdxEntityInfoHandle::Reference info(m_handle);
+		m_usrid = UnifiedSymbolResolutionInterner::Default->Intern((info.IsNull) ? __nullptr : info->USR);
+	}
+
+	return m_usrid;
+}
 	
 //---------------------------------------------------------------------------
 
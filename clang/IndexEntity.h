@@ -134,6 +134,14 @@ public:
 		local::UnifiedSymbolResolution^ get(void);
 	}
 
+	// UnifiedSymbolResolutionId
+	//
+	// Gets the identifier assigned to the USR by UnifiedSymbolResolutionInterner::Default
+	property int UnifiedSymbolResolutionId
+	{
+		int get(void);
+	}
+
 internal:
 
 	//-----------------------------------------------------------------------
@@ -161,6 +169,7 @@ private:
 	IdxEntityInfoHandle^				m_handle;		// Reference handle
 	String^								m_name;			// Cached entity name
 	local::UnifiedSymbolResolution^		m_usr;			// Cached entity USR
+	int									m_usrid;		// Cached entity USR identifier
 	IndexAttributeCollection^			m_attributes;	// Cached attributes
 	local::Cursor^						m_cursor;		// Cached cursor
 };
@@ -29,6 +29,7 @@
 #include "IndexEntityReferenceKind.h"
 #include "Location.h"
 #include "LocationKind.h"
+#include "UnifiedSymbolResolutionInterner.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -41,7 +42,7 @@ namespace zuki::tools::llvm::clang {
 //
 //	handle		- Reference handle instance
 
-IndexEntityReference::IndexEntityReference(IdxEntityRefInfoHandle^ handle) : m_handle(handle)
+IndexEntityReference::IndexEntityReference(IdxEntityRefInfoHandle^ handle) : m_handle(handle), m_usrid(-1)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
 }
@@ -137,6 +138,23 @@ IndexEntity^ IndexEntityReference::ReferencedEntity::get(void)
 	return m_referenced;
 }
 
+//---------------------------------------------------------------------------
+// IndexEntityReference::UnifiedSymbolResolutionId::get
+//
+// Gets the identifier assigned to the USR of the referenced entity by UnifiedSymbolResolutionInterner::Default
+
+int IndexEntityReference::UnifiedSymbolResolutionId::get(void)
+{
+	if(m_usrid < 0) {
+
+		// Intern straight from the unmanaged entity information, without creating an IndexEntity
+		IdxEntityRefInfoHandle::Reference info(m_handle);
+		m_usrid = UnifiedSymbolResolutionInterner::Default->Intern((info->referencedEntity == __nullptr) ? __nullptr : info->referencedEntity->USR);
+	}
+
+	return m_usrid;
+}
+
 //---------------------------------------------------------------------------
 
 } // zuki::tools::llvm::clang
@@ -103,6 +103,14 @@ public:
 		IndexEntity^ get(void);
 	}
 
+	// UnifiedSymbolResolutionId
+	//
+	// Gets the identifier assigned to the USR of the referenced entity by UnifiedSymbolResolutionInterner::Default
+	property int UnifiedSymbolResolutionId
+	{
+		int get(void);
+	}
+
 internal:
 
 	//-----------------------------------------------------------------------
@@ -133,6 +141,7 @@ private:
 	IndexEntity^				m_parent;		// Cached parent entity
 	IndexEntity^				m_referenced;	// Cached referenced entity
 	IndexContainer^				m_container;	// Cached container instance
+	int							m_usrid;		// Cached referenced entity USR identifier
 };
 
 //---------------------------------------------------------------------------
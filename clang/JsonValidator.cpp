@@ -0,0 +1,456 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "JsonValidator.h"
+
+#include <emmintrin.h>
+#include <intrin.h>
+
+using namespace System::Diagnostics;
+using namespace System::IO;
+using namespace System::Runtime::Serialization;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+// BUFFER_SIZE (local)
+//
+// Size of the file read buffer
+static const int BUFFER_SIZE = 256 * 1024;
+
+// MAX_DEPTH (local)
+//
+// Maximum supported container nesting depth
+static const int MAX_DEPTH = 1024;
+
+//---------------------------------------------------------------------------
+// UNMANAGED SCANNER
+//
+// The scanner is compiled as native code so the string scanning can use SSE2
+// intrinsics.  The state is kept in a structure so that a document can be fed
+// to the scanner in arbitrary blocks without any allocation
+//---------------------------------------------------------------------------
+
+#pragma managed(push, off)
+
+// JsonContext
+//
+// Structural position within the document
+enum JsonContext : uint8_t { ContextValue, ContextValueOrClose, ContextKey, ContextKeyOrClose, ContextColon, ContextCommaOrClose, ContextDone };
+
+// JsonLexer
+//
+// Lexical position within the current token
+enum JsonLexer : uint8_t { LexerNone, LexerString, LexerEscape, LexerUnicode, LexerLiteral, LexerNumber };
+
+// JsonNumber
+//
+// Lexical position within a number token
+enum JsonNumber : uint8_t { NumberSign, NumberZero, NumberInteger, NumberPoint, NumberFraction, NumberExponent, NumberExponentSign, NumberExponentDigits };
+
+// JsonScanState
+//
+// Resumable scanner state
+struct JsonScanState
+{
+	uint64_t		offset;							// Bytes consumed
+	int				depth;							// Container depth
+	uint8_t			objects[MAX_DEPTH / 8];			// Container kind bits
+	JsonContext		context;						// Structural state
+	JsonLexer		lexer;							// Lexical state
+	JsonNumber		number;							// Number state
+	bool			key;							// String is an object key
+	const char*		literal;						// Literal being matched
+	int				position;						// Position within literal/escape
+};
+
+//---------------------------------------------------------------------------
+// EndValue (local)
+//
+// Transitions the structural state after a complete value has been scanned
+//
+// Arguments:
+//
+//	state		- Scanner state
+
+static inline void EndValue(JsonScanState& state)
+{
+	state.context = (state.depth == 0) ? ContextDone : ContextCommaOrClose;
+}
+
+//---------------------------------------------------------------------------
+// FindStringSpecial (local)
+//
+// Locates the next byte within a string that requires attention: a closing
+// quote, an escape or a control character
+//
+// Arguments:
+//
+//	data		- Pointer to the data to be scanned
+//	length		- Length of the data to be scanned
+
+static inline size_t FindStringSpecial(const uint8_t* data, size_t length)
+{
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control = _mm_set1_epi8(0x1F);
+
+	size_t index = 0;
+
+	// Check 16 bytes at a time; a byte is a control character when the unsigned
+	// maximum of the byte and 0x1F is 0x1F
+	for(; index + 16 <= length; index += 16) {
+
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+		__m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+			_mm_cmpeq_epi8(_mm_max_epu8(block, control), control));
+
+		unsigned long mask = static_cast<unsigned long>(_mm_movemask_epi8(matches));
+		if(mask != 0) {
+
+			unsigned long bit;
+			_BitScanForward(&bit, mask);
+			return index + bit;
+		}
+	}
+
+	for(; index < length; index++) {
+
+		uint8_t ch = data[index];
+		if((ch == '"') || (ch == '\\') || (ch < 0x20)) return index;
+	}
+
+	return length;
+}
+
+//---------------------------------------------------------------------------
+// IsNumberComplete (local)
+//
+// Determines if the number state represents a complete number token
+//
+// Arguments:
+//
+//	number		- Number state
+
+static inline bool IsNumberComplete(JsonNumber number)
+{
+	return (number == NumberZero) || (number == NumberInteger) || (number == NumberFraction) || (number == NumberExponentDigits);
+}
+
+//---------------------------------------------------------------------------
+// ScanNumber (local)
+//
+// Advances the number state, returns false if the byte is not part of the number
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	ch			- Byte to be scanned
+
+static inline bool ScanNumber(JsonScanState& state, uint8_t ch)
+{
+	bool digit = (ch >= '0') && (ch <= '9');
+	bool exponent = (ch == 'e') || (ch == 'E');
+
+	switch(state.number) {
+
+		case NumberSign:
+			if(ch == '0') { state.number = NumberZero; return true; }
+			if(digit) { state.number = NumberInteger; return true; }
+			return false;
+
+		case NumberZero:
+		case NumberInteger:
+			if(digit && (state.number == NumberInteger)) return true;
+			if(ch == '.') { state.number = NumberPoint; return true; }
+			if(exponent) { state.number = NumberExponent; return true; }
+			return false;
+
+		case NumberPoint:
+			if(digit) { state.number = NumberFraction; return true; }
+			return false;
+
+		case NumberFraction:
+			if(digit) return true;
+			if(exponent) { state.number = NumberExponent; return true; }
+			return false;
+
+		case NumberExponent:
+			if((ch == '+') || (ch == '-')) { state.number = NumberExponentSign; return true; }
+			if(digit) { state.number = NumberExponentDigits; return true; }
+			return false;
+
+		case NumberExponentSign:
+		case NumberExponentDigits:
+			if(digit) { state.number = NumberExponentDigits; return true; }
+			return false;
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// ScanStructure (local)
+//
+// Scans a single byte outside of any token, returns false on a syntax error
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	ch			- Byte to be scanned
+
+static bool ScanStructure(JsonScanState& state, uint8_t ch)
+{
+	if((ch == ' ') || (ch == '\t') || (ch == '\n') || (ch == '\r')) return true;
+
+	switch(state.context) {
+
+		case ContextValue:
+		case ContextValueOrClose:
+
+			if(ch == '{' || ch == '[') {
+
+				if(state.depth == MAX_DEPTH) return false;
+
+				uint8_t bit = static_cast<uint8_t>(1 << (state.depth & 7));
+				if(ch == '{') state.objects[state.depth >> 3] |= bit;
+				else state.objects[state.depth >> 3] &= ~bit;
+
+				state.depth++;
+				state.context = (ch == '{') ? ContextKeyOrClose : ContextValueOrClose;
+				return true;
+			}
+
+			if((ch == ']') && (state.context == ContextValueOrClose)) { state.depth--; EndValue(state); return true; }
+
+			if(ch == '"') { state.lexer = LexerString; state.key = false; return true; }
+			if(ch == 't') { state.lexer = LexerLiteral; state.literal = "true"; state.position = 1; return true; }
+			if(ch == 'f') { state.lexer = LexerLiteral; state.literal = "false"; state.position = 1; return true; }
+			if(ch == 'n') { state.lexer = LexerLiteral; state.literal = "null"; state.position = 1; return true; }
+
+			if((ch == '-') || ((ch >= '0') && (ch <= '9'))) {
+
+				state.lexer = LexerNumber;
+				state.number = (ch == '-') ? NumberSign : (ch == '0') ? NumberZero : NumberInteger;
+				return true;
+			}
+
+			return false;
+
+		case ContextKey:
+		case ContextKeyOrClose:
+
+			if(ch == '"') { state.lexer = LexerString; state.key = true; return true; }
+			if((ch == '}') && (state.context == ContextKeyOrClose)) { state.depth--; EndValue(state); return true; }
+			return false;
+
+		case ContextColon:
+
+			if(ch != ':') return false;
+			state.context = ContextValue;
+			return true;
+
+		case ContextCommaOrClose:
+		{
+			int top = state.depth - 1;
+			bool object = (state.objects[top >> 3] & (1 << (top & 7))) != 0;
+
+			if(ch == ',') { state.context = (object) ? ContextKey : ContextValue; return true; }
+			if(((ch == '}') && object) || ((ch == ']') && !object)) { state.depth--; EndValue(state); return true; }
+			return false;
+		}
+
+		case ContextDone:
+			return false;
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// Scan (local)
+//
+// Scans a block of the document, returns false on a syntax error in which
+// case the state offset indicates the position of the offending byte
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	data		- Pointer to the block of data
+//	length		- Length of the block of data
+
+static bool Scan(JsonScanState& state, const uint8_t* data, size_t length)
+{
+	size_t index = 0;
+
+	while(index < length) {
+
+		uint8_t ch = data[index];
+
+		switch(state.lexer) {
+
+			case LexerString:
+
+				// Skip over ordinary string content in bulk
+				index += FindStringSpecial(data + index, length - index);
+				if(index == length) break;
+
+				ch = data[index];
+				if(ch == '\\') state.lexer = LexerEscape;
+				else if(ch == '"') {
+
+					state.lexer = LexerNone;
+					if(state.key) state.context = ContextColon;
+					else EndValue(state);
+				}
+				else { state.offset += index; return false; }
+
+				index++;
+				break;
+
+			case LexerEscape:
+
+				if(ch == 'u') { state.lexer = LexerUnicode; state.position = 0; }
+				else if((ch == '"') || (ch == '\\') || (ch == '/') || (ch == 'b') || (ch == 'f') || (ch == 'n') || (ch == 'r') || (ch == 't')) state.lexer = LexerString;
+				else { state.offset += index; return false; }
+
+				index++;
+				break;
+
+			case LexerUnicode:
+
+				if(!(((ch >= '0') && (ch <= '9')) || ((ch >= 'a') && (ch <= 'f')) || ((ch >= 'A') && (ch <= 'F')))) { state.offset += index; return false; }
+				if(++state.position == 4) state.lexer = LexerString;
+
+				index++;
+				break;
+
+			case LexerLiteral:
+
+				if(ch != static_cast<uint8_t>(state.literal[state.position])) { state.offset += index; return false; }
+				if(state.literal[++state.position] == '\0') { state.lexer = LexerNone; EndValue(state); }
+
+				index++;
+				break;
+
+			case LexerNumber:
+
+				if(ScanNumber(state, ch)) { index++; break; }
+
+				// The byte following a number is not consumed, it's scanned structurally
+				if(!IsNumberComplete(state.number)) { state.offset += index; return false; }
+				state.lexer = LexerNone;
+				EndValue(state);
+				break;
+
+			default:
+
+				if(!ScanStructure(state, ch)) { state.offset += index; return false; }
+				index++;
+				break;
+		}
+	}
+
+	state.offset += length;
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// ScanComplete (local)
+//
+// Completes the scan at the end of the document, returns false if the
+// document was not a single complete JSON value
+//
+// Arguments:
+//
+//	state		- Scanner state
+
+static bool ScanComplete(JsonScanState& state)
+{
+	if((state.lexer == LexerNumber) && IsNumberComplete(state.number)) {
+
+		state.lexer = LexerNone;
+		EndValue(state);
+	}
+
+	return (state.lexer == LexerNone) && (state.context == ContextDone);
+}
+
+#pragma managed(pop)
+
+//---------------------------------------------------------------------------
+// JsonValidator::Validate (static)
+//
+// Validates the syntax of a JSON file, returns the elapsed time
+//
+// Arguments:
+//
+//	path		- Path to the JSON file to be validated
+
+TimeSpan JsonValidator::Validate(String^ path)
+{
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+
+	Stopwatch^ stopwatch = Stopwatch::StartNew();
+
+	JsonScanState state;
+	memset(&state, 0, sizeof(JsonScanState));
+
+	array<Byte>^ buffer = gcnew array<Byte>(BUFFER_SIZE);
+	FileStream^ stream = gcnew FileStream(path, FileMode::Open, FileAccess::Read, FileShare::Read, BUFFER_SIZE, FileOptions::SequentialScan);
+
+	try {
+
+		pin_ptr<Byte> pinbuffer = &buffer[0];
+		const uint8_t* data = pinbuffer;
+
+		int read = stream->Read(buffer, 0, buffer->Length);
+
+		// Skip over a UTF-8 byte order mark at the start of the file
+		int skip = ((read >= 3) && (data[0] == 0xEF) && (data[1] == 0xBB) && (data[2] == 0xBF)) ? 3 : 0;
+		state.offset = skip;
+
+		while(read > 0) {
+
+			if(!Scan(state, data + skip, read - skip))
+				throw gcnew SerializationException(String::Format("{0} is not valid JSON: unexpected character at offset {1}", Path::GetFileName(path), state.offset));
+
+			skip = 0;
+			read = stream->Read(buffer, 0, buffer->Length);
+		}
+
+		if(!ScanComplete(state))
+			throw gcnew SerializationException(String::Format("{0} is not valid JSON: unexpected end of file", Path::GetFileName(path)));
+	}
+
+	finally { delete stream; }
+
+	return stopwatch->Elapsed;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
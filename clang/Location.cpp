@@ -25,6 +25,7 @@
 
 #include "Cursor.h"
 #include "File.h"
+#include "PerformanceCounters.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -182,6 +183,7 @@ local::Cursor^ Location::Cursor::get(void)
 
 Location^ Location::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXSourceLocation location, LocationKind kind)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Location);
 	return gcnew Location(gcnew SourceLocationHandle(owner, transunit, location), kind);
 }
 
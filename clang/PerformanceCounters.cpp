@@ -0,0 +1,239 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "PerformanceCounters.h"
+
+#include "ClangEventSource.h"
+#include "TraceRecorder.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// PerformanceCounters Static Constructor (private)
+
+static PerformanceCounters::PerformanceCounters()
+{
+	int numoperations = Enum::GetValues(PerformanceOperation::typeid)->Length;
+
+	s_opcounts = gcnew array<__int64>(numoperations);
+	s_opticks = gcnew array<__int64>(numoperations);
+
+	s_objectnames = Enum::GetNames(ObjectType::typeid);
+	s_objects = gcnew array<__int64>(s_objectnames->Length);
+
+	// The event source has to exist before a listener can enable it
+	ClangEventSource::Log->IsEnabled();
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::Enabled::get (static)
+//
+// Gets a flag indicating if the counters are being collected
+
+bool PerformanceCounters::Enabled::get(void)
+{
+	return s_enabled;
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::Enabled::set (static)
+//
+// Sets a flag indicating if the counters are being collected
+
+void PerformanceCounters::Enabled::set(bool value)
+{
+	s_enabled = value;
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::EndOperation (internal, static)
+//
+// Records the completion of an operation started with BeginOperation
+//
+// Arguments:
+//
+//	operation	- Operation that has completed
+//	start		- Timestamp returned from BeginOperation
+//	filename	- File associated with the operation (optional)
+
+void PerformanceCounters::EndOperation(PerformanceOperation operation, __int64 start, String^ filename)
+{
+	if(start == 0) return;
+
+	__int64 now = Stopwatch::GetTimestamp();
+	__int64 elapsed = now - start;
+
+	if(s_tracing) TraceRecorder::Record(operation, L'E', now, filename);
+
+	if(s_enabled) {
+
+		Interlocked::Increment(s_opcounts[static_cast<int>(operation)]);
+		Interlocked::Add(s_opticks[static_cast<int>(operation)], elapsed);
+	}
+
+	if(s_listening) {
+
+		ClangEventSource^ log = ClangEventSource::Log;
+		__int64 microseconds = (elapsed * 1000000) / Stopwatch::Frequency;
+
+		switch(operation) {
+
+			case PerformanceOperation::Parse: log->ParseCompleted(filename, microseconds); break;
+			case PerformanceOperation::Index: log->IndexCompleted(filename, microseconds); break;
+			case PerformanceOperation::Completion: log->CompletionCompleted(filename, microseconds); break;
+			case PerformanceOperation::Tokenize: log->TokenizeCompleted(filename, microseconds); break;
+			case PerformanceOperation::Diagnostics: log->DiagnosticsCompleted(filename, microseconds); break;
+			case PerformanceOperation::Save: log->SaveCompleted(filename, microseconds); break;
+			case PerformanceOperation::Dispose: log->DisposeCompleted(filename, microseconds); break;
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::FinalizerCount::get (static)
+//
+// Gets the number of handles released by a finalizer rather than disposed
+
+Int64 PerformanceCounters::FinalizerCount::get(void)
+{
+	return Interlocked::Read(s_finalizers);
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::GetObjectCounts (static)
+//
+// Gets the number of wrapper objects created, keyed by type name
+//
+// Arguments:
+//
+//	NONE
+
+IDictionary<String^, Int64>^ PerformanceCounters::GetObjectCounts(void)
+{
+	Dictionary<String^, Int64>^ counts = gcnew Dictionary<String^, Int64>(s_objects->Length);
+
+	for(int index = 0; index < s_objects->Length; index++) counts->Add(s_objectnames[index], Interlocked::Read(s_objects[index]));
+	return counts;
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::GetOperationCount (static)
+//
+// Gets the number of times an operation has completed
+//
+// Arguments:
+//
+//	operation	- Operation to get the count for
+
+Int64 PerformanceCounters::GetOperationCount(PerformanceOperation operation)
+{
+	int index = static_cast<int>(operation);
+	if((index < 0) || (index >= s_opcounts->Length)) throw gcnew ArgumentOutOfRangeException("operation");
+
+	return Interlocked::Read(s_opcounts[index]);
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::GetOperationTime (static)
+//
+// Gets the total time spent in an operation
+//
+// Arguments:
+//
+//	operation	- Operation to get the elapsed time for
+
+TimeSpan PerformanceCounters::GetOperationTime(PerformanceOperation operation)
+{
+	int index = static_cast<int>(operation);
+	if((index < 0) || (index >= s_opticks->Length)) throw gcnew ArgumentOutOfRangeException("operation");
+
+	// Stopwatch ticks are not TimeSpan ticks unless the high-resolution timer is unavailable
+	double seconds = static_cast<double>(Interlocked::Read(s_opticks[index])) / Stopwatch::Frequency;
+	return TimeSpan::FromTicks(static_cast<__int64>(seconds * TimeSpan::TicksPerSecond));
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::HandleAddRefCount::get (static)
+//
+// Gets the number of references taken against safe handles
+
+Int64 PerformanceCounters::HandleAddRefCount::get(void)
+{
+	return Interlocked::Read(s_addrefs);
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::HandleReleaseCount::get (static)
+//
+// Gets the number of references released against safe handles
+
+Int64 PerformanceCounters::HandleReleaseCount::get(void)
+{
+	return Interlocked::Read(s_releases);
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::Reset (static)
+//
+// Resets all of the counters to zero
+//
+// Arguments:
+//
+//	NONE
+
+void PerformanceCounters::Reset(void)
+{
+	for(int index = 0; index < s_opcounts->Length; index++) Interlocked::Exchange(s_opcounts[index], 0LL);
+	for(int index = 0; index < s_opticks->Length; index++) Interlocked::Exchange(s_opticks[index], 0LL);
+	for(int index = 0; index < s_objects->Length; index++) Interlocked::Exchange(s_objects[index], 0LL);
+
+	Interlocked::Exchange(s_addrefs, 0LL);
+	Interlocked::Exchange(s_releases, 0LL);
+	Interlocked::Exchange(s_finalizers, 0LL);
+}
+
+//---------------------------------------------------------------------------
+// PerformanceCounters::StartOperation (private, static)
+//
+// Records the start of an operation that is being measured
+//
+// Arguments:
+//
+//	operation	- Operation that is starting
+
+__int64 PerformanceCounters::StartOperation(PerformanceOperation operation)
+{
+	__int64 now = Stopwatch::GetTimestamp();
+
+	if(s_tracing) TraceRecorder::Record(operation, L'B', now, nullptr);
+	return now;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
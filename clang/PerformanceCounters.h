@@ -0,0 +1,237 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __PERFORMANCECOUNTERS_H_
+#define __PERFORMANCECOUNTERS_H_
+#pragma once
+
+#include "PerformanceOperation.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class PerformanceCounters
+//
+// Process-wide counters for the time spent in libclang operations, the
+// number of wrapper objects created, safe handle references and finalizer
+// runs.  Collection is disabled by default; while disabled, and while the
+// ClangEventSource has no listeners and no TraceRecorder is recording, each
+// instrumentation point costs a single static field test
+//---------------------------------------------------------------------------
+
+public ref class PerformanceCounters abstract sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetObjectCounts (static)
+	//
+	// Gets the number of wrapper objects created, keyed by type name
+	static IDictionary<String^, Int64>^ GetObjectCounts(void);
+
+	// GetOperationCount (static)
+	//
+	// Gets the number of times an operation has completed
+	static Int64 GetOperationCount(PerformanceOperation operation);
+
+	// GetOperationTime (static)
+	//
+	// Gets the total time spent in an operation
+	static TimeSpan GetOperationTime(PerformanceOperation operation);
+
+	// Reset (static)
+	//
+	// Resets all of the counters to zero
+	static void Reset(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Enabled (static)
+	//
+	// Gets/sets a flag indicating if the counters are being collected
+	static property bool Enabled
+	{
+		bool get(void);
+		void set(bool value);
+	}
+
+	// FinalizerCount (static)
+	//
+	// Gets the number of handles released by a finalizer rather than disposed
+	static property Int64 FinalizerCount
+	{
+		Int64 get(void);
+	}
+
+	// HandleAddRefCount (static)
+	//
+	// Gets the number of references taken against safe handles
+	static property Int64 HandleAddRefCount
+	{
+		Int64 get(void);
+	}
+
+	// HandleReleaseCount (static)
+	//
+	// Gets the number of references released against safe handles
+	static property Int64 HandleReleaseCount
+	{
+		Int64 get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Data Types
+
+	// Enum ObjectType
+	//
+	// Wrapper object types that are counted
+	enum class ObjectType
+	{
+		Comment			= 0,
+		Cursor			= 1,
+		Diagnostic		= 2,
+		Extent			= 3,
+		File			= 4,
+		Location		= 5,
+		Token			= 6,
+		TranslationUnit	= 7,
+		Type			= 8,
+	};
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// BeginOperation (static)
+	//
+	// Gets the starting timestamp of an operation, or zero if not being measured
+	static __int64 BeginOperation(PerformanceOperation operation)
+	{
+		return (s_enabled || s_listening || s_tracing) ? StartOperation(operation) : 0;
+	}
+
+	// EndOperation (static)
+	//
+	// Records the completion of an operation started with BeginOperation
+	static void EndOperation(PerformanceOperation operation, __int64 start, String^ filename);
+
+	// Finalized (static)
+	//
+	// Records that a handle was released by a finalizer
+	static void Finalized(void)
+	{
+		if(s_enabled) Interlocked::Increment(s_finalizers);
+	}
+
+	// HandleAddRef (static)
+	//
+	// Records that a reference was taken against a safe handle
+	static void HandleAddRef(void)
+	{
+		if(s_enabled) Interlocked::Increment(s_addrefs);
+	}
+
+	// HandleRelease (static)
+	//
+	// Records that a reference was released against a safe handle
+	static void HandleRelease(void)
+	{
+		if(s_enabled) Interlocked::Increment(s_releases);
+	}
+
+	// ObjectCreated (static)
+	//
+	// Records that a wrapper object was created
+	static void ObjectCreated(ObjectType type)
+	{
+		if(s_enabled) Interlocked::Increment(s_objects[static_cast<int>(type)]);
+	}
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Listening (static)
+	//
+	// Gets/sets a flag indicating if ClangEventSource has any listeners
+	static property bool Listening
+	{
+		bool get(void) { return s_listening; }
+		void set(bool value) { s_listening = value; }
+	}
+
+	// Tracing (static)
+	//
+	// Gets/sets a flag indicating if a TraceRecorder is recording
+	static property bool Tracing
+	{
+		bool get(void) { return s_tracing; }
+		void set(bool value) { s_tracing = value; }
+	}
+
+private:
+
+	// Static Constructor
+	//
+	static PerformanceCounters();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// StartOperation (static)
+	//
+	// Records the start of an operation that is being measured
+	static __int64 StartOperation(PerformanceOperation operation);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	static bool						s_enabled;		// Collection flag
+	static bool						s_listening;	// Event listener flag
+	static bool						s_tracing;		// Trace recording flag
+	static __int64					s_addrefs;		// Handle AddRef count
+	static __int64					s_releases;		// Handle Release count
+	static __int64					s_finalizers;	// Finalizer count
+	static initonly array<__int64>^	s_opcounts;		// Counts by PerformanceOperation
+	static initonly array<__int64>^	s_opticks;		// Stopwatch ticks by PerformanceOperation
+	static initonly array<__int64>^	s_objects;		// Counts by ObjectType
+	static initonly array<String^>^	s_objectnames;	// Names by ObjectType
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __PERFORMANCECOUNTERS_H_
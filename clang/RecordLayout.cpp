@@ -0,0 +1,409 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "RecordLayout.h"
+
+#include "AutoGCHandle.h"
+#include "CursorKind.h"
+#include "GCHandleRef.h"
+#include "StringInterner.h"
+#include "TranslationUnit.h"
+#include "TranslationUnitHandle.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// AddFieldCallback (local)
+//
+// Callback for clang_Type_visitFields() that adds each field of a record
+//
+// Arguments:
+//
+//	cursor			- Current unmanaged CXCursor instance being enumerated
+//	context			- Context pointer passed into clang_Type_visitFields
+
+static CXVisitorResult AddFieldCallback(CXCursor cursor, CXClientData context)
+{
+	GCHandleRef<RecordLayout::Builder^> builder(context);
+	return builder->AddField(cursor);
+}
+
+//---------------------------------------------------------------------------
+// AddRecordCallback (local)
+//
+// Callback for clang_visitChildren() that adds each complete record declaration
+//
+// Arguments:
+//
+//	cursor			- Current unmanaged CXCursor instance being enumerated
+//	parent			- Parent CXCursor instance
+//	context			- Context pointer passed into clang_visitChildren
+
+static CXChildVisitResult AddRecordCallback(CXCursor cursor, CXCursor parent, CXClientData context)
+{
+	GCHandleRef<RecordLayout::Builder^> builder(context);
+	return builder->AddRecord(cursor, parent);
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout Constructor (private)
+//
+// Arguments:
+//
+//	builder		- Builder that contains the extracted rows
+
+RecordLayout::RecordLayout(Builder^ builder)
+{
+	if(Object::ReferenceEquals(builder, nullptr)) throw gcnew ArgumentNullException("builder");
+
+	m_names = builder->Names->ToArray();
+	m_kinds = builder->Kinds->ToArray();
+	m_sizes = builder->Sizes->ToArray();
+	m_alignments = builder->Alignments->ToArray();
+	m_parents = builder->Parents->ToArray();
+	m_anonymous = builder->Anonymous->ToArray();
+
+	// The field start indices have a trailing element for the final record
+	m_fieldstarts = gcnew array<int>(builder->FieldStarts->Count + 1);
+	builder->FieldStarts->CopyTo(m_fieldstarts);
+	m_fieldstarts[builder->FieldStarts->Count] = builder->FieldNames->Count;
+
+	m_fieldnames = builder->FieldNames->ToArray();
+	m_fieldtypes = builder->FieldTypes->ToArray();
+	m_fieldoffsets = builder->FieldOffsets->ToArray();
+	m_fieldwidths = builder->FieldWidths->ToArray();
+
+	// Field types can only be resolved once every record has been visited, nested
+	// record definitions are visited after the fields of the enclosing record
+	m_fieldrecords = gcnew array<int>(builder->FieldKeys->Count);
+	for(int index = 0; index < m_fieldrecords->Length; index++) {
+
+		int record;						// Record row index
+
+		m_fieldrecords[index] = (builder->RecordIds->TryGetValue(builder->FieldKeys[index], record)) ? record : -1;
+	}
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Alignments::get
+//
+// Gets the alignment of each record in bytes
+
+array<__int64>^ RecordLayout::Alignments::get(void)
+{
+	return m_alignments;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Count::get
+//
+// Gets the number of records in the table
+
+int RecordLayout::Count::get(void)
+{
+	return m_names->Length;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::ExtractAll (static)
+//
+// Extracts the layout of every complete record in a translation unit
+//
+// Arguments:
+//
+//	transunit	- Translation unit from which to extract the record layouts
+
+RecordLayout^ RecordLayout::ExtractAll(TranslationUnit^ transunit)
+{
+	if(Object::ReferenceEquals(transunit, nullptr)) throw gcnew ArgumentNullException("transunit");
+
+	TranslationUnitHandle::Reference handle(transunit->Handle);
+	Builder^ builder = gcnew Builder();
+
+	// Visit the entire translation unit, records can be declared within other
+	// records, namespaces and function bodies
+	clang_visitChildren(clang_getTranslationUnitCursor(handle), AddRecordCallback, AutoGCHandle(builder));
+
+	// Check if an exception occurred during the visitation and re-throw it
+	if(!Object::ReferenceEquals(builder->Error, nullptr)) throw builder->Error;
+
+	return gcnew RecordLayout(builder);
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldBitOffsets::get
+//
+// Gets the offset of each field from the start of its record in bits
+
+array<__int64>^ RecordLayout::FieldBitOffsets::get(void)
+{
+	return m_fieldoffsets;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldBitWidths::get
+//
+// Gets the bit width of each field, or -1 if the field is not a bit field
+
+array<int>^ RecordLayout::FieldBitWidths::get(void)
+{
+	return m_fieldwidths;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldCount::get
+//
+// Gets the number of fields in the table
+
+int RecordLayout::FieldCount::get(void)
+{
+	return m_fieldnames->Length;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldNames::get
+//
+// Gets the name of each field, anonymous fields have an empty name
+
+array<String^>^ RecordLayout::FieldNames::get(void)
+{
+	return m_fieldnames;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldRecordIndices::get
+//
+// Gets the record row index of the type of each field, or -1
+
+array<int>^ RecordLayout::FieldRecordIndices::get(void)
+{
+	return m_fieldrecords;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldStartIndices::get
+//
+// Gets the index of the first field of each record, including a trailing
+// element that holds the total number of fields
+
+array<int>^ RecordLayout::FieldStartIndices::get(void)
+{
+	return m_fieldstarts;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::FieldTypeNames::get
+//
+// Gets the type spelling of each field
+
+array<String^>^ RecordLayout::FieldTypeNames::get(void)
+{
+	return m_fieldtypes;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::GetRecordKey (private, static)
+//
+// Gets the key used to identify a record definition within the translation unit
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor that refers to the record declaration
+
+IntPtr RecordLayout::GetRecordKey(CXCursor cursor)
+{
+	// The first data member of a declaration cursor is the declaration itself, which is
+	// unique for the definition no matter which path was taken to locate it
+	CXCursor definition = clang_getCursorDefinition(cursor);
+	return (clang_Cursor_isNull(definition)) ? IntPtr::Zero : IntPtr(const_cast<void*>(definition.data[0]));
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::IsAnonymous::get
+//
+// Gets a flag indicating if each record is anonymous
+
+array<bool>^ RecordLayout::IsAnonymous::get(void)
+{
+	return m_anonymous;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Kinds::get
+//
+// Gets the cursor kind of the declaration of each record
+
+array<CursorKind>^ RecordLayout::Kinds::get(void)
+{
+	return m_kinds;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Names::get
+//
+// Gets the type spelling of each record
+
+array<String^>^ RecordLayout::Names::get(void)
+{
+	return m_names;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::ParentIndices::get
+//
+// Gets the row index of the record that encloses each record, or -1
+
+array<int>^ RecordLayout::ParentIndices::get(void)
+{
+	return m_parents;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Sizes::get
+//
+// Gets the size of each record in bytes
+
+array<__int64>^ RecordLayout::Sizes::get(void)
+{
+	return m_sizes;
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Builder Constructor
+//
+// Arguments:
+//
+//	NONE
+
+RecordLayout::Builder::Builder()
+{
+	Strings = gcnew StringInterner();
+	RecordIds = gcnew Dictionary<IntPtr, int>();
+
+	Names = gcnew List<String^>();
+	Kinds = gcnew List<CursorKind>();
+	Sizes = gcnew List<__int64>();
+	Alignments = gcnew List<__int64>();
+	Parents = gcnew List<int>();
+	Anonymous = gcnew List<bool>();
+	FieldStarts = gcnew List<int>();
+
+	FieldNames = gcnew List<String^>();
+	FieldTypes = gcnew List<String^>();
+	FieldOffsets = gcnew List<__int64>();
+	FieldWidths = gcnew List<int>();
+	FieldKeys = gcnew List<IntPtr>();
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Builder::AddField
+//
+// Adds a field of the record currently being extracted
+//
+// Arguments:
+//
+//	cursor		- Unmanaged field declaration cursor
+
+CXVisitorResult RecordLayout::Builder::AddField(CXCursor cursor)
+{
+	try {
+
+		CXType type = clang_getCursorType(cursor);
+
+		// clang_Cursor_getOffsetOfField works for anonymous fields, unlike clang_Type_getOffsetOf
+		long long offset = clang_Cursor_getOffsetOfField(cursor);
+
+		FieldNames->Add(Strings->Intern(clang_getCursorSpelling(cursor)));
+		FieldTypes->Add(Strings->Intern(clang_getTypeSpelling(type)));
+		FieldOffsets->Add((offset < 0) ? -1 : offset);
+		FieldWidths->Add((clang_Cursor_isBitField(cursor) != 0) ? clang_getFieldDeclBitWidth(cursor) : -1);
+		FieldKeys->Add(GetRecordKey(clang_getTypeDeclaration(clang_getCanonicalType(type))));
+
+		return CXVisitorResult::CXVisit_Continue;
+	}
+
+	catch(Exception^ exception) { Error = exception; return CXVisitorResult::CXVisit_Break; }
+}
+
+//---------------------------------------------------------------------------
+// RecordLayout::Builder::AddRecord
+//
+// Adds a record declaration to the table if it is a complete record
+//
+// Arguments:
+//
+//	cursor		- Unmanaged cursor being visited
+//	parent		- Unmanaged parent of the cursor being visited
+
+CXChildVisitResult RecordLayout::Builder::AddRecord(CXCursor cursor, CXCursor parent)
+{
+	CXCursorKind kind = clang_getCursorKind(cursor);
+
+	// Only record definitions are of interest, but every cursor needs to be recursed
+	// into since records can be declared pretty much anywhere
+	if((kind != CXCursorKind::CXCursor_StructDecl) && (kind != CXCursorKind::CXCursor_UnionDecl) && 
+		(kind != CXCursorKind::CXCursor_ClassDecl)) return CXChildVisitResult::CXChildVisit_Recurse;
+
+	if(clang_isCursorDefinition(cursor) == 0) return CXChildVisitResult::CXChildVisit_Recurse;
+
+	try {
+
+		// Dependent and invalid records have no layout, the size and alignment are
+		// reported as negative error codes in that case
+		CXType type = clang_getCursorType(cursor);
+		long long size = clang_Type_getSizeOf(type);
+		long long alignment = clang_Type_getAlignOf(type);
+		if((size < 0) || (alignment < 0)) return CXChildVisitResult::CXChildVisit_Recurse;
+
+		IntPtr key = GetRecordKey(cursor);
+		if(RecordIds->ContainsKey(key)) return CXChildVisitResult::CXChildVisit_Recurse;
+
+		int parentid;						// Parent record row index
+		if(!RecordIds->TryGetValue(GetRecordKey(parent), parentid)) parentid = -1;
+
+		RecordIds->Add(key, Names->Count);
+
+		Names->Add(Strings->Intern(clang_getTypeSpelling(type)));
+		Kinds->Add(CursorKind(kind));
+		Sizes->Add(size);
+		Alignments->Add(alignment);
+		Parents->Add(parentid);
+		Anonymous->Add(clang_Cursor_isAnonymous(cursor) != 0);
+		FieldStarts->Add(FieldNames->Count);
+
+		clang_Type_visitFields(type, AddFieldCallback, AutoGCHandle(this));
+
+		return (Object::ReferenceEquals(Error, nullptr)) ? CXChildVisitResult::CXChildVisit_Recurse : CXChildVisitResult::CXChildVisit_Break;
+	}
+
+	catch(Exception^ exception) { Error = exception; return CXChildVisitResult::CXChildVisit_Break; }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
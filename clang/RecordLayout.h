@@ -0,0 +1,263 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __RECORDLAYOUT_H_
+#define __RECORDLAYOUT_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+value class CursorKind;
+ref class	StringInterner;
+ref class	TranslationUnit;
+
+//---------------------------------------------------------------------------
+// Class RecordLayout
+//
+// Columnar table of the layout of every complete record in a translation
+// unit.  Each record row refers to a contiguous range of field rows via
+// FieldStartIndices; nested and anonymous records are rows of their own that
+// refer back to the enclosing record via ParentIndices
+//---------------------------------------------------------------------------
+
+public ref class RecordLayout
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ExtractAll (static)
+	//
+	// Extracts the layout of every complete record in a translation unit
+	static RecordLayout^ ExtractAll(TranslationUnit^ transunit);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Alignments
+	//
+	// Gets the alignment of each record in bytes
+	property array<__int64>^ Alignments
+	{
+		array<__int64>^ get(void);
+	}
+
+	// Count
+	//
+	// Gets the number of records in the table
+	property int Count
+	{
+		int get(void);
+	}
+
+	// FieldBitOffsets
+	//
+	// Gets the offset of each field from the start of its record in bits
+	property array<__int64>^ FieldBitOffsets
+	{
+		array<__int64>^ get(void);
+	}
+
+	// FieldBitWidths
+	//
+	// Gets the bit width of each field, or -1 if the field is not a bit field
+	property array<int>^ FieldBitWidths
+	{
+		array<int>^ get(void);
+	}
+
+	// FieldCount
+	//
+	// Gets the number of fields in the table
+	property int FieldCount
+	{
+		int get(void);
+	}
+
+	// FieldNames
+	//
+	// Gets the name of each field, anonymous fields have an empty name
+	property array<String^>^ FieldNames
+	{
+		array<String^>^ get(void);
+	}
+
+	// FieldRecordIndices
+	//
+	// Gets the record row index of the type of each field, or -1
+	property array<int>^ FieldRecordIndices
+	{
+		array<int>^ get(void);
+	}
+
+	// FieldStartIndices
+	//
+	// Gets the index of the first field of each record, including a trailing
+	// element that holds the total number of fields
+	property array<int>^ FieldStartIndices
+	{
+		array<int>^ get(void);
+	}
+
+	// FieldTypeNames
+	//
+	// Gets the type spelling of each field
+	property array<String^>^ FieldTypeNames
+	{
+		array<String^>^ get(void);
+	}
+
+	// IsAnonymous
+	//
+	// Gets a flag indicating if each record is anonymous
+	property array<bool>^ IsAnonymous
+	{
+		array<bool>^ get(void);
+	}
+
+	// Kinds
+	//
+	// Gets the cursor kind of the declaration of each record
+	property array<CursorKind>^ Kinds
+	{
+		array<CursorKind>^ get(void);
+	}
+
+	// Names
+	//
+	// Gets the type spelling of each record
+	property array<String^>^ Names
+	{
+		array<String^>^ get(void);
+	}
+
+	// ParentIndices
+	//
+	// Gets the row index of the record that encloses each record, or -1
+	property array<int>^ ParentIndices
+	{
+		array<int>^ get(void);
+	}
+
+	// Sizes
+	//
+	// Gets the size of each record in bytes
+	property array<__int64>^ Sizes
+	{
+		array<__int64>^ get(void);
+	}
+
+internal:
+
+	// Builder
+	//
+	// Accumulates the rows of the table while the translation unit is visited
+	ref class Builder
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Builder();
+
+		//-------------------------------------------------------------------
+		// Member Functions
+
+		// AddField
+		//
+		// Adds a field of the record currently being extracted
+		CXVisitorResult AddField(CXCursor cursor);
+
+		// AddRecord
+		//
+		// Adds a record declaration to the table if it is a complete record
+		CXChildVisitResult AddRecord(CXCursor cursor, CXCursor parent);
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		StringInterner^				Strings;		// Interned strings
+		Dictionary<IntPtr, int>^	RecordIds;		// Record rows by type
+		Exception^					Error;			// Exception during extraction
+
+		List<String^>^				Names;			// Record names
+		List<CursorKind>^			Kinds;			// Record kinds
+		List<__int64>^				Sizes;			// Record sizes
+		List<__int64>^				Alignments;		// Record alignments
+		List<int>^					Parents;		// Record parent rows
+		List<bool>^					Anonymous;		// Record anonymous flags
+		List<int>^					FieldStarts;	// Record first field rows
+
+		List<String^>^				FieldNames;		// Field names
+		List<String^>^				FieldTypes;		// Field type names
+		List<__int64>^				FieldOffsets;	// Field offsets in bits
+		List<int>^					FieldWidths;	// Field bit widths
+		List<IntPtr>^				FieldKeys;		// Field record type keys
+	};
+
+private:
+
+	// Instance Constructor
+	//
+	RecordLayout(Builder^ builder);
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetRecordKey (static)
+	//
+	// Gets the key used to identify a record definition within the translation unit
+	static IntPtr GetRecordKey(CXCursor cursor);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	array<String^>^			m_names;			// Record names
+	array<CursorKind>^		m_kinds;			// Record kinds
+	array<__int64>^			m_sizes;			// Record sizes
+	array<__int64>^			m_alignments;		// Record alignments
+	array<int>^				m_parents;			// Record parent rows
+	array<bool>^			m_anonymous;		// Record anonymous flags
+	array<int>^				m_fieldstarts;		// Record first field rows
+	array<String^>^			m_fieldnames;		// Field names
+	array<String^>^			m_fieldtypes;		// Field type names
+	array<__int64>^			m_fieldoffsets;		// Field offsets in bits
+	array<int>^				m_fieldwidths;		// Field bit widths
+	array<int>^				m_fieldrecords;		// Field record rows
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __RECORDLAYOUT_H_
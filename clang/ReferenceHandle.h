@@ -24,6 +24,8 @@
 #define __REFERENCEHANDLE_H_
 #pragma once
 
+#include "PerformanceCounters.h"
+
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
@@ -72,13 +74,18 @@ public:
 			// AddRef the safe handle that owns this reference during construction
 			m_handle->m_owner->DangerousAddRef(m_release);
  			if(!m_release) throw gcnew ObjectDisposedException(m_handle->m_owner->GetType()->Name);
+
+			PerformanceCounters::HandleAddRef();
 		}
 
 		// Destructor
 		//
 		~Reference() 
 		{ 
-			if(m_release) m_handle->m_owner->DangerousRelease(); 
+			if(!m_release) return;
+
+			m_handle->m_owner->DangerousRelease();
+			PerformanceCounters::HandleRelease();
 		}
 
 		// pointer-to-member operator
@@ -117,14 +124,16 @@ private:
 	~ReferenceHandle()
 	{
 		if(m_disposed) return;
-		this->!ReferenceHandle();
 		m_disposed = true;
+		this->!ReferenceHandle();
 	}
 
 	// Finalizer
 	//
 	!ReferenceHandle()
 	{
+		if(!m_disposed) PerformanceCounters::Finalized();
+
 		if(m_pointer) delete m_pointer;
 		m_pointer = __nullptr;
 	}
@@ -0,0 +1,217 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "SerializedDiagnostic.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic Constructor (private)
+//
+// Arguments:
+//
+//	severity	- Severity level of the diagnostic
+//	filename	- Name of the file in which the diagnostic is located
+//	line		- Line number of the diagnostic location
+//	column		- Column number of the diagnostic location
+//	offset		- File offset of the diagnostic location
+//	category	- Category text of the diagnostic
+//	option		- Name of the flag that controls the diagnostic
+//	spelling	- Text of the diagnostic
+
+SerializedDiagnostic::SerializedDiagnostic(DiagnosticSeverity severity, String^ filename, int line, int column, int offset, String^ category,
+	String^ option, String^ spelling) : m_severity(severity), m_filename(filename), m_line(line), m_column(column), m_offset(offset), 
+	m_category(category), m_option(option), m_spelling(spelling)
+{
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+	if(Object::ReferenceEquals(category, nullptr)) throw gcnew ArgumentNullException("category");
+	if(Object::ReferenceEquals(option, nullptr)) throw gcnew ArgumentNullException("option");
+	if(Object::ReferenceEquals(spelling, nullptr)) throw gcnew ArgumentNullException("spelling");
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::AddChild (internal)
+//
+// Attaches a note to this diagnostic
+//
+// Arguments:
+//
+//	child		- Note to be attached to the diagnostic
+
+void SerializedDiagnostic::AddChild(SerializedDiagnostic^ child)
+{
+	if(Object::ReferenceEquals(child, nullptr)) throw gcnew ArgumentNullException("child");
+
+	if(Object::ReferenceEquals(m_children, nullptr)) m_children = gcnew List<SerializedDiagnostic^>();
+	m_children->Add(child);
+	m_readonly = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Category::get
+//
+// Gets the category text of the diagnostic
+
+String^ SerializedDiagnostic::Category::get(void)
+{
+	return m_category;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Children::get
+//
+// Gets the notes attached to this diagnostic
+
+ReadOnlyCollection<SerializedDiagnostic^>^ SerializedDiagnostic::Children::get(void)
+{
+	if(Object::ReferenceEquals(m_children, nullptr)) m_children = gcnew List<SerializedDiagnostic^>();
+	if(Object::ReferenceEquals(m_readonly, nullptr)) m_readonly = m_children->AsReadOnly();
+
+	return m_readonly;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Column::get
+//
+// Gets the column number of the diagnostic location
+
+int SerializedDiagnostic::Column::get(void)
+{
+	return m_column;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Create (internal, static)
+//
+// Creates a new SerializedDiagnostic instance
+//
+// Arguments:
+//
+//	severity	- Severity level of the diagnostic
+//	filename	- Name of the file in which the diagnostic is located
+//	line		- Line number of the diagnostic location
+//	column		- Column number of the diagnostic location
+//	offset		- File offset of the diagnostic location
+//	category	- Category text of the diagnostic
+//	option		- Name of the flag that controls the diagnostic
+//	spelling	- Text of the diagnostic
+
+SerializedDiagnostic^ SerializedDiagnostic::Create(DiagnosticSeverity severity, String^ filename, int line, int column, int offset, String^ category,
+	String^ option, String^ spelling)
+{
+	return gcnew SerializedDiagnostic(severity, filename, line, column, offset, category, option, spelling);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::DisableOption::get
+//
+// Gets the command line option that disables the diagnostic
+
+String^ SerializedDiagnostic::DisableOption::get(void)
+{
+	// Match the option strings generated by libclang for loaded diagnostics
+	return (m_option->Length == 0) ? String::Empty : String::Concat("-Wno-", m_option);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::EnableOption::get
+//
+// Gets the command line option that enables the diagnostic
+
+String^ SerializedDiagnostic::EnableOption::get(void)
+{
+	return (m_option->Length == 0) ? String::Empty : String::Concat("-W", m_option);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::FileName::get
+//
+// Gets the name of the file in which the diagnostic is located
+
+String^ SerializedDiagnostic::FileName::get(void)
+{
+	return m_filename;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Line::get
+//
+// Gets the line number of the diagnostic location
+
+int SerializedDiagnostic::Line::get(void)
+{
+	return m_line;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Offset::get
+//
+// Gets the file offset of the diagnostic location
+
+int SerializedDiagnostic::Offset::get(void)
+{
+	return m_offset;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Severity::get
+//
+// Gets the severity level of the diagnostic
+
+DiagnosticSeverity SerializedDiagnostic::Severity::get(void)
+{
+	return m_severity;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::Spelling::get
+//
+// Gets the text of the diagnostic
+
+String^ SerializedDiagnostic::Spelling::get(void)
+{
+	return m_spelling;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnostic::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ SerializedDiagnostic::ToString(void)
+{
+	// [File]:[Line]:[Column]: [Severity]: [Spelling]
+	return String::Format("{0}:{1}:{2}: {3}: {4}", m_filename, m_line, m_column, m_severity.ToString(), m_spelling);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
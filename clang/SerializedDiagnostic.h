@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SERIALIZEDDIAGNOSTIC_H_
+#define __SERIALIZEDDIAGNOSTIC_H_
+#pragma once
+
+#include "DiagnosticSeverity.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class SerializedDiagnostic
+//
+// Represents a diagnostic read from a serialized diagnostics file by a
+// SerializedDiagnosticReader.  Unlike Diagnostic, instances do not refer to
+// any unmanaged resources and remain valid after the reader is disposed of
+//---------------------------------------------------------------------------
+
+public ref class SerializedDiagnostic
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Category
+	//
+	// Gets the category text of the diagnostic
+	property String^ Category
+	{
+		String^ get(void);
+	}
+
+	// Children
+	//
+	// Gets the notes attached to this diagnostic, in the order they were serialized
+	property ReadOnlyCollection<SerializedDiagnostic^>^ Children
+	{
+		ReadOnlyCollection<SerializedDiagnostic^>^ get(void);
+	}
+
+	// Column
+	//
+	// Gets the column number of the diagnostic location
+	property int Column
+	{
+		int get(void);
+	}
+
+	// DisableOption
+	//
+	// Gets the command line option that disables the diagnostic
+	property String^ DisableOption
+	{
+		String^ get(void);
+	}
+
+	// EnableOption
+	//
+	// Gets the command line option that enables the diagnostic
+	property String^ EnableOption
+	{
+		String^ get(void);
+	}
+
+	// FileName
+	//
+	// Gets the name of the file in which the diagnostic is located
+	property String^ FileName
+	{
+		String^ get(void);
+	}
+
+	// Line
+	//
+	// Gets the line number of the diagnostic location
+	property int Line
+	{
+		int get(void);
+	}
+
+	// Offset
+	//
+	// Gets the file offset of the diagnostic location
+	property int Offset
+	{
+		int get(void);
+	}
+
+	// Severity
+	//
+	// Gets the severity level of the diagnostic
+	property DiagnosticSeverity Severity
+	{
+		DiagnosticSeverity get(void);
+	}
+
+	// Spelling
+	//
+	// Gets the text of the diagnostic
+	property String^ Spelling
+	{
+		String^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AddChild
+	//
+	// Attaches a note to this diagnostic
+	void AddChild(SerializedDiagnostic^ child);
+
+	// Create (static)
+	//
+	// Creates a new SerializedDiagnostic instance
+	static SerializedDiagnostic^ Create(DiagnosticSeverity severity, String^ filename, int line, int column, int offset, String^ category,
+		String^ option, String^ spelling);
+
+private:
+
+	// Instance Constructor
+	//
+	SerializedDiagnostic(DiagnosticSeverity severity, String^ filename, int line, int column, int offset, String^ category,
+		String^ option, String^ spelling);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	DiagnosticSeverity				m_severity;			// Diagnostic severity
+	String^							m_filename;			// Location file name
+	int								m_line;				// Location line number
+	int								m_column;			// Location column number
+	int								m_offset;			// Location file offset
+	String^							m_category;			// Category text
+	String^							m_option;			// Diagnostic flag name
+	String^							m_spelling;			// Diagnostic text
+	List<SerializedDiagnostic^>^	m_children;			// Attached notes
+	ReadOnlyCollection<SerializedDiagnostic^>^	m_readonly;	// Cached read-only wrapper
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __SERIALIZEDDIAGNOSTIC_H_
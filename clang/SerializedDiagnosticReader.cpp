@@ -0,0 +1,965 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "SerializedDiagnosticReader.h"
+
+#include "DiagnosticLoadErrorCode.h"
+#include "DiagnosticLoadException.h"
+#include "DiagnosticSeverity.h"
+#include "SerializedDiagnostic.h"
+#include "StringUtil.h"
+
+#include <vcclr.h>
+
+using namespace System::ComponentModel;
+using namespace System::Threading::Tasks;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+// BLOCK_META, BLOCK_DIAG (local)
+//
+// Serialized diagnostics block identifiers (clang/Frontend/SerializedDiagnostics.h)
+static const unsigned int BLOCK_META = 8;
+static const unsigned int BLOCK_DIAG = 9;
+
+// RECORD_XXXX (local)
+//
+// Serialized diagnostics record codes (clang/Frontend/SerializedDiagnostics.h)
+static const unsigned int RECORD_VERSION = 1;
+static const unsigned int RECORD_DIAG = 2;
+static const unsigned int RECORD_DIAG_FLAG = 4;
+static const unsigned int RECORD_CATEGORY = 5;
+static const unsigned int RECORD_FILENAME = 6;
+
+// LEVEL_REMARK (local)
+//
+// Serialized diagnostic level used for remarks, which have no CXDiagnosticSeverity
+static const uint64_t LEVEL_REMARK = 5;
+
+// MAX_ABBREV_OPERANDS (local)
+//
+// Maximum number of operands in an abbreviation definition
+static const int MAX_ABBREV_OPERANDS = 16;
+
+// MAX_ABBREVS (local)
+//
+// Maximum number of abbreviation definitions that can be in scope
+static const int MAX_ABBREVS = 128;
+
+// MAX_DEPTH (local)
+//
+// Maximum supported block nesting depth
+static const int MAX_DEPTH = 32;
+
+// MAX_FIELDS (local)
+//
+// Maximum number of numeric record fields retained
+static const int MAX_FIELDS = 16;
+
+// TEXT_BUFFER_SIZE (local)
+//
+// Size of the buffer used for strings that are not encoded as blobs
+static const int TEXT_BUFFER_SIZE = 4096;
+
+//---------------------------------------------------------------------------
+// UNMANAGED SCANNER
+//
+// The serialized diagnostics file is an LLVM bitstream.  The scanner is
+// compiled as native code and decodes the stream directly from the mapped
+// view of the file; blob strings are referenced in place rather than copied.
+// Only the blocks and records used by serialized diagnostics are interpreted,
+// source ranges and fix-its are skipped
+//---------------------------------------------------------------------------
+
+#pragma managed(push, off)
+
+// BitcodeEncoding
+//
+// Abbreviation operand encodings
+enum BitcodeEncoding : uint8_t { EncodingLiteral = 0, EncodingFixed = 1, EncodingVBR = 2, EncodingArray = 3, EncodingChar6 = 4, EncodingBlob = 5 };
+
+// DiagnosticRecordKind
+//
+// Kinds of records returned by the scanner
+enum DiagnosticRecordKind : uint8_t { RecordNone, RecordEndOfFile, RecordInvalid, RecordVersion, RecordDiagnostic, RecordEndDiagnostic, 
+	RecordFileName, RecordCategory, RecordFlag };
+
+// BitcodeAbbrev
+//
+// Abbreviation definition
+struct BitcodeAbbrev
+{
+	unsigned int	blockid;								// Owning block identifier
+	int				numoperands;							// Number of operands
+	BitcodeEncoding	encodings[MAX_ABBREV_OPERANDS];			// Operand encodings
+	uint64_t		values[MAX_ABBREV_OPERANDS];			// Literal values / widths
+};
+
+// BitstreamScope
+//
+// Block nesting level
+struct BitstreamScope
+{
+	unsigned int	blockid;				// Block identifier
+	unsigned int	abbrevwidth;			// Abbreviation id width
+	int				firstabbrev;			// First local abbreviation
+};
+
+// DiagnosticStreamState
+//
+// Scanner state and the most recently scanned record
+struct DiagnosticStreamState
+{
+	const uint8_t*	data;									// Serialized data
+	size_t			length;									// Length of the data
+	uint64_t		bitlength;								// Length of the data in bits
+	uint64_t		position;								// Current bit position
+	int				depth;									// Block nesting depth
+	int				diagdepth;								// Diagnostic block depth
+	BitstreamScope	scopes[MAX_DEPTH];						// Block nesting levels
+	int				numabbrevs;								// Local abbreviations
+	BitcodeAbbrev	abbrevs[MAX_ABBREVS];					// Local abbreviations
+	int				numinfoabbrevs;							// BLOCKINFO abbreviations
+	BitcodeAbbrev	infoabbrevs[MAX_ABBREVS];				// BLOCKINFO abbreviations
+	unsigned int	code;									// Record code
+	int				numfields;								// Record field count
+	uint64_t		fields[MAX_FIELDS];						// Record fields
+	const char*		text;									// Record string
+	size_t			textlength;								// Record string length
+	char			textbuffer[TEXT_BUFFER_SIZE];			// Non-blob record string
+};
+
+//---------------------------------------------------------------------------
+// AlignWord (local)
+//
+// Advances the bit position to the next 32-bit boundary
+//
+// Arguments:
+//
+//	state		- Scanner state
+
+static inline bool AlignWord(DiagnosticStreamState& state)
+{
+	state.position = (state.position + 31) & ~static_cast<uint64_t>(31);
+	return (state.position <= state.bitlength);
+}
+
+//---------------------------------------------------------------------------
+// RemainingBits (local)
+//
+// Gets the number of bits left in the bitstream
+//
+// Arguments:
+//
+//	state		- Scanner state
+
+static inline uint64_t RemainingBits(const DiagnosticStreamState& state)
+{
+	return (state.position < state.bitlength) ? state.bitlength - state.position : 0;
+}
+
+//---------------------------------------------------------------------------
+// ReadFixed (local)
+//
+// Reads a fixed-width value from the bitstream
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	width		- Width of the value in bits
+//	value		- On success, receives the value
+
+static inline bool ReadFixed(DiagnosticStreamState& state, unsigned int width, uint64_t& value)
+{
+	value = 0;
+	if(width == 0) return true;
+	if((width > 64) || (state.position + width > state.bitlength)) return false;
+
+	size_t byte = static_cast<size_t>(state.position >> 3);
+	unsigned int bit = static_cast<unsigned int>(state.position & 7);
+
+	// Load 8 bytes at a time when available, this covers any width up to 56 bits
+	if((width <= 56) && (byte + 8 <= state.length)) {
+
+		uint64_t word;
+		memcpy(&word, state.data + byte, sizeof(uint64_t));
+		value = (word >> bit) & ((1ULL << width) - 1);
+	}
+
+	else {
+
+		for(unsigned int read = 0; read < width; ) {
+
+			unsigned int take = 8 - bit;
+			if(take > width - read) take = width - read;
+
+			value |= static_cast<uint64_t>((state.data[byte] >> bit) & ((1U << take) - 1)) << read;
+			read += take;
+			byte++;
+			bit = 0;
+		}
+	}
+
+	state.position += width;
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// ReadVBR (local)
+//
+// Reads a variable bit rate value from the bitstream
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	width		- Width of each chunk in bits
+//	value		- On success, receives the value
+
+static inline bool ReadVBR(DiagnosticStreamState& state, unsigned int width, uint64_t& value)
+{
+	uint64_t			chunk;				// Current chunk
+
+	value = 0;
+	if((width < 2) || (width > 32)) return false;
+
+	uint64_t continuation = 1ULL << (width - 1);
+
+	for(unsigned int shift = 0; ; shift += (width - 1)) {
+
+		if(shift >= 64) return false;
+		if(!ReadFixed(state, width, chunk)) return false;
+
+		value |= (chunk & (continuation - 1)) << shift;
+		if((chunk & continuation) == 0) return true;
+	}
+}
+
+//---------------------------------------------------------------------------
+// ReadAbbrevDefinition (local)
+//
+// Reads a DEFINE_ABBREV definition from the bitstream
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	abbrev		- Receives the abbreviation definition
+
+static bool ReadAbbrevDefinition(DiagnosticStreamState& state, BitcodeAbbrev& abbrev)
+{
+	uint64_t			numoperands;		// Number of operands
+	uint64_t			literal;			// Literal flag
+	uint64_t			encoding;			// Operand encoding
+	uint64_t			value;				// Operand value
+
+	if(!ReadVBR(state, 5, numoperands)) return false;
+	if(numoperands > MAX_ABBREV_OPERANDS) return false;
+
+	abbrev.numoperands = 0;
+
+	for(uint64_t index = 0; index < numoperands; index++) {
+
+		// Check if this operand is the element encoding of a preceding array
+		bool element = (abbrev.numoperands > 0) && (abbrev.encodings[abbrev.numoperands - 1] == EncodingArray);
+
+		if(!ReadFixed(state, 1, literal)) return false;
+
+		if(literal) {
+
+			if(element) return false;
+			if(!ReadVBR(state, 8, value)) return false;
+			abbrev.encodings[abbrev.numoperands] = EncodingLiteral;
+			abbrev.values[abbrev.numoperands++] = value;
+			continue;
+		}
+
+		if(!ReadFixed(state, 3, encoding)) return false;
+		if((encoding < EncodingFixed) || (encoding > EncodingBlob)) return false;
+
+		value = 0;
+		if((encoding == EncodingFixed) || (encoding == EncodingVBR)) {
+
+			if(!ReadVBR(state, 5, value)) return false;
+			if(value > 64) return false;
+
+			// Zero-width fixed and VBR operands are treated as a literal zero
+			if(value == 0) encoding = EncodingLiteral;
+		}
+
+		// An array element must be a scalar that consumes bits; literal, array and
+		// blob elements are rejected as they are by the LLVM bitstream reader
+		if(element && ((encoding == EncodingLiteral) || (encoding == EncodingArray) || (encoding == EncodingBlob))) return false;
+
+		abbrev.encodings[abbrev.numoperands] = static_cast<BitcodeEncoding>(encoding);
+		abbrev.values[abbrev.numoperands++] = value;
+	}
+
+	// An array must be followed by its element encoding
+	return (abbrev.numoperands == 0) || (abbrev.encodings[abbrev.numoperands - 1] != EncodingArray);
+}
+
+//---------------------------------------------------------------------------
+// ReadScalar (local)
+//
+// Reads a single non-aggregate abbreviated operand
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	encoding	- Operand encoding
+//	width		- Operand width or literal value
+//	value		- On success, receives the value
+
+static inline bool ReadScalar(DiagnosticStreamState& state, BitcodeEncoding encoding, uint64_t width, uint64_t& value)
+{
+	switch(encoding) {
+
+		case EncodingLiteral: value = width; return true;
+		case EncodingFixed: return ReadFixed(state, static_cast<unsigned int>(width), value);
+		case EncodingVBR: return ReadVBR(state, static_cast<unsigned int>(width), value);
+
+		case EncodingChar6:
+			if(!ReadFixed(state, 6, value)) return false;
+			value = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789._"[value];
+			return true;
+
+		default: return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+// AppendValue (local)
+//
+// Appends a record operand to the fields, or to the text buffer once the
+// field storage has been exhausted
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	value		- Operand value
+
+static inline void AppendValue(DiagnosticStreamState& state, uint64_t value)
+{
+	if(state.numfields < MAX_FIELDS) state.fields[state.numfields++] = value;
+	else if(state.textlength < TEXT_BUFFER_SIZE) state.textbuffer[state.textlength++] = static_cast<char>(value);
+}
+
+//---------------------------------------------------------------------------
+// ReadRecord (local)
+//
+// Reads a record into the state fields
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	abbrevid	- Abbreviation id that introduced the record
+
+static bool ReadRecord(DiagnosticStreamState& state, uint64_t abbrevid)
+{
+	uint64_t			value;				// Operand value
+	uint64_t			count;				// Operand count
+
+	state.numfields = 0;
+	state.text = state.textbuffer;
+	state.textlength = 0;
+
+	// UNABBREV_RECORD: [code:vbr6, numops:vbr6, op0:vbr6, ...]
+	if(abbrevid == 3) {
+
+		if(!ReadVBR(state, 6, value)) return false;
+		state.code = static_cast<unsigned int>(value);
+
+		if(!ReadVBR(state, 6, count)) return false;
+		if(count > RemainingBits(state)) return false;
+
+		for(uint64_t index = 0; index < count; index++) {
+
+			if(!ReadVBR(state, 6, value)) return false;
+			AppendValue(state, value);
+		}
+
+		return true;
+	}
+
+	// Abbreviation ids start at 4; the BLOCKINFO abbreviations for the block come first
+	const BitstreamScope& scope = state.scopes[state.depth - 1];
+	uint64_t remaining = abbrevid - 4;
+	const BitcodeAbbrev* abbrev = __nullptr;
+
+	for(int index = 0; (index < state.numinfoabbrevs) && (abbrev == __nullptr); index++) {
+
+		if(state.infoabbrevs[index].blockid != scope.blockid) continue;
+		if(remaining == 0) abbrev = &state.infoabbrevs[index];
+		else remaining--;
+	}
+
+	if(abbrev == __nullptr) {
+
+		if(remaining >= static_cast<uint64_t>(state.numabbrevs - scope.firstabbrev)) return false;
+		abbrev = &state.abbrevs[scope.firstabbrev + remaining];
+	}
+
+	bool hascode = false;
+	for(int index = 0; index < abbrev->numoperands; index++) {
+
+		BitcodeEncoding encoding = abbrev->encodings[index];
+
+		if(encoding == EncodingArray) {
+
+			// The element encoding is the operand that follows the array
+			if(++index >= abbrev->numoperands) return false;
+			if(!ReadVBR(state, 6, count)) return false;
+
+			// Every element consumes at least one bit, which bounds the element count
+			if(count > RemainingBits(state)) return false;
+
+			for(uint64_t element = 0; element < count; element++) {
+
+				if(!ReadScalar(state, abbrev->encodings[index], abbrev->values[index], value)) return false;
+				if(!hascode) { state.code = static_cast<unsigned int>(value); hascode = true; }
+				else AppendValue(state, value);
+			}
+		}
+
+		else if(encoding == EncodingBlob) {
+
+			// Blobs are referenced directly in the serialized data rather than copied
+			if(!ReadVBR(state, 6, count)) return false;
+			if(!AlignWord(state)) return false;
+			if(count > state.length - static_cast<size_t>(state.position >> 3)) return false;
+
+			state.text = reinterpret_cast<const char*>(state.data + static_cast<size_t>(state.position >> 3));
+			state.textlength = static_cast<size_t>(count);
+			state.position += count * 8;
+			if(!AlignWord(state)) return false;
+		}
+
+		else {
+
+			if(!ReadScalar(state, encoding, abbrev->values[index], value)) return false;
+			if(!hascode) { state.code = static_cast<unsigned int>(value); hascode = true; }
+			else AppendValue(state, value);
+		}
+	}
+
+	return hascode;
+}
+
+//---------------------------------------------------------------------------
+// ReadBlockInfo (local)
+//
+// Reads the contents of a BLOCKINFO block
+//
+// Arguments:
+//
+//	state		- Scanner state
+//	abbrevwidth	- Abbreviation id width for the block
+
+static bool ReadBlockInfo(DiagnosticStreamState& state, unsigned int abbrevwidth)
+{
+	uint64_t			abbrevid;			// Abbreviation id
+	bool				hasblockid = false;	// Flag if SETBID was seen
+	unsigned int		blockid = 0;		// Current SETBID block id
+
+	for(;;) {
+
+		if(!ReadFixed(state, abbrevwidth, abbrevid)) return false;
+
+		switch(abbrevid) {
+
+			// END_BLOCK
+			case 0: return AlignWord(state);
+
+			// ENTER_SUBBLOCK is not valid within BLOCKINFO
+			case 1: return false;
+
+			// DEFINE_ABBREV
+			case 2:
+				if((!hasblockid) || (state.numinfoabbrevs >= MAX_ABBREVS)) return false;
+				if(!ReadAbbrevDefinition(state, state.infoabbrevs[state.numinfoabbrevs])) return false;
+				state.infoabbrevs[state.numinfoabbrevs++].blockid = blockid;
+				break;
+
+			// UNABBREV_RECORD; only SETBID [1, blockid] is of interest
+			case 3:
+			{
+				BitstreamScope& scope = state.scopes[state.depth];
+				scope.blockid = 0;
+				scope.firstabbrev = state.numabbrevs;
+				state.depth++;
+
+				bool result = ReadRecord(state, abbrevid);
+				state.depth--;
+				if(!result) return false;
+
+				if((state.code == 1) && (state.numfields >= 1)) { blockid = static_cast<unsigned int>(state.fields[0]); hasblockid = true; }
+				break;
+			}
+
+			default: return false;
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// ScanRecord (local)
+//
+// Scans the bitstream up to the next serialized diagnostic record of interest
+//
+// Arguments:
+//
+//	state		- Scanner state
+
+static DiagnosticRecordKind ScanRecord(DiagnosticStreamState& state)
+{
+	uint64_t			abbrevid;			// Abbreviation id
+	uint64_t			blockid;			// Subblock id
+	uint64_t			abbrevwidth;		// Subblock abbreviation id width
+	uint64_t			numwords;			// Subblock length in words
+
+	for(;;) {
+
+		unsigned int width = (state.depth == 0) ? 2 : state.scopes[state.depth - 1].abbrevwidth;
+
+		// The end of the data is only valid between top-level blocks
+		if(state.position + width > state.bitlength) return (state.depth == 0) ? RecordEndOfFile : RecordInvalid;
+		if(!ReadFixed(state, width, abbrevid)) return RecordInvalid;
+
+		switch(abbrevid) {
+
+			// END_BLOCK
+			case 0:
+			{
+				if((state.depth == 0) || (!AlignWord(state))) return RecordInvalid;
+
+				BitstreamScope& scope = state.scopes[--state.depth];
+				state.numabbrevs = scope.firstabbrev;
+
+				if(scope.blockid == BLOCK_DIAG) { state.diagdepth--; return RecordEndDiagnostic; }
+				break;
+			}
+
+			// ENTER_SUBBLOCK
+			case 1:
+				if(!ReadVBR(state, 8, blockid) || !ReadVBR(state, 4, abbrevwidth)) return RecordInvalid;
+				if(!AlignWord(state) || !ReadFixed(state, 32, numwords)) return RecordInvalid;
+				if((abbrevwidth == 0) || (abbrevwidth > 32)) return RecordInvalid;
+
+				if(blockid == 0) {
+
+					if(state.depth >= MAX_DEPTH) return RecordInvalid;
+					if(!ReadBlockInfo(state, static_cast<unsigned int>(abbrevwidth))) return RecordInvalid;
+				}
+
+				else if((blockid == BLOCK_META) || (blockid == BLOCK_DIAG)) {
+
+					if(state.depth >= MAX_DEPTH) return RecordInvalid;
+
+					BitstreamScope& scope = state.scopes[state.depth++];
+					scope.blockid = static_cast<unsigned int>(blockid);
+					scope.abbrevwidth = static_cast<unsigned int>(abbrevwidth);
+					scope.firstabbrev = state.numabbrevs;
+
+					if(blockid == BLOCK_DIAG) state.diagdepth++;
+				}
+
+				// Unknown blocks are skipped in their entirety
+				else {
+
+					if(numwords * 4 > state.length - static_cast<size_t>(state.position >> 3)) return RecordInvalid;
+					state.position += numwords * 32;
+				}
+				break;
+
+			// DEFINE_ABBREV
+			case 2:
+				if((state.depth == 0) || (state.numabbrevs >= MAX_ABBREVS)) return RecordInvalid;
+				if(!ReadAbbrevDefinition(state, state.abbrevs[state.numabbrevs])) return RecordInvalid;
+				state.abbrevs[state.numabbrevs++].blockid = state.scopes[state.depth - 1].blockid;
+				break;
+
+			// UNABBREV_RECORD and abbreviated records
+			default:
+			{
+				if(state.depth == 0) return RecordInvalid;
+				if(!ReadRecord(state, abbrevid)) return RecordInvalid;
+
+				unsigned int scopeid = state.scopes[state.depth - 1].blockid;
+
+				if(scopeid == BLOCK_META) {
+
+					if(state.code == RECORD_VERSION) return RecordVersion;
+				}
+
+				else if(scopeid == BLOCK_DIAG) {
+
+					switch(state.code) {
+
+						case RECORD_DIAG: return RecordDiagnostic;
+						case RECORD_DIAG_FLAG: return RecordFlag;
+						case RECORD_CATEGORY: return RecordCategory;
+						case RECORD_FILENAME: return RecordFileName;
+					}
+				}
+				break;
+			}
+		}
+	}
+}
+
+#pragma managed(pop)
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader Constructor (private)
+//
+// Arguments:
+//
+//	path		- Path to the serialized diagnostics file
+
+SerializedDiagnosticReader::SerializedDiagnosticReader(String^ path) : m_path(path), m_file(INVALID_HANDLE_VALUE), m_mapping(__nullptr), 
+	m_view(__nullptr), m_state(__nullptr), m_version(0)
+{
+	LARGE_INTEGER			size;			// Size of the file
+
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+
+	m_files = gcnew Dictionary<int, String^>();
+	m_categories = gcnew Dictionary<int, String^>();
+	m_flags = gcnew Dictionary<int, String^>();
+
+	try {
+
+		pin_ptr<const wchar_t> pinpath = PtrToStringChars(path);
+
+		m_file = CreateFileW(pinpath, GENERIC_READ, FILE_SHARE_READ, __nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, __nullptr);
+		if(m_file == INVALID_HANDLE_VALUE) throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::CannotLoad, (gcnew Win32Exception(static_cast<int>(GetLastError())))->Message);
+
+		if(!GetFileSizeEx(m_file, &size)) throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::CannotLoad, (gcnew Win32Exception(static_cast<int>(GetLastError())))->Message);
+
+		// An empty file cannot be mapped, and anything shorter than the signature isn't valid
+		if((size.QuadPart < 4) || (static_cast<uint64_t>(size.QuadPart) > SIZE_MAX)) 
+			throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::InvalidFile, String::Format("{0} is not a serialized diagnostics file", path));
+
+		m_mapping = CreateFileMappingW(m_file, __nullptr, PAGE_READONLY, 0, 0, __nullptr);
+		if(m_mapping == __nullptr) throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::CannotLoad, (gcnew Win32Exception(static_cast<int>(GetLastError())))->Message);
+
+		m_view = reinterpret_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if(m_view == __nullptr) throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::CannotLoad, (gcnew Win32Exception(static_cast<int>(GetLastError())))->Message);
+
+		if(memcmp(m_view, "DIAG", 4) != 0) 
+			throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::InvalidFile, String::Format("{0} is not a serialized diagnostics file", path));
+
+		try { m_state = new DiagnosticStreamState; }
+		catch(Exception^) { throw gcnew OutOfMemoryException(); }
+
+		memset(m_state, 0, sizeof(DiagnosticStreamState));
+		m_state->data = m_view;
+		m_state->length = static_cast<size_t>(size.QuadPart);
+		m_state->bitlength = static_cast<uint64_t>(size.QuadPart) * 8;
+		m_state->position = 32;					// Skip over the signature
+	}
+
+	catch(Exception^) { this->!SerializedDiagnosticReader(); throw; }
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader Destructor
+
+SerializedDiagnosticReader::~SerializedDiagnosticReader()
+{
+	if(m_disposed) return;
+
+	m_pending = nullptr;						// Release any partial diagnostic
+	this->!SerializedDiagnosticReader();		// Release the unmanaged resources
+	m_disposed = true;							// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader Finalizer
+
+SerializedDiagnosticReader::!SerializedDiagnosticReader()
+{
+	if(m_state != __nullptr) delete m_state;
+	if(m_view != __nullptr) UnmapViewOfFile(m_view);
+	if(m_mapping != __nullptr) CloseHandle(m_mapping);
+	if(m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+	m_state = __nullptr;
+	m_view = __nullptr;
+	m_mapping = __nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::Create (internal, static)
+//
+// Opens a serialized diagnostics file
+//
+// Arguments:
+//
+//	path		- Path to the serialized diagnostics file
+
+SerializedDiagnosticReader^ SerializedDiagnosticReader::Create(String^ path)
+{
+	return gcnew SerializedDiagnosticReader(path);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::CreateDiagnostic (private)
+//
+// Creates a SerializedDiagnostic from the most recently scanned record
+//
+// Arguments:
+//
+//	NONE
+
+SerializedDiagnostic^ SerializedDiagnosticReader::CreateDiagnostic(void)
+{
+	// RECORD_DIAG: [level, fileid, line, column, offset, category, flag, textlength] + text
+	if(m_state->numfields < 7) 
+		throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::InvalidFile, String::Format("{0} contains an invalid diagnostic record", m_path));
+
+	const uint64_t* fields = m_state->fields;
+
+	// libclang reports remarks as warnings when loading serialized diagnostics
+	CXDiagnosticSeverity severity = (fields[0] == LEVEL_REMARK) ? CXDiagnostic_Warning : static_cast<CXDiagnosticSeverity>(fields[0]);
+
+	return SerializedDiagnostic::Create(DiagnosticSeverity(severity), LookupName(m_files, fields[1]), static_cast<int>(fields[2]), 
+		static_cast<int>(fields[3]), static_cast<int>(fields[4]), LookupName(m_categories, fields[5]), LookupName(m_flags, fields[6]), GetRecordText());
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::ForEach (static)
+//
+// Reads multiple serialized diagnostics files in parallel
+//
+// Arguments:
+//
+//	paths		- Paths to the serialized diagnostics files
+//	action		- Action to invoke for each top-level diagnostic
+
+void SerializedDiagnosticReader::ForEach(IEnumerable<String^>^ paths, Action<String^, SerializedDiagnostic^>^ action)
+{
+	ForEach(paths, -1, action);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::ForEach (static)
+//
+// Reads multiple serialized diagnostics files in parallel
+//
+// Arguments:
+//
+//	paths			- Paths to the serialized diagnostics files
+//	maxParallelism	- Maximum number of files to read concurrently, or -1
+//	action			- Action to invoke for each top-level diagnostic
+
+void SerializedDiagnosticReader::ForEach(IEnumerable<String^>^ paths, int maxParallelism, Action<String^, SerializedDiagnostic^>^ action)
+{
+	if(Object::ReferenceEquals(paths, nullptr)) throw gcnew ArgumentNullException("paths");
+	if(Object::ReferenceEquals(action, nullptr)) throw gcnew ArgumentNullException("action");
+	if((maxParallelism == 0) || (maxParallelism < -1)) throw gcnew ArgumentOutOfRangeException("maxParallelism");
+
+	ParallelOptions^ options = gcnew ParallelOptions();
+	options->MaxDegreeOfParallelism = maxParallelism;
+
+	// Each file is read by a single thread with its own reader; the files are the unit of parallelism
+	ForEachWorker^ worker = gcnew ForEachWorker(action);
+	Parallel::ForEach(paths, options, gcnew Action<String^>(worker, &ForEachWorker::Read));
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::ForEachWorker::Read
+//
+// Reads every diagnostic in a file and invokes the action
+//
+// Arguments:
+//
+//	path		- Path to the serialized diagnostics file
+
+void SerializedDiagnosticReader::ForEachWorker::Read(String^ path)
+{
+	SerializedDiagnosticReader^ reader = SerializedDiagnosticReader::Create(path);
+
+	try {
+
+		for(SerializedDiagnostic^ diagnostic = reader->Read(); !Object::ReferenceEquals(diagnostic, nullptr); diagnostic = reader->Read()) 
+			m_action(path, diagnostic);
+	}
+
+	finally { delete reader; }
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::GetRecordText (private)
+//
+// Converts the string of the most recently scanned record
+//
+// Arguments:
+//
+//	NONE
+
+String^ SerializedDiagnosticReader::GetRecordText(void)
+{
+	return StringUtil::ToString(m_state->text, m_state->textlength, CP_UTF8);
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::LookupName (private, static)
+//
+// Looks up a name in one of the file name, category or flag tables
+//
+// Arguments:
+//
+//	table		- Table in which to look up the name
+//	id			- Identifier of the name; zero indicates no name
+
+String^ SerializedDiagnosticReader::LookupName(Dictionary<int, String^>^ table, uint64_t id)
+{
+	String^				name;				// Name from the table
+
+	if((id == 0) || (id > static_cast<uint64_t>(Int32::MaxValue))) return String::Empty;
+	return (table->TryGetValue(static_cast<int>(id), name)) ? name : String::Empty;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::Path::get
+//
+// Gets the path to the serialized diagnostics file
+
+String^ SerializedDiagnosticReader::Path::get(void)
+{
+	return m_path;
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::Read
+//
+// Reads the next top-level diagnostic, or returns null at the end of the file
+//
+// Arguments:
+//
+//	NONE
+
+SerializedDiagnostic^ SerializedDiagnosticReader::Read(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	for(;;) {
+
+		switch(ScanRecord(*m_state)) {
+
+			case RecordEndOfFile:
+				if(!Object::ReferenceEquals(m_pending, nullptr)) break;
+				return nullptr;
+
+			case RecordVersion:
+				if(m_state->numfields >= 1) m_version = static_cast<int>(m_state->fields[0]);
+				continue;
+
+			// The name tables are keyed on the first field of the record
+			case RecordFileName:
+			case RecordCategory:
+			case RecordFlag:
+			{
+				if((m_state->numfields < 1) || (m_state->fields[0] > static_cast<uint64_t>(Int32::MaxValue))) break;
+
+				Dictionary<int, String^>^ table = m_files;
+				if(m_state->code == RECORD_CATEGORY) table = m_categories;
+				else if(m_state->code == RECORD_DIAG_FLAG) table = m_flags;
+
+				table[static_cast<int>(m_state->fields[0])] = GetRecordText();
+				continue;
+			}
+
+			// Diagnostics in nested blocks are notes attached to the enclosing top-level diagnostic
+			case RecordDiagnostic:
+			{
+				SerializedDiagnostic^ diagnostic = CreateDiagnostic();
+
+				if(m_state->diagdepth == 1) m_pending = diagnostic;
+				else if(!Object::ReferenceEquals(m_pending, nullptr)) m_pending->AddChild(diagnostic);
+				continue;
+			}
+
+			// A top-level diagnostic is complete when its block ends
+			case RecordEndDiagnostic:
+			{
+				if((m_state->diagdepth != 0) || Object::ReferenceEquals(m_pending, nullptr)) continue;
+
+				SerializedDiagnostic^ diagnostic = m_pending;
+				m_pending = nullptr;
+				return diagnostic;
+			}
+
+			default: break;
+		}
+
+		throw gcnew DiagnosticLoadException(DiagnosticLoadErrorCode::InvalidFile, 
+			String::Format("{0} is not a valid serialized diagnostics file (bit offset {1})", m_path, m_state->position));
+	}
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::ReadBatch
+//
+// Reads up to the specified number of top-level diagnostics
+//
+// Arguments:
+//
+//	count		- Maximum number of diagnostics to read
+
+array<SerializedDiagnostic^>^ SerializedDiagnosticReader::ReadBatch(int count)
+{
+	CHECK_DISPOSED(m_disposed);
+	if(count < 0) throw gcnew ArgumentOutOfRangeException("count");
+
+	List<SerializedDiagnostic^>^ batch = gcnew List<SerializedDiagnostic^>(Math::Min(count, 1024));
+
+	while(batch->Count < count) {
+
+		SerializedDiagnostic^ diagnostic = Read();
+		if(Object::ReferenceEquals(diagnostic, nullptr)) break;
+
+		batch->Add(diagnostic);
+	}
+
+	return batch->ToArray();
+}
+
+//---------------------------------------------------------------------------
+// SerializedDiagnosticReader::Version::get
+//
+// Gets the serialized diagnostics format version
+
+int SerializedDiagnosticReader::Version::get(void)
+{
+	return m_version;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
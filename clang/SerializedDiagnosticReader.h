@@ -0,0 +1,181 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __SERIALIZEDDIAGNOSTICREADER_H_
+#define __SERIALIZEDDIAGNOSTICREADER_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+struct		DiagnosticStreamState;
+ref class	SerializedDiagnostic;
+
+//---------------------------------------------------------------------------
+// Class SerializedDiagnosticReader
+//
+// Streaming reader for serialized diagnostics (.dia) files.  The file is
+// memory-mapped and decoded incrementally by an unmanaged bitstream scanner,
+// top-level diagnostics are returned one at a time along with their notes.
+// Only the file name, category and flag tables are retained between reads,
+// so memory usage does not depend on the size of the file.  Instances are
+// not thread-safe; use ForEach to process multiple files in parallel
+//---------------------------------------------------------------------------
+
+public ref class SerializedDiagnosticReader
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ForEach (static)
+	//
+	// Reads multiple serialized diagnostics files in parallel, the action is
+	// invoked concurrently with the path and each top-level diagnostic
+	static void ForEach(IEnumerable<String^>^ paths, Action<String^, SerializedDiagnostic^>^ action);
+	static void ForEach(IEnumerable<String^>^ paths, int maxParallelism, Action<String^, SerializedDiagnostic^>^ action);
+
+	// Read
+	//
+	// Reads the next top-level diagnostic, or returns null at the end of the file
+	SerializedDiagnostic^ Read(void);
+
+	// ReadBatch
+	//
+	// Reads up to the specified number of top-level diagnostics, an empty
+	// array is returned at the end of the file
+	array<SerializedDiagnostic^>^ ReadBatch(int count);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Path
+	//
+	// Gets the path to the serialized diagnostics file
+	property String^ Path
+	{
+		String^ get(void);
+	}
+
+	// Version
+	//
+	// Gets the serialized diagnostics format version, or zero if not yet read
+	property int Version
+	{
+		int get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Opens a serialized diagnostics file
+	static SerializedDiagnosticReader^ Create(String^ path);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Class ForEachWorker
+	//
+	// Reads a single file on behalf of ForEach
+	ref class ForEachWorker
+	{
+	public:
+
+		// Instance Constructor
+		//
+		ForEachWorker(Action<String^, SerializedDiagnostic^>^ action) : m_action(action) {}
+
+		// Read
+		//
+		// Reads every diagnostic in a file and invokes the action
+		void Read(String^ path);
+
+	private:
+
+		// Member Variables
+		//
+		Action<String^, SerializedDiagnostic^>^		m_action;		// Action to invoke
+	};
+
+	// Instance Constructor
+	//
+	SerializedDiagnosticReader(String^ path);
+
+	// Destructor / Finalizer
+	//
+	~SerializedDiagnosticReader();
+	!SerializedDiagnosticReader();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// CreateDiagnostic
+	//
+	// Creates a SerializedDiagnostic from the most recently scanned record
+	SerializedDiagnostic^ CreateDiagnostic(void);
+
+	// GetRecordText
+	//
+	// Converts the string of the most recently scanned record
+	String^ GetRecordText(void);
+
+	// LookupName (static)
+	//
+	// Looks up a name in one of the file name, category or flag tables
+	static String^ LookupName(Dictionary<int, String^>^ table, uint64_t id);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool							m_disposed;		// Object disposal flag
+	String^							m_path;			// Serialized file path
+	HANDLE							m_file;			// Serialized file handle
+	HANDLE							m_mapping;		// File mapping handle
+	const uint8_t*					m_view;			// Mapped view of the file
+	DiagnosticStreamState*			m_state;		// Unmanaged scanner state
+	int								m_version;		// Format version
+	Dictionary<int, String^>^		m_files;		// File name table
+	Dictionary<int, String^>^		m_categories;	// Category table
+	Dictionary<int, String^>^		m_flags;		// Flag name table
+	SerializedDiagnostic^			m_pending;		// Diagnostic being read
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __SERIALIZEDDIAGNOSTICREADER_H_
@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "StringInterner.h"
+
+#include "StringUtil.h"
+
+using namespace System::Runtime::InteropServices;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// StringInterner Constructor
+//
+// Arguments:
+//
+//	NONE
+
+StringInterner::StringInterner() : m_entries(gcnew Dictionary<UInt64, Entry^>())
+{
+}
+
+//---------------------------------------------------------------------------
+// StringInterner::Count::get
+//
+// Gets the number of unique strings that have been interned
+
+int StringInterner::Count::get(void)
+{
+	return m_entries->Count;
+}
+
+//---------------------------------------------------------------------------
+// StringInterner::Intern
+//
+// Converts an unmanaged string into a shared System::String instance
+//
+// Arguments:
+//
+//	psz			- Unmanaged UTF-8 string to be interned
+
+String^ StringInterner::Intern(const char* psz)
+{
+	Entry^				entry;				// Existing interned string entry
+
+	if((psz == __nullptr) || (*psz == '\0')) return String::Empty;
+
+	size_t cb = strlen(psz);
+	if(cb > static_cast<size_t>(Int32::MaxValue)) throw gcnew OverflowException();
+
+	UInt64 hash = StringUtil::Hash(psz, cb);
+	if(m_entries->TryGetValue(hash, entry)) {
+
+		// Verify that the bytes actually match; in the unlikely event of a hash collision
+		// the string is converted normally but is not added to the interned set
+		if(entry->Bytes->Length == static_cast<int>(cb)) {
+
+			pin_ptr<Byte> pinbytes = &entry->Bytes[0];
+			if(memcmp(pinbytes, psz, cb) == 0) return entry->Value;
+		}
+
+		return StringUtil::ToString(psz, cb, CP_UTF8);
+	}
+
+	// Keep a copy of the raw bytes to verify future matches against
+	array<Byte>^ bytes = gcnew array<Byte>(static_cast<int>(cb));
+	Marshal::Copy(IntPtr(const_cast<char*>(psz)), bytes, 0, static_cast<int>(cb));
+
+	entry = gcnew Entry(bytes, StringUtil::ToString(psz, cb, CP_UTF8));
+	m_entries->Add(hash, entry);
+
+	return entry->Value;
+}
+
+//---------------------------------------------------------------------------
+// StringInterner::Intern
+//
+// Converts a CXString into a shared System::String instance and disposes it
+//
+// Arguments:
+//
+//	string		- CXString rvalue reference
+
+String^ StringInterner::Intern(CXString&& string)
+{
+	try { return Intern(clang_getCString(string)); }
+	finally { clang_disposeString(string); memset(&string, 0, sizeof(CXString)); }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
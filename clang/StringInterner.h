@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __STRINGINTERNER_H_
+#define __STRINGINTERNER_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class StringInterner (internal)
+//
+// Converts unmanaged UTF-8 strings into System::String instances, returning
+// the same instance for every occurrence of the same string.  The lookup is
+// keyed on a hash of the raw bytes so duplicate strings are never converted
+//---------------------------------------------------------------------------
+
+ref class StringInterner
+{
+public:
+
+	// Instance Constructor
+	//
+	StringInterner();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Intern
+	//
+	// Converts an unmanaged string into a shared System::String instance
+	String^ Intern(const char* psz);
+	String^ Intern(CXString&& string);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of unique strings that have been interned
+	property int Count
+	{
+		int get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Class Entry
+	//
+	// Associates the raw UTF-8 bytes of a string with the converted string
+	ref class Entry
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Entry(array<Byte>^ bytes, String^ value) : Bytes(bytes), Value(value) {}
+
+		// Fields
+		//
+		initonly array<Byte>^		Bytes;		// Raw UTF-8 bytes
+		initonly String^			Value;		// Converted string
+	};
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<UInt64, Entry^>^		m_entries;		// Interned strings
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __STRINGINTERNER_H_
@@ -69,6 +69,28 @@ char** StringUtil::FreeCharPointerArray(char** strings)
 	return __nullptr;
 }
 
+//---------------------------------------------------------------------------
+// StringUtil::Hash (static)
+//
+// Generates a 64-bit FNV-1a hash of an unmanaged byte string
+//
+// Arguments:
+//
+//	psz			- Pointer to the unmanaged string to hash
+//	cb			- Length of the unmanaged string, in bytes
+
+uint64_t StringUtil::Hash(const char* psz, size_t cb)
+{
+	uint64_t hash = 14695981039346656037ULL;		// FNV-1a offset basis
+
+	if(psz == __nullptr) return hash;
+
+	const unsigned char* pb = reinterpret_cast<const unsigned char*>(psz);
+	for(size_t index = 0; index < cb; index++) { hash ^= pb[index]; hash *= 1099511628211ULL; }
+
+	return hash;
+}
+
 //---------------------------------------------------------------------------
 // StringUtil::ToCharPointer
 //
@@ -54,6 +54,11 @@ public:
 	// Releases unmanaged string array allocated by EnumerableStringToCharPointerArray
 	static char** FreeCharPointerArray(char** strings);
 
+	// Hash (static)
+	//
+	// Generates a 64-bit FNV-1a hash of an unmanaged byte string
+	static uint64_t Hash(const char* psz, size_t cb);
+
 	// ToCharPointer
 	//
 	// Converts a System::String into an unmanaged C-style string
@@ -27,8 +27,10 @@
 #include "Extent.h"
 #include "Location.h"
 #include "LocationKind.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
 #include "TokenKind.h"
+#include "Utf8String.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -72,6 +74,8 @@ Cursor^ Token::Annotation::get(void)
 
 Token^ Token::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXToken token, CXCursor annotation)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Token);
+
 	// Create the token handle with the specified owner (typically a token set), but create the cursor
 	// with the translation unit as the owner since it doesn't need to be disposed of when the token set is
 	return gcnew Token(gcnew TokenHandle(owner, transunit, token), Cursor::Create(transunit, transunit, annotation));
@@ -94,6 +98,23 @@ local::Extent^ Token::Extent::get(void)
 	return m_extent;
 }
 
+//---------------------------------------------------------------------------
+// Token::GetSpellingUtf8
+//
+// Gets the textual representation of the token as raw UTF-8
+//
+// Arguments:
+//
+//	NONE
+
+Utf8String^ Token::GetSpellingUtf8(void)
+{
+	TokenHandle::Reference token(m_handle);
+
+	// This is a method not a property, the caller owns the returned object
+	return Utf8String::Create(clang_getTokenSpelling(token.TranslationUnit, token));
+}
+
 //---------------------------------------------------------------------------
 // Token::Location::get
 //
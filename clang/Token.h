@@ -40,6 +40,7 @@ ref class	Cursor;
 ref class	Extent;
 ref class	Location;
 enum class	TokenKind;
+ref class	Utf8String;
 
 //---------------------------------------------------------------------------
 // Class Token
@@ -54,6 +55,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// GetSpellingUtf8
+	//
+	// Gets the textual representation of the token as raw UTF-8
+	Utf8String^ GetSpellingUtf8(void);
+
 	// ToString
 	//
 	// Overrides Object::ToString()
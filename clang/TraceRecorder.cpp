@@ -0,0 +1,328 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "TraceRecorder.h"
+
+#include "PerformanceCounters.h"
+
+using namespace System::Diagnostics;
+using namespace System::Globalization;
+using namespace System::Text;
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// TraceRecorder Constructor
+//
+// Arguments:
+//
+//	NONE
+
+TraceRecorder::TraceRecorder() : m_buffers(gcnew List<Buffer^>()), m_started(0)
+{
+	m_processid = Process::GetCurrentProcess()->Id;
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::EventCount::get
+//
+// Gets the number of events that have been recorded
+
+int TraceRecorder::EventCount::get(void)
+{
+	int count = 0;
+
+	Monitor::Enter(m_buffers);
+
+	try {
+
+		for each(Buffer^ buffer in m_buffers)
+			for(Chunk^ chunk = buffer->Head; !Object::ReferenceEquals(chunk, nullptr); chunk = chunk->Next) count += chunk->Count;
+	}
+
+	finally { Monitor::Exit(m_buffers); }
+
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::IsRecording::get
+//
+// Gets a flag indicating if this recorder is recording events
+
+bool TraceRecorder::IsRecording::get(void)
+{
+	return Object::ReferenceEquals(s_active, this);
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Record (internal, static)
+//
+// Records an event against the active recorder on the calling thread
+//
+// Arguments:
+//
+//	operation	- Operation that is starting or ending
+//	phase		- Trace event phase, 'B' or 'E'
+//	timestamp	- Stopwatch timestamp of the event
+//	filename	- File associated with the operation (optional)
+
+void TraceRecorder::Record(PerformanceOperation operation, wchar_t phase, __int64 timestamp, String^ filename)
+{
+	TraceRecorder^ recorder = s_active;
+	if(Object::ReferenceEquals(recorder, nullptr)) return;
+
+	// The first event from each thread for a recorder creates and registers the thread's
+	// buffer, this is the only time the recording thread has to take a lock
+	Buffer^ buffer = s_buffer;
+	if((Object::ReferenceEquals(buffer, nullptr)) || (!Object::ReferenceEquals(buffer->Owner, recorder))) {
+
+		Thread^ thread = Thread::CurrentThread;
+		buffer = gcnew Buffer(recorder, thread->ManagedThreadId, thread->Name);
+		recorder->Register(buffer);
+		s_buffer = buffer;
+	}
+
+	TraceEvent item;
+	item.Timestamp = timestamp;
+	item.FileName = filename;
+	item.Operation = operation;
+	item.Phase = phase;
+
+	buffer->Add(item);
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Register (private)
+//
+// Adds a thread buffer to the recorder
+//
+// Arguments:
+//
+//	buffer		- Thread buffer to be added
+
+void TraceRecorder::Register(Buffer^ buffer)
+{
+	Monitor::Enter(m_buffers);
+
+	try { m_buffers->Add(buffer); }
+	finally { Monitor::Exit(m_buffers); }
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Save
+//
+// Writes the recorded events to a trace_event JSON file
+//
+// Arguments:
+//
+//	path		- Path to the output file
+
+void TraceRecorder::Save(String^ path)
+{
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+
+	StreamWriter^ writer = gcnew StreamWriter(path, false, gcnew UTF8Encoding(false));
+
+	try { WriteTo(writer); }
+	finally { delete writer; }
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Start
+//
+// Starts recording events
+//
+// Arguments:
+//
+//	NONE
+
+void TraceRecorder::Start(void)
+{
+	// Event timestamps are relative to the first time the recorder was started
+	if(m_started == 0) m_started = Stopwatch::GetTimestamp();
+
+	// Only one recorder can be recording at a time, the operations are process-wide
+	TraceRecorder^ active = Interlocked::CompareExchange<TraceRecorder^>(s_active, this, nullptr);
+	if((!Object::ReferenceEquals(active, nullptr)) && (!Object::ReferenceEquals(active, this))) throw gcnew InvalidOperationException();
+
+	PerformanceCounters::Tracing = true;
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Stop
+//
+// Stops recording events
+//
+// Arguments:
+//
+//	NONE
+
+void TraceRecorder::Stop(void)
+{
+	Interlocked::CompareExchange<TraceRecorder^>(s_active, nullptr, this);
+	PerformanceCounters::Tracing = !Object::ReferenceEquals(s_active, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::WriteString (private, static)
+//
+// Writes an escaped JSON string literal
+//
+// Arguments:
+//
+//	writer		- TextWriter instance
+//	value		- String to be written
+
+void TraceRecorder::WriteString(TextWriter^ writer, String^ value)
+{
+	writer->Write(L'"');
+
+	for each(wchar_t ch in value) {
+
+		switch(ch) {
+
+			case L'"': writer->Write("\\\""); break;
+			case L'\\': writer->Write("\\\\"); break;
+			case L'\n': writer->Write("\\n"); break;
+			case L'\r': writer->Write("\\r"); break;
+			case L'\t': writer->Write("\\t"); break;
+			default:
+				if(ch < 0x20) writer->Write(String::Format(CultureInfo::InvariantCulture, "\\u{0:x4}", static_cast<int>(ch)));
+				else writer->Write(ch);
+		}
+	}
+
+	writer->Write(L'"');
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::WriteTo
+//
+// Writes the recorded events as trace_event JSON
+//
+// Arguments:
+//
+//	writer		- TextWriter instance
+
+void TraceRecorder::WriteTo(TextWriter^ writer)
+{
+	array<Buffer^>^			buffers;				// Registered thread buffers
+	bool					first = true;			// First event flag
+
+	if(Object::ReferenceEquals(writer, nullptr)) throw gcnew ArgumentNullException("writer");
+
+	Monitor::Enter(m_buffers);
+
+	try { buffers = m_buffers->ToArray(); }
+	finally { Monitor::Exit(m_buffers); }
+
+	String^ pid = m_processid.ToString(CultureInfo::InvariantCulture);
+	writer->Write("{\"traceEvents\":[");
+
+	for each(Buffer^ buffer in buffers) {
+
+		String^ tid = buffer->ThreadId.ToString(CultureInfo::InvariantCulture);
+
+		// Named threads get a metadata event so the viewer labels their track
+		if(!String::IsNullOrEmpty(buffer->ThreadName)) {
+
+			writer->Write(first ? "\n" : ",\n");
+			writer->Write("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{0},\"tid\":{1},\"args\":{{\"name\":", pid, tid);
+			WriteString(writer, buffer->ThreadName);
+			writer->Write("}}");
+			first = false;
+		}
+
+		// Events are only read up to the published count of each chunk; the recording
+		// thread may still be appending to the buffer while it is being written
+		for(Chunk^ chunk = buffer->Head; !Object::ReferenceEquals(chunk, nullptr); chunk = chunk->Next) {
+
+			int count = chunk->Count;
+			Thread::MemoryBarrier();
+
+			for(int index = 0; index < count; index++) {
+
+				TraceEvent% item = chunk->Events[index];
+				double microseconds = (static_cast<double>(item.Timestamp - m_started) * 1000000.0) / Stopwatch::Frequency;
+
+				writer->Write(first ? "\n" : ",\n");
+				writer->Write("{{\"name\":\"{0}\",\"cat\":\"clang\",\"ph\":\"{1}\",\"ts\":{2},\"pid\":{3},\"tid\":{4}", item.Operation.ToString(), 
+					Char::ToString(item.Phase), microseconds.ToString("0.###", CultureInfo::InvariantCulture), pid, tid);
+
+				if(!Object::ReferenceEquals(item.FileName, nullptr)) {
+
+					writer->Write(",\"args\":{\"file\":");
+					WriteString(writer, item.FileName);
+					writer->Write("}");
+				}
+
+				writer->Write("}");
+				first = false;
+			}
+		}
+	}
+
+	writer->Write("\n],\"displayTimeUnit\":\"ms\"}\n");
+	writer->Flush();
+}
+
+//---------------------------------------------------------------------------
+// TraceRecorder::Buffer::Add
+//
+// Appends an event, only the owning thread calls this
+//
+// Arguments:
+//
+//	item		- Event to be appended
+
+void TraceRecorder::Buffer::Add(TraceEvent item)
+{
+	Chunk^ chunk = Tail;
+
+	// When the current chunk is full a new one is linked after it, readers only ever
+	// follow the Next reference so it has to be completely initialized before publishing
+	if(chunk->Count == chunk->Events->Length) {
+
+		Chunk^ next = gcnew Chunk();
+		Thread::MemoryBarrier();
+		chunk->Next = next;
+		Tail = chunk = next;
+	}
+
+	chunk->Events[chunk->Count] = item;
+
+	// Publish the event only after it has been written
+	Thread::MemoryBarrier();
+	chunk->Count = chunk->Count + 1;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,200 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __TRACERECORDER_H_
+#define __TRACERECORDER_H_
+#pragma once
+
+#include "PerformanceOperation.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::IO;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class TraceRecorder
+//
+// Records the begin and end of each parse, index, completion, tokenize,
+// diagnostics extraction, save and dispose operation on every thread and
+// writes them as Chrome trace_event JSON (chrome://tracing, Perfetto).
+// Each thread appends to its own buffer without taking a lock; only one
+// recorder can be recording at a time
+//---------------------------------------------------------------------------
+
+public ref class TraceRecorder
+{
+public:
+
+	// Instance Constructor
+	//
+	TraceRecorder();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Save
+	//
+	// Writes the recorded events to a trace_event JSON file
+	void Save(String^ path);
+
+	// Start
+	//
+	// Starts recording events
+	void Start(void);
+
+	// Stop
+	//
+	// Stops recording events
+	void Stop(void);
+
+	// WriteTo
+	//
+	// Writes the recorded events as trace_event JSON
+	void WriteTo(TextWriter^ writer);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// EventCount
+	//
+	// Gets the number of events that have been recorded
+	property int EventCount
+	{
+		int get(void);
+	}
+
+	// IsRecording
+	//
+	// Gets a flag indicating if this recorder is recording events
+	property bool IsRecording
+	{
+		bool get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Record (static)
+	//
+	// Records an event against the active recorder on the calling thread
+	static void Record(PerformanceOperation operation, wchar_t phase, __int64 timestamp, String^ filename);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Struct TraceEvent
+	//
+	// Single begin or end event
+	value struct TraceEvent
+	{
+		__int64					Timestamp;		// Stopwatch timestamp
+		String^					FileName;		// File name (optional)
+		PerformanceOperation	Operation;		// Operation
+		wchar_t					Phase;			// 'B' or 'E'
+	};
+
+	// Class Chunk
+	//
+	// Fixed-size block of events; the count is published after the events
+	// are written so that the recording thread never has to take a lock
+	ref class Chunk
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Chunk() : Events(gcnew array<TraceEvent>(512)), Count(0), Next(nullptr) {}
+
+		// Fields
+		//
+		initonly array<TraceEvent>^		Events;		// Event storage
+		int								Count;		// Published event count
+		Chunk^							Next;		// Next chunk, if any
+	};
+
+	// Class Buffer
+	//
+	// Events recorded by a single thread
+	ref class Buffer
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Buffer(TraceRecorder^ owner, int threadid, String^ threadname) : Owner(owner), ThreadId(threadid), 
+			ThreadName(threadname), Head(gcnew Chunk()), Tail(Head) {}
+
+		// Add
+		//
+		// Appends an event, only the owning thread calls this
+		void Add(TraceEvent item);
+
+		// Fields
+		//
+		initonly TraceRecorder^	Owner;			// Owning recorder
+		initonly int			ThreadId;		// Managed thread id
+		initonly String^		ThreadName;		// Thread name, if any
+		initonly Chunk^			Head;			// First chunk
+		Chunk^					Tail;			// Chunk being written
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Register
+	//
+	// Adds a thread buffer to the recorder
+	void Register(Buffer^ buffer);
+
+	// WriteString (static)
+	//
+	// Writes an escaped JSON string literal
+	static void WriteString(TextWriter^ writer, String^ value);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	List<Buffer^>^				m_buffers;		// Registered thread buffers
+	__int64						m_started;		// Timestamp of the first event
+	int							m_processid;	// Current process id
+
+	[ThreadStaticAttribute]
+	static Buffer^				s_buffer;		// Buffer for the calling thread
+	static TraceRecorder^		s_active;		// Recorder that is recording
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __TRACERECORDER_H_
@@ -25,15 +25,21 @@
 
 #include "AutoGCHandle.h"
 #include "CompletionOptions.h"
+#include "CompletionPrewarmer.h"
 #include "CompletionResultCollection.h"
+#include "CompletionSession.h"
 #include "Cursor.h"
+#include "CursorIdentityMap.h"
 #include "DiagnosticCollection.h"
+#include "DiagnosticFields.h"
+#include "DiagnosticTable.h"
 #include "EnumerateIncludedFileFunc.h"
 #include "Extent.h"
 #include "File.h"
 #include "GCHandleRef.h"
 #include "Location.h"
 #include "LocationCollection.h"
+#include "PerformanceCounters.h"
 #include "ResourceUsageDictionary.h"
 #include "StringUtil.h"
 #include "TokenCollection.h"
@@ -41,8 +47,11 @@
 #include "TranslationUnitHandle.h"
 #include "TranslationUnitSaveException.h"
 #include "TranslationUnitSaveOptions.h"
+#include "TypeIdentityMap.h"
 #include "UnsavedFile.h"
 
+using namespace System::Threading;
+
 #pragma warning(push, 4)					// Enable maximum compiler warnings
 
 namespace zuki::tools::llvm::clang {
@@ -79,6 +88,9 @@ static void EnumerateIncludedFileCallback(CXFile file, CXSourceLocation* referen
 TranslationUnit::TranslationUnit(TranslationUnitHandle^ handle) : m_handle(handle)
 {
 	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
+
+	// Type instances are always shared, there are far fewer of them than cursors
+	m_handle->Types = gcnew TypeIdentityMap();
 }
 
 //---------------------------------------------------------------------------
@@ -88,9 +100,91 @@ TranslationUnit::~TranslationUnit()
 {
 	if(m_disposed) return;
 
+	__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Dispose);
+	String^ spelling = (started == 0) ? nullptr : Spelling;
+
+	if(!Object::ReferenceEquals(m_prewarmer, nullptr)) m_prewarmer->Stop();
+
 	delete m_diags;						// Dispose of the diagnostic collection
+	m_handle->Cursors = nullptr;		// Release any shared cursor instances
+	m_handle->Types = nullptr;			// Release any shared type instances
 	delete m_handle;					// Release the safe handle
 	m_disposed = true;					// Object is now in a disposed state
+
+	PerformanceCounters::EndOperation(PerformanceOperation::Dispose, started, spelling);
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::CodeCompleteAt (internal)
+//
+// Invokes clang_codeCompleteAt and applies the custom completion options
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position within the file
+//	column			- Column position within the file
+//	unsavedfiles	- Collection of unsaved code files
+//	options			- Code completion options
+
+CXCodeCompleteResults* TranslationUnit::CodeCompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options)
+{
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+	
+	// Line and column are passed as signed integers for consisency with Location, but they cannot be negative
+	if(line < 0) throw gcnew ArgumentOutOfRangeException("line");
+	if(column < 0) throw gcnew ArgumentOutOfRangeException("column");
+
+	// If the special -1 option was specified, ask libclang to provide a default options mask
+	if(options == static_cast<CompletionOptions>(-1)) options = static_cast<CompletionOptions>(clang_defaultCodeCompleteOptions());
+
+	CXCodeCompleteResults* results = __nullptr;
+
+	// Results that were computed in the background for this exact request are handed over as-is
+	if(!Object::ReferenceEquals(m_prewarmer, nullptr)) 
+		results = m_prewarmer->Take(filename, line, column, unsavedfiles, options & ~CompletionOptions::SortAlphabetical);
+
+	if(results == __nullptr) {
+
+		// Convert the managed filename into a standard C-style string to pass into the API
+		char* pszfilename = StringUtil::ToCharPointer(filename, CP_UTF8);
+
+		try { 
+
+			// Convert the enumerable range of UnsavedFile objects into an unmanaged array
+			int	numunsaved = 0;
+			CXUnsavedFile* rgunsaved = UnsavedFile::UnsavedFilesToArray(unsavedfiles, &numunsaved);
+
+			// Code completion may be running on a pre-warming thread, only one request can
+			// be processed by the translation unit at a time
+			Monitor::Enter(m_handle);
+
+			try {
+		
+				__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Completion);
+
+				// Create the code completion results without the custom sort alphabetical flag
+				results = clang_codeCompleteAt(TranslationUnitHandle::Reference(m_handle), pszfilename,
+					static_cast<unsigned int>(line), static_cast<unsigned int>(column), rgunsaved, numunsaved, 
+					static_cast<unsigned int>(options & ~CompletionOptions::SortAlphabetical));
+
+				PerformanceCounters::EndOperation(PerformanceOperation::Completion, started, filename);
+			} 
+
+			finally { Monitor::Exit(m_handle); UnsavedFile::FreeUnsavedFilesArray(rgunsaved, numunsaved); }
+		}
+
+		finally { StringUtil::FreeCharPointer(pszfilename); }
+	}
+
+	// Handle the custom sort alphabetical flag before transferring ownership to the collection, the
+	// pointers within the result set have to remain stable
+	if((options & CompletionOptions::SortAlphabetical) == CompletionOptions::SortAlphabetical) {
+
+		if(results != __nullptr) clang_sortCodeCompletionResults(results->Results, results->NumResults);
+	}
+
+	return results;
 }
 
 //---------------------------------------------------------------------------
@@ -163,46 +257,60 @@ CompletionResultCollection^ TranslationUnit::CompleteAt(String^ filename, int li
 {
 	CHECK_DISPOSED(m_disposed);
 
-	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
-	
-	// Line and column are passed as signed integers for consisency with Location, but they cannot be negative
-	if(line < 0) throw gcnew ArgumentOutOfRangeException("line");
-	if(column < 0) throw gcnew ArgumentOutOfRangeException("column");
-
-	// If the special -1 option was specified, ask libclang to provide a default options mask
-	if(options == static_cast<CompletionOptions>(-1)) options = static_cast<CompletionOptions>(clang_defaultCodeCompleteOptions());
-
-	// Convert the managed filename into a standard C-style string to pass into the API
-	char* pszfilename = StringUtil::ToCharPointer(filename, CP_UTF8);
-
-	try { 
+	// Wrap the code completion results into a CompletionResultCollection instance
+	CXCodeCompleteResults* results = CodeCompleteAt(filename, line, column, unsavedfiles, options);
+	return CompletionResultCollection::Create(m_handle, m_handle, std::move(results));
+}
 
-		// Convert the enumerable range of UnsavedFile objects into an unmanaged array
-		int	numunsaved = 0;
-		CXUnsavedFile* rgunsaved = UnsavedFile::UnsavedFilesToArray(unsavedfiles, &numunsaved);
+//---------------------------------------------------------------------------
+// TranslationUnit::CompleteAt
+//
+// Perform code completion at a given location in the translation unit and
+// select only the best fuzzy matches for a filter string
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position within the file
+//	column			- Column position within the file
+//	filterText		- Text to fuzzy match against the typed text of each result
+//	maxResults		- Maximum number of results to return
 
-		try {
-		
-			// Create the code completion results without the custom sort alphabetical flag
-			CXCodeCompleteResults* results = clang_codeCompleteAt(TranslationUnitHandle::Reference(m_handle), pszfilename,
-				static_cast<unsigned int>(line), static_cast<unsigned int>(column), rgunsaved, numunsaved, 
-				static_cast<unsigned int>(options & ~CompletionOptions::SortAlphabetical));
+CompletionResultCollection^ TranslationUnit::CompleteAt(String^ filename, int line, int column, String^ filterText, int maxResults)
+{
+	CHECK_DISPOSED(m_disposed);
+	return CompleteAt(filename, line, column, nullptr, static_cast<CompletionOptions>(-1), filterText, maxResults);
+}
 
-			// Handle the custom sort alphabetical flag before transferring ownership to the collection, the
-			// pointers within the result set have to remain stable
-			if((options & CompletionOptions::SortAlphabetical) == CompletionOptions::SortAlphabetical) {
+//---------------------------------------------------------------------------
+// TranslationUnit::CompleteAt
+//
+// Perform code completion at a given location in the translation unit and
+// select only the best fuzzy matches for a filter string
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position within the file
+//	column			- Column position within the file
+//	unsavedfiles	- Collection of unsaved code files
+//	options			- Code completion options
+//	filterText		- Text to fuzzy match against the typed text of each result
+//	maxResults		- Maximum number of results to return
 
-				if(results != __nullptr) clang_sortCodeCompletionResults(results->Results, results->NumResults);
-			}
+CompletionResultCollection^ TranslationUnit::CompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options, 
+	String^ filterText, int maxResults)
+{
+	CHECK_DISPOSED(m_disposed);
 
-			// Wrap the code completion results into a CompletionResultCollection instance
-			return CompletionResultCollection::Create(m_handle, m_handle, std::move(results));
-		} 
+	if(Object::ReferenceEquals(filterText, nullptr)) throw gcnew ArgumentNullException("filterText");
+	if(maxResults <= 0) throw gcnew ArgumentOutOfRangeException("maxResults");
 
-		finally { UnsavedFile::FreeUnsavedFilesArray(rgunsaved, numunsaved);  }
-	}
+	// The results are ranked by the filter, any requested alphabetical sort is pointless
+	if(options != static_cast<CompletionOptions>(-1)) options = options & ~CompletionOptions::SortAlphabetical;
 
-	finally { StringUtil::FreeCharPointer(pszfilename); }
+	CXCodeCompleteResults* results = CodeCompleteAt(filename, line, column, unsavedfiles, options);
+	return CompletionResultCollection::Create(m_handle, m_handle, std::move(results), filterText, maxResults);
 }
 
 //---------------------------------------------------------------------------
@@ -217,9 +325,47 @@ CompletionResultCollection^ TranslationUnit::CompleteAt(String^ filename, int li
 
 TranslationUnit^ TranslationUnit::Create(SafeHandle^ owner, CXTranslationUnit&& transunit)
 {
+	PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::TranslationUnit);
 	return gcnew TranslationUnit(gcnew TranslationUnitHandle(owner, std::move(transunit)));
 }
 
+//---------------------------------------------------------------------------
+// TranslationUnit::CreateCompletionSession
+//
+// Creates a code completion session for a file within the translation unit
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+
+CompletionSession^ TranslationUnit::CreateCompletionSession(String^ filename)
+{
+	CHECK_DISPOSED(m_disposed);
+	return CreateCompletionSession(filename, static_cast<CompletionOptions>(-1));
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::CreateCompletionSession
+//
+// Creates a code completion session for a file within the translation unit
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	options			- Code completion options
+
+CompletionSession^ TranslationUnit::CreateCompletionSession(String^ filename, CompletionOptions options)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(filename, nullptr)) throw gcnew ArgumentNullException("filename");
+
+	// The results are ranked by the session filter, any requested alphabetical sort is pointless
+	if(options != static_cast<CompletionOptions>(-1)) options = options & ~CompletionOptions::SortAlphabetical;
+
+	return CompletionSession::Create(this, filename, options);
+}
+
 //---------------------------------------------------------------------------
 // TranslationUnit::Cursor::get
 //
@@ -270,6 +416,27 @@ void TranslationUnit::EnumerateIncludedFiles(Action<File^, LocationCollection^>^
 	if(!Object::ReferenceEquals(exception, nullptr)) throw exception;
 }
 	
+//---------------------------------------------------------------------------
+// TranslationUnit::ExtractDiagnostics
+//
+// Extracts the requested properties of every diagnostic in a single pass
+//
+// Arguments:
+//
+//	fields		- Fields to be extracted from each diagnostic
+
+DiagnosticTable^ TranslationUnit::ExtractDiagnostics(DiagnosticFields fields)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Diagnostics);
+
+	DiagnosticTable^ table = DiagnosticTable::Extract(TranslationUnitHandle::Reference(m_handle), fields);
+	PerformanceCounters::EndOperation(PerformanceOperation::Diagnostics, started, (started == 0) ? nullptr : Spelling);
+
+	return table;
+}
+
 //---------------------------------------------------------------------------
 // TranslationUnit::GetFile
 //
@@ -300,6 +467,75 @@ TranslationUnitHandle^ TranslationUnit::Handle::get(void)
 	return m_handle;
 }
 	
+//---------------------------------------------------------------------------
+// TranslationUnit::LiveCount::get (static)
+//
+// Gets the number of translation units whose unmanaged resources are live
+
+int TranslationUnit::LiveCount::get(void)
+{
+	return TranslationUnitHandle::LiveCount;
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::LiveNativeBytes::get (static)
+//
+// Gets the total unmanaged memory reported by the live translation units
+
+__int64 TranslationUnit::LiveNativeBytes::get(void)
+{
+	return TranslationUnitHandle::LiveNativeBytes;
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::PrewarmCompletions
+//
+// Performs code completion in the background around a position
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position of the caret
+//	column			- Column position of the caret
+
+Task<int>^ TranslationUnit::PrewarmCompletions(String^ filename, int line, int column)
+{
+	CHECK_DISPOSED(m_disposed);
+	return PrewarmCompletions(filename, line, column, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::PrewarmCompletions
+//
+// Performs code completion in the background around a position
+//
+// Arguments:
+//
+//	filename		- Name of the file within the translation unit
+//	line			- Line position of the caret
+//	column			- Column position of the caret
+//	unsavedfiles	- Collection of unsaved code files
+
+Task<int>^ TranslationUnit::PrewarmCompletions(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(m_prewarmer, nullptr)) m_prewarmer = CompletionPrewarmer::Create(this);
+	return m_prewarmer->Start(filename, line, column, unsavedfiles);
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::PrewarmedCompletionCount::get
+//
+// Gets the number of completion requests served from pre-warmed results
+
+int TranslationUnit::PrewarmedCompletionCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	return (Object::ReferenceEquals(m_prewarmer, nullptr)) ? 0 : m_prewarmer->HitCount;
+}
+
 //---------------------------------------------------------------------------
 // TranslationUnit::ResourceUsage::get
 //
@@ -355,12 +591,43 @@ void TranslationUnit::Save(String^ path, TranslationUnitSaveOptions options)
 
 	try {
 
+		__int64 started = PerformanceCounters::BeginOperation(PerformanceOperation::Save);
+
 		CXSaveError result = static_cast<CXSaveError>(clang_saveTranslationUnit(tu, pszpath, static_cast<unsigned int>(options)));
+		PerformanceCounters::EndOperation(PerformanceOperation::Save, started, (started == 0) ? nullptr : Spelling);
+
 		if(result != CXSaveError::CXSaveError_None) throw gcnew TranslationUnitSaveException(result);
 	
 	} finally { StringUtil::FreeCharPointer(pszpath); }
 }
 
+//---------------------------------------------------------------------------
+// TranslationUnit::ShareCursorInstances::get
+//
+// Gets a flag indicating that equal cursors resolve to a shared instance
+
+bool TranslationUnit::ShareCursorInstances::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	return !Object::ReferenceEquals(m_handle->Cursors, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// TranslationUnit::ShareCursorInstances::set
+//
+// Sets a flag indicating that equal cursors resolve to a shared instance
+
+void TranslationUnit::ShareCursorInstances::set(bool value)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// Disabling the identity map releases all of the shared instances, cursors
+	// that have already been handed out remain valid but are no longer shared
+	if(!value) m_handle->Cursors = nullptr;
+	else if(Object::ReferenceEquals(m_handle->Cursors, nullptr)) m_handle->Cursors = gcnew CursorIdentityMap();
+}
+
 //---------------------------------------------------------------------------
 // TranslationUnit::Spelling::get
 //
@@ -29,6 +29,7 @@
 using namespace System;
 using namespace System::Collections::Generic;
 using namespace System::Runtime::InteropServices;
+using namespace System::Threading::Tasks;
 
 namespace zuki::tools::llvm::clang {
 namespace local = zuki::tools::llvm::clang;
@@ -36,9 +37,13 @@ namespace local = zuki::tools::llvm::clang;
 // FORWARD DECLARATIONS
 //
 enum class	CompletionOptions;
+ref class	CompletionPrewarmer;
 ref class	CompletionResultCollection;
+ref class	CompletionSession;
 ref class	Cursor;
 ref class	DiagnosticCollection;
+enum class	DiagnosticFields;
+ref class	DiagnosticTable;
 ref class	Extent;
 ref class	File;
 ref class	Location;
@@ -78,17 +83,40 @@ public:
 	CompletionResultCollection^ CompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles);
 	CompletionResultCollection^ CompleteAt(String^ filename, int line, int column, CompletionOptions options);
 	CompletionResultCollection^ CompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options);
+	CompletionResultCollection^ CompleteAt(String^ filename, int line, int column, String^ filterText, int maxResults);
+	CompletionResultCollection^ CompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options, String^ filterText, int maxResults);
+
+	// CreateCompletionSession
+	//
+	// Creates a code completion session for a file within the translation unit
+	CompletionSession^ CreateCompletionSession(String^ filename);
+	CompletionSession^ CreateCompletionSession(String^ filename, CompletionOptions options);
 
 	// EnumerateIncludedFiles
 	//
 	// Enumerates the included files of this translation unit
 	void EnumerateIncludedFiles(Action<File^, LocationCollection^>^ action);
 
+	// ExtractDiagnostics
+	//
+	// Extracts the requested properties of every diagnostic in a single pass
+	DiagnosticTable^ ExtractDiagnostics(DiagnosticFields fields);
+
 	// GetFile
 	//
 	// Gets a File instance from this translation unit
 	File^ GetFile(String^ filename);
 
+	// PrewarmCompletions
+	//
+	// Performs code completion in the background at the caret and at the nearest
+	// member access and scope resolution operators; results are used by the next
+	// CompleteAt request for the same position and unsaved file contents.  Only
+	// code completion is synchronized with the background operation, other uses
+	// of the translation unit should wait for the returned task to complete
+	Task<int>^ PrewarmCompletions(String^ filename, int line, int column);
+	Task<int>^ PrewarmCompletions(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles);
+
 	// Save
 	//
 	// Serializes the translation unit into an output file
@@ -119,6 +147,32 @@ public:
 		DiagnosticCollection^ get(void);
 	}
 
+	// LiveCount (static)
+	//
+	// Gets the number of translation units in the process whose unmanaged
+	// resources have not yet been released (disposed or finalized)
+	static property int LiveCount
+	{
+		int get(void);
+	}
+
+	// LiveNativeBytes (static)
+	//
+	// Gets the total unmanaged memory reported by the live translation units
+	static property __int64 LiveNativeBytes
+	{
+		__int64 get(void);
+	}
+
+	// PrewarmedCompletionCount
+	//
+	// Gets the number of CompleteAt requests that were served from the results
+	// computed in the background by PrewarmCompletions
+	property int PrewarmedCompletionCount
+	{
+		int get(void);
+	}
+
 	// ResourceUsage
 	//
 	// Gets the translation unit resource usage
@@ -127,6 +181,16 @@ public:
 		ResourceUsageDictionary^ get(void);
 	}
 
+	// ShareCursorInstances
+	//
+	// Gets/sets a flag indicating that equal cursors should resolve to a
+	// single shared Cursor instance (and share its cached properties)
+	property bool ShareCursorInstances
+	{
+		bool get(void);
+		void set(bool value);
+	}
+
 	// Spelling
 	//
 	// Gets the original translation unit file name
@@ -140,6 +204,11 @@ internal:
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
+	// CodeCompleteAt
+	//
+	// Invokes clang_codeCompleteAt and applies the custom completion options
+	CXCodeCompleteResults* CodeCompleteAt(String^ filename, int line, int column, IEnumerable<UnsavedFile^>^ unsavedfiles, CompletionOptions options);
+
 	// Create
 	//
 	// Creates a new TranslationUnit instance
@@ -175,6 +244,7 @@ private:
 	DiagnosticCollection^			m_diags;		// Cached diagnostics
 	String^							m_spelling;		// Cached spelling string
 	ResourceUsageDictionary^		m_usage;		// Cached resource usage
+	CompletionPrewarmer^			m_prewarmer;	// Completion pre-warmer
 };
 
 //---------------------------------------------------------------------------
@@ -29,9 +29,16 @@
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
+using namespace System::Runtime::ConstrainedExecution;
+using namespace System::Threading;
 
 namespace zuki::tools::llvm::clang {
 
+// FORWARD DECLARATIONS
+//
+ref class	CursorIdentityMap;
+ref class	TypeIdentityMap;
+
 //---------------------------------------------------------------------------
 // Class TranslationUnitHandle (internal)
 //
@@ -46,6 +53,80 @@ public:
 	//
 	TranslationUnitHandle(SafeHandle^ parent, CXTranslationUnit&& transunit) : UnmanagedTypeSafeHandle(parent, std::move(transunit))
 	{
+		// The managed wrappers are tiny compared to the unmanaged AST, let the
+		// garbage collector know how much memory finalizing this handle releases
+		CXTUResourceUsage usage = clang_getCXTUResourceUsage(*reinterpret_cast<CXTranslationUnit*>(handle.ToPointer()));
+		for(unsigned int index = 0; index < usage.numEntries; index++) m_nativebytes += usage.entries[index].amount;
+		clang_disposeCXTUResourceUsage(usage);
+
+		if(m_nativebytes > 0) GC::AddMemoryPressure(m_nativebytes);
+
+		Interlocked::Increment(s_livecount);
+		Interlocked::Add(s_livebytes, m_nativebytes);
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ReleaseHandle (SafeHandle)
+	//
+	// Releases the contained unmanaged handle/resource
+	[ReliabilityContractAttribute(Consistency::MayCorruptProcess, Cer::Success)]
+	virtual bool ReleaseHandle(void) override
+	{
+		bool result = UnmanagedTypeSafeHandle::ReleaseHandle();
+
+		if(m_nativebytes > 0) GC::RemoveMemoryPressure(m_nativebytes);
+
+		Interlocked::Decrement(s_livecount);
+		Interlocked::Add(s_livebytes, -m_nativebytes);
+
+		return result;
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Cursors
+	//
+	// Gets/sets the optional cursor identity map for the translation unit
+	property CursorIdentityMap^ Cursors
+	{
+		CursorIdentityMap^ get(void) { return m_cursors; }
+		void set(CursorIdentityMap^ value) { m_cursors = value; }
+	}
+
+	// LiveCount (static)
+	//
+	// Gets the number of unmanaged translation units that have not been released
+	static property int LiveCount
+	{
+		int get(void) { return s_livecount; }
+	}
+
+	// LiveNativeBytes (static)
+	//
+	// Gets the unmanaged memory reported by translation units that have not been released
+	static property __int64 LiveNativeBytes
+	{
+		__int64 get(void) { return Interlocked::Read(s_livebytes); }
+	}
+
+	// NativeBytes
+	//
+	// Gets the unmanaged memory reported by the translation unit when it was created
+	property __int64 NativeBytes
+	{
+		__int64 get(void) { return m_nativebytes; }
+	}
+
+	// Types
+	//
+	// Gets/sets the type identity map for the translation unit
+	property TypeIdentityMap^ Types
+	{
+		TypeIdentityMap^ get(void) { return m_types; }
+		void set(TypeIdentityMap^ value) { m_types = value; }
 	}
 
 	//-----------------------------------------------------------------------
@@ -63,6 +144,16 @@ private:
 	TranslationUnitHandle(nullptr_t) : UnmanagedTypeSafeHandle(CXTranslationUnit(__nullptr))
 	{
 	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CursorIdentityMap^		m_cursors;		// Optional cursor identity map
+	__int64					m_nativebytes;	// Reported unmanaged memory
+	TypeIdentityMap^		m_types;		// Type identity map
+
+	static int				s_livecount;	// Live translation unit count
+	static __int64			s_livebytes;	// Live translation unit memory
 };
 
 //---------------------------------------------------------------------------
@@ -24,6 +24,7 @@
 #define __TRANSLATIONUNITREFERENCEHANDLE_H_
 #pragma once
 
+#include "PerformanceCounters.h"
 #include "TranslationUnitHandle.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
@@ -91,15 +92,19 @@ public:
 					m_handle->m_outer->DangerousRelease();
 					throw gcnew ObjectDisposedException(m_handle->m_inner->GetType()->Name);
 				}
+
+				PerformanceCounters::HandleAddRef();
 			}
+
+			PerformanceCounters::HandleAddRef();
 		}
 
 		// Destructor
 		//
 		~Reference() 
 		{ 
-			if(m_releaseinner) m_handle->m_inner->DangerousRelease(); 
-			if(m_releaseouter) m_handle->m_outer->DangerousRelease();
+			if(m_releaseinner) { m_handle->m_inner->DangerousRelease(); PerformanceCounters::HandleRelease(); }
+			if(m_releaseouter) { m_handle->m_outer->DangerousRelease(); PerformanceCounters::HandleRelease(); }
 		}
 
 		// pointer-to-member operator
@@ -162,14 +167,16 @@ private:
 	~TranslationUnitReferenceHandle()
 	{
 		if(m_disposed) return;
-		this->!TranslationUnitReferenceHandle();
 		m_disposed = true;
+		this->!TranslationUnitReferenceHandle();
 	}
 
 	// Finalizer
 	//
 	!TranslationUnitReferenceHandle()
 	{
+		if(!m_disposed) PerformanceCounters::Finalized();
+
 		if(m_pointer) delete m_pointer;
 		m_pointer = __nullptr;
 	}
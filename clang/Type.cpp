@@ -31,11 +31,14 @@
 #include "EnumerateFieldsFunc.h"
 #include "EnumerateFieldsResult.h"
 #include "GCHandleRef.h"
+#include "PerformanceCounters.h"
 #include "StringUtil.h"
 #include "TemplateArgumentTypeCollection.h"
 #include "TypeCollection.h"
 #include "TypeFieldOffsets.h"
+#include "TypeIdentityMap.h"
 #include "TypeKind.h"
+#include "Utf8String.h"
 
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
@@ -169,7 +172,23 @@ local::CallingConvention Type::CallingConvention::get(void)
 
 Type^ Type::Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXType type)
 {
-	return gcnew Type(gcnew TypeHandle(owner, transunit, type));
+	// Only types owned directly by the translation unit can be shared, types
+	// owned by another object (completion results, etc) must keep that owner alive
+	TypeIdentityMap^ map = (Object::ReferenceEquals(owner, transunit)) ? transunit->Types : nullptr;
+	if(Object::ReferenceEquals(map, nullptr)) {
+
+		PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Type);
+		return gcnew Type(gcnew TypeHandle(owner, transunit, type));
+	}
+
+	Type^ instance = map->Find(type);
+	if(Object::ReferenceEquals(instance, nullptr)) {
+
+		PerformanceCounters::ObjectCreated(PerformanceCounters::ObjectType::Type);
+		instance = map->Add(type, gcnew Type(gcnew TypeHandle(owner, transunit, type)));
+	}
+
+	return instance;
 }
 
 //---------------------------------------------------------------------------
@@ -336,6 +355,31 @@ int Type::GetHashCode(void)
 	return intptr_t(type.data[0]).GetHashCode() ^ intptr_t(type.data[1]).GetHashCode();
 }
 
+//---------------------------------------------------------------------------
+// Type::GetSpellingUtf8
+//
+// Gets the spelling of this type as raw UTF-8
+//
+// Arguments:
+//
+//	NONE
+
+Utf8String^ Type::GetSpellingUtf8(void)
+{
+	// This is a method not a property, the caller owns the returned object
+	return Utf8String::Create(clang_getTypeSpelling(TypeHandle::Reference(m_handle)));
+}
+
+//---------------------------------------------------------------------------
+// Type::Handle::get (internal)
+//
+// Exposes the underlying TypeHandle
+
+Type::TypeHandle^ Type::Handle::get(void)
+{
+	return m_handle;
+}
+
 //---------------------------------------------------------------------------
 // Type::IsConstQualified::Get
 //
@@ -43,6 +43,7 @@ value class EnumerateFieldsResult;
 ref class	TypeCollection;
 ref class	TypeFieldOffsets;
 value class	TypeKind;
+ref class	Utf8String;
 
 //---------------------------------------------------------------------------
 // Class Type
@@ -88,6 +89,11 @@ public:
 	// Overrides Object::GetHashCode()
 	virtual int GetHashCode(void) override;
 
+	// GetSpellingUtf8
+	//
+	// Gets the spelling of this Type as raw UTF-8
+	Utf8String^ GetSpellingUtf8(void);
+
 	// ToString
 	//
 	// Overrides Object::ToString()
@@ -298,6 +304,11 @@ public:
 
 internal:
 
+	// TypeHandle
+	//
+	// TranslationUnitReferenceHandle specialization for CXType
+	using TypeHandle = TranslationUnitReferenceHandle<CXType>;
+
 	//-----------------------------------------------------------------------
 	// Internal Member Functions
 
@@ -306,12 +317,18 @@ internal:
 	// Creates a new Type instance
 	static Type^ Create(SafeHandle^ owner, TranslationUnitHandle^ transunit, CXType type);
 
-private:
+	//-----------------------------------------------------------------------
+	// Internal Properties
 
-	// TypeHandle
+	// Handle
 	//
-	// TranslationUnitReferenceHandle specialization for CXType
-	using TypeHandle = TranslationUnitReferenceHandle<CXType>;
+	// Exposes the underlying TypeHandle
+	property TypeHandle^ Handle
+	{
+		TypeHandle^ get(void);
+	}
+
+private:
 
 	// Instance Constructor
 	//
@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "TypeIdentityMap.h"
+
+#include "Type.h"
+
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap Constructor
+//
+// Arguments:
+//
+//	NONE
+
+TypeIdentityMap::TypeIdentityMap() : m_buckets(gcnew Dictionary<int, List<Type^>^>()), m_count(0)
+{
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Add
+//
+// Adds a type instance to the map, returns the instance that was mapped
+//
+// Arguments:
+//
+//	type		- Unmanaged type that the instance wraps
+//	instance	- Type instance to be shared
+
+Type^ TypeIdentityMap::Add(CXType type, Type^ instance)
+{
+	if(Object::ReferenceEquals(instance, nullptr)) throw gcnew ArgumentNullException("instance");
+
+	int hash = Hash(type);
+
+	// Types can be resolved from more than one thread at a time
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		List<Type^>^ bucket = nullptr;
+		if(!m_buckets->TryGetValue(hash, bucket)) {
+
+			bucket = gcnew List<Type^>(1);
+			m_buckets->Add(hash, bucket);
+		}
+
+		// If an equal type was mapped in the meantime, that instance wins
+		Type^ existing = Find(bucket, type);
+		if(!Object::ReferenceEquals(existing, nullptr)) return existing;
+
+		bucket->Add(instance);
+		m_count++;
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+
+	return instance;
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Clear
+//
+// Removes all type instances from the map
+//
+// Arguments:
+//
+//	NONE
+
+void TypeIdentityMap::Clear(void)
+{
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		m_buckets->Clear();
+		m_count = 0;
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Count::get
+//
+// Gets the number of type instances held by the map
+
+int TypeIdentityMap::Count::get(void)
+{
+	return m_count;
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Find
+//
+// Locates the shared instance for a type, or nullptr if not mapped
+//
+// Arguments:
+//
+//	type		- Unmanaged type to locate
+
+Type^ TypeIdentityMap::Find(CXType type)
+{
+	int hash = Hash(type);
+
+	Monitor::Enter(m_buckets);
+
+	try {
+
+		List<Type^>^ bucket = nullptr;
+		if(!m_buckets->TryGetValue(hash, bucket)) return nullptr;
+
+		return Find(bucket, type);
+	}
+
+	finally { Monitor::Exit(m_buckets); }
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Find (private, static)
+//
+// Locates a shared instance within a single hash bucket
+//
+// Arguments:
+//
+//	bucket		- Hash bucket to be searched
+//	type		- Unmanaged type to locate
+
+Type^ TypeIdentityMap::Find(List<Type^>^ bucket, CXType type)
+{
+	for each(Type^ instance in bucket) {
+
+		if(clang_equalTypes(type, Type::TypeHandle::Reference(instance->Handle)) != 0) return instance;
+	}
+
+	return nullptr;
+}
+
+//---------------------------------------------------------------------------
+// TypeIdentityMap::Hash (private, static)
+//
+// Generates the bucket hash for an unmanaged type
+//
+// Arguments:
+//
+//	type		- Unmanaged type to be hashed
+
+int TypeIdentityMap::Hash(CXType type)
+{
+	// Same as Type::GetHashCode, these are the fields used by clang_equalTypes
+	return intptr_t(type.data[0]).GetHashCode() ^ intptr_t(type.data[1]).GetHashCode();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __TYPEIDENTITYMAP_H_
+#define __TYPEIDENTITYMAP_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	Type;
+
+//---------------------------------------------------------------------------
+// Class TypeIdentityMap (internal)
+//
+// Maps unmanaged types to a single shared Type instance so that equal types
+// retrieved through different paths share their cached spelling, canonical
+// type and so on.  Lookups are keyed by the CXType fields compared by
+// clang_equalTypes and verified with clang_equalTypes
+//---------------------------------------------------------------------------
+
+ref class TypeIdentityMap
+{
+public:
+
+	// Instance Constructor
+	//
+	TypeIdentityMap();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Add
+	//
+	// Adds a type instance to the map, returns the instance that was mapped
+	Type^ Add(CXType type, Type^ instance);
+
+	// Clear
+	//
+	// Removes all type instances from the map
+	void Clear(void);
+
+	// Find
+	//
+	// Locates the shared instance for a type, or nullptr if not mapped
+	Type^ Find(CXType type);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of type instances held by the map
+	property int Count
+	{
+		int get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Find
+	//
+	// Locates a shared instance within a single hash bucket
+	static Type^ Find(List<Type^>^ bucket, CXType type);
+
+	// Hash
+	//
+	// Generates the bucket hash for an unmanaged type
+	static int Hash(CXType type);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<int, List<Type^>^>^	m_buckets;	// Types by hash
+	int								m_count;	// Number of types
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __TYPEIDENTITYMAP_H_
@@ -26,19 +26,42 @@
 #include "Cursor.h"
 #include "StringUtil.h"
 
+using namespace System::Runtime::InteropServices;
+
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 namespace zuki::tools::llvm::clang {
 
+//---------------------------------------------------------------------------
+// ToByteArray (local)
+//
+// Copies an unmanaged UTF-8 string into a managed byte array
+//
+// Arguments:
+//
+//	psz			- Unmanaged UTF-8 string to be copied
+
+static array<Byte>^ ToByteArray(const char* psz)
+{
+	size_t cb = (psz == __nullptr) ? 0 : strlen(psz);
+	if(cb > static_cast<size_t>(Int32::MaxValue)) throw gcnew OverflowException();
+
+	array<Byte>^ bytes = gcnew array<Byte>(static_cast<int>(cb));
+	if(cb > 0) Marshal::Copy(IntPtr(const_cast<char*>(psz)), bytes, 0, static_cast<int>(cb));
+
+	return bytes;
+}
+
 //---------------------------------------------------------------------------
 // UnifiedSymbolResolution Constructor (private)
 //
 // Arguments:
 //
-//	usr			- Unified symbol resolution string
+//	utf8		- Unified symbol resolution string as raw UTF-8 bytes
 
-UnifiedSymbolResolution::UnifiedSymbolResolution(String^ usr) : m_usr(usr)
+UnifiedSymbolResolution::UnifiedSymbolResolution(array<Byte>^ utf8) : m_utf8(utf8)
 {
+	if(Object::ReferenceEquals(utf8, nullptr)) throw gcnew ArgumentNullException("utf8");
 }
 
 //---------------------------------------------------------------------------
@@ -49,7 +72,14 @@ bool UnifiedSymbolResolution::operator==(UnifiedSymbolResolution^ lhs, UnifiedSy
 	if(Object::ReferenceEquals(lhs, rhs)) return true;
 	if(Object::ReferenceEquals(lhs, nullptr) || Object::ReferenceEquals(rhs, nullptr)) return false;
 
-	return (String::Compare(lhs->m_usr, rhs->m_usr) == 0);
+	// Compare the raw UTF-8 bytes rather than forcing a conversion into System::String
+	if(lhs->m_utf8->Length != rhs->m_utf8->Length) return false;
+	if(lhs->m_utf8->Length == 0) return true;
+
+	pin_ptr<Byte> pinlhs = &lhs->m_utf8[0];
+	pin_ptr<Byte> pinrhs = &rhs->m_utf8[0];
+
+	return (memcmp(pinlhs, pinrhs, lhs->m_utf8->Length) == 0);
 }
 
 //---------------------------------------------------------------------------
@@ -57,10 +87,7 @@ bool UnifiedSymbolResolution::operator==(UnifiedSymbolResolution^ lhs, UnifiedSy
 
 bool UnifiedSymbolResolution::operator!=(UnifiedSymbolResolution^ lhs, UnifiedSymbolResolution^ rhs)
 {
-	if(Object::ReferenceEquals(lhs, rhs)) return false;
-	if(Object::ReferenceEquals(lhs, nullptr) || Object::ReferenceEquals(rhs, nullptr)) return true;
-
-	return (String::Compare(lhs->m_usr, rhs->m_usr) != 0);
+	return !(lhs == rhs);
 }
 
 //---------------------------------------------------------------------------
@@ -69,7 +96,26 @@ bool UnifiedSymbolResolution::operator!=(UnifiedSymbolResolution^ lhs, UnifiedSy
 UnifiedSymbolResolution::operator String^(UnifiedSymbolResolution^ rhs)
 {
 	if(Object::ReferenceEquals(rhs, nullptr)) return String::Empty;
-	return rhs->m_usr;
+	return rhs->ToString();
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolution::CopyUtf8To
+//
+// Copies the raw UTF-8 bytes of the USR into an existing buffer
+//
+// Arguments:
+//
+//	destination		- Destination buffer
+//	offset			- Offset within the destination buffer to begin copying
+
+void UnifiedSymbolResolution::CopyUtf8To(array<Byte>^ destination, int offset)
+{
+	if(Object::ReferenceEquals(destination, nullptr)) throw gcnew ArgumentNullException("destination");
+	if((offset < 0) || (offset > destination->Length)) throw gcnew ArgumentOutOfRangeException("offset");
+	if(destination->Length - offset < m_utf8->Length) throw gcnew ArgumentException("Destination buffer is not large enough", "destination");
+
+	Array::Copy(m_utf8, 0, destination, offset, m_utf8->Length);
 }
 	
 //---------------------------------------------------------------------------
@@ -83,8 +129,10 @@ UnifiedSymbolResolution::operator String^(UnifiedSymbolResolution^ rhs)
 
 UnifiedSymbolResolution^ UnifiedSymbolResolution::Create(CXString&& string)
 {
-	// Dispose of the CXString after conversion into System::String
-	return gcnew UnifiedSymbolResolution(StringUtil::ToString(std::move(string)));
+	// Dispose of the CXString after copying the raw bytes, conversion into
+	// System::String is deferred until the string is actually requested
+	try { return gcnew UnifiedSymbolResolution(ToByteArray(clang_getCString(string))); }
+	finally { clang_disposeString(string); memset(&string, 0, sizeof(CXString)); }
 }
 
 //---------------------------------------------------------------------------
@@ -98,7 +146,21 @@ UnifiedSymbolResolution^ UnifiedSymbolResolution::Create(CXString&& string)
 
 UnifiedSymbolResolution^ UnifiedSymbolResolution::Create(const char* psz)
 {
-	return gcnew UnifiedSymbolResolution(StringUtil::ToString(psz, CP_UTF8));
+	return gcnew UnifiedSymbolResolution(ToByteArray(psz));
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolution::Create (internal, static)
+//
+// Creates a new UnifiedSymbolResolution instance
+//
+// Arguments:
+//
+//	utf8		- Raw UTF-8 bytes of the USR, the array is not copied
+
+UnifiedSymbolResolution^ UnifiedSymbolResolution::Create(array<Byte>^ utf8)
+{
+	return gcnew UnifiedSymbolResolution(utf8);
 }
 
 //---------------------------------------------------------------------------
@@ -293,7 +355,12 @@ UnifiedSymbolResolution^ UnifiedSymbolResolution::FromObjectiveCProtocol(String^
 
 int UnifiedSymbolResolution::GetHashCode(void)
 {
-	return m_usr->GetHashCode();
+	if(m_utf8->Length == 0) return 0;
+
+	pin_ptr<Byte> pinutf8 = &m_utf8[0];
+	uint64_t hash = StringUtil::Hash(reinterpret_cast<const char*>(pinutf8), m_utf8->Length);
+
+	return static_cast<int>(hash ^ (hash >> 32));
 }
 
 //---------------------------------------------------------------------------
@@ -307,9 +374,53 @@ int UnifiedSymbolResolution::GetHashCode(void)
 
 String^ UnifiedSymbolResolution::ToString(void)
 {
+	if(Object::ReferenceEquals(m_usr, nullptr)) {
+
+		if(m_utf8->Length == 0) m_usr = String::Empty;
+		else {
+
+			pin_ptr<Byte> pinutf8 = &m_utf8[0];
+			m_usr = StringUtil::ToString(reinterpret_cast<const char*>(pinutf8), m_utf8->Length, CP_UTF8);
+		}
+	}
+
 	return m_usr;
 }
 
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolution::ToUtf8Array
+//
+// Copies the raw UTF-8 bytes of the USR into a new byte array
+//
+// Arguments:
+//
+//	NONE
+
+array<Byte>^ UnifiedSymbolResolution::ToUtf8Array(void)
+{
+	return safe_cast<array<Byte>^>(m_utf8->Clone());
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolution::Utf8::get (internal)
+//
+// Exposes the raw UTF-8 bytes of the USR without copying them
+
+array<Byte>^ UnifiedSymbolResolution::Utf8::get(void)
+{
+	return m_utf8;
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolution::Utf8Length::get
+//
+// Gets the length of the USR string, in UTF-8 bytes
+
+int UnifiedSymbolResolution::Utf8Length::get(void)
+{
+	return m_utf8->Length;
+}
+
 //---------------------------------------------------------------------------
 
 } // zuki::tools::llvm::clang
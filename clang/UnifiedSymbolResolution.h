@@ -63,6 +63,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// CopyUtf8To
+	//
+	// Copies the raw UTF-8 bytes of the USR into an existing buffer
+	void CopyUtf8To(array<Byte>^ destination, int offset);
+
 	// Equals
 	//
 	// Overrides Object::Equals()
@@ -113,6 +118,22 @@ public:
 	// Overrides Object::ToString()
 	virtual String^ ToString(void) override;
 
+	// ToUtf8Array
+	//
+	// Copies the raw UTF-8 bytes of the USR into a new byte array
+	array<Byte>^ ToUtf8Array(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Utf8Length
+	//
+	// Gets the length of the USR string, in UTF-8 bytes
+	property int Utf8Length
+	{
+		int get(void);
+	}
+
 internal:
 
 	//-----------------------------------------------------------------------
@@ -123,16 +144,29 @@ internal:
 	// Creates a new UnifiedSymbolResolution instance
 	static UnifiedSymbolResolution^ Create(CXString&& string);
 	static UnifiedSymbolResolution^ Create(const char* psz);
+	static UnifiedSymbolResolution^ Create(array<Byte>^ utf8);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Utf8
+	//
+	// Exposes the raw UTF-8 bytes of the USR without copying them
+	property array<Byte>^ Utf8
+	{
+		array<Byte>^ get(void);
+	}
 
 private:
 
 	// Instance Constructor
 	//
-	UnifiedSymbolResolution(String^ usr);
+	UnifiedSymbolResolution(array<Byte>^ utf8);
 
 	//-----------------------------------------------------------------------
 	// Member Variables
 
+	array<Byte>^			m_utf8;		// Raw UTF-8 string bytes
 	String^					m_usr;		// Converted string instance
 };
 
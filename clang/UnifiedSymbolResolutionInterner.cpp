@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "UnifiedSymbolResolutionInterner.h"
+
+#include "StringUtil.h"
+#include "UnifiedSymbolResolution.h"
+
+using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner Constructor
+//
+// Arguments:
+//
+//	NONE
+
+UnifiedSymbolResolutionInterner::UnifiedSymbolResolutionInterner() : m_ids(gcnew Dictionary<UInt64, int>()), m_next(gcnew List<int>()),
+	m_bytes(gcnew List<array<Byte>^>())
+{
+	// Identifier zero is reserved for the empty USR
+	m_next->Add(0);
+	m_bytes->Add(gcnew array<Byte>(0));
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::Count::get
+//
+// Gets the number of identifiers that have been assigned, including zero
+
+int UnifiedSymbolResolutionInterner::Count::get(void)
+{
+	Monitor::Enter(m_ids);
+
+	try { return m_bytes->Count; }
+	finally { Monitor::Exit(m_ids); }
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::Default::get (static)
+//
+// Gets the process-wide interner instance
+
+UnifiedSymbolResolutionInterner^ UnifiedSymbolResolutionInterner::Default::get(void)
+{
+	return s_default;
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::GetId
+//
+// Gets the identifier for a USR, assigning a new identifier if necessary
+//
+// Arguments:
+//
+//	usr			- USR for which to get the identifier
+
+int UnifiedSymbolResolutionInterner::GetId(UnifiedSymbolResolution^ usr)
+{
+	if(Object::ReferenceEquals(usr, nullptr)) throw gcnew ArgumentNullException("usr");
+
+	array<Byte>^ bytes = usr->Utf8;
+	if(bytes->Length == 0) return 0;
+
+	pin_ptr<Byte> pinbytes = &bytes[0];
+	return Intern(pinbytes, bytes->Length);
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::GetUnifiedSymbolResolution
+//
+// Gets the USR that has been assigned an identifier
+//
+// Arguments:
+//
+//	id			- Identifier of the USR
+
+UnifiedSymbolResolution^ UnifiedSymbolResolutionInterner::GetUnifiedSymbolResolution(int id)
+{
+	Monitor::Enter(m_ids);
+
+	try {
+
+		if((id < 0) || (id >= m_bytes->Count)) throw gcnew ArgumentOutOfRangeException("id");
+		return UnifiedSymbolResolution::Create(m_bytes[id]);
+	}
+
+	finally { Monitor::Exit(m_ids); }
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::Intern (internal)
+//
+// Gets the identifier for an unmanaged USR string
+//
+// Arguments:
+//
+//	psz			- Unmanaged UTF-8 USR string
+
+int UnifiedSymbolResolutionInterner::Intern(const char* psz)
+{
+	if((psz == __nullptr) || (*psz == '\0')) return 0;
+
+	size_t cb = strlen(psz);
+	if(cb > static_cast<size_t>(Int32::MaxValue)) throw gcnew OverflowException();
+
+	return Intern(reinterpret_cast<const unsigned char*>(psz), static_cast<int>(cb));
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::Intern (internal)
+//
+// Gets the identifier for an unmanaged USR string and disposes it
+//
+// Arguments:
+//
+//	string		- CXString rvalue reference
+
+int UnifiedSymbolResolutionInterner::Intern(CXString&& string)
+{
+	try { return Intern(clang_getCString(string)); }
+	finally { clang_disposeString(string); memset(&string, 0, sizeof(CXString)); }
+}
+
+//---------------------------------------------------------------------------
+// UnifiedSymbolResolutionInterner::Intern (private)
+//
+// Gets the identifier for a raw UTF-8 USR string
+//
+// Arguments:
+//
+//	bytes		- Raw UTF-8 USR string bytes
+//	cb			- Length of the USR string in bytes
+
+int UnifiedSymbolResolutionInterner::Intern(const unsigned char* bytes, int cb)
+{
+	int					first = 0;			// First identifier with the hash
+
+	// Hash outside of the lock, only the table operations need to be serialized
+	UInt64 hash = StringUtil::Hash(reinterpret_cast<const char*>(bytes), static_cast<size_t>(cb));
+
+	Monitor::Enter(m_ids);
+
+	try {
+
+		// Walk the chain of identifiers that share the hash, comparing the raw bytes
+		if(m_ids->TryGetValue(hash, first)) {
+
+			for(int id = first; id != 0; id = m_next[id]) {
+
+				array<Byte>^ existing = m_bytes[id];
+				if(existing->Length != cb) continue;
+
+				pin_ptr<Byte> pinexisting = &existing[0];
+				if(memcmp(pinexisting, bytes, cb) == 0) return id;
+			}
+		}
+
+		// Keep a copy of the raw bytes to verify future matches against
+		array<Byte>^ copy = gcnew array<Byte>(cb);
+		Marshal::Copy(IntPtr(const_cast<unsigned char*>(bytes)), copy, 0, cb);
+
+		// New identifiers are pushed onto the front of the chain for the hash
+		int id = m_bytes->Count;
+		m_bytes->Add(copy);
+		m_next->Add(first);
+		m_ids[hash] = id;
+
+		return id;
+	}
+
+	finally { Monitor::Exit(m_ids); }
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __UNIFIEDSYMBOLRESOLUTIONINTERNER_H_
+#define __UNIFIEDSYMBOLRESOLUTIONINTERNER_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	UnifiedSymbolResolution;
+
+//---------------------------------------------------------------------------
+// Class UnifiedSymbolResolutionInterner
+//
+// Maps Unified Symbol Resolution (USR) strings to dense integer identifiers
+// so that symbol tables can be keyed on an int rather than on the string.
+// Lookups hash the raw UTF-8 bytes directly from libclang and collisions are
+// resolved by comparing the bytes.  Identifier zero is reserved for an empty
+// USR.  Instances are thread-safe; the Default instance is process-wide and
+// is used by the UnifiedSymbolResolutionId properties
+//---------------------------------------------------------------------------
+
+public ref class UnifiedSymbolResolutionInterner
+{
+public:
+
+	// Instance Constructor
+	//
+	UnifiedSymbolResolutionInterner();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetId
+	//
+	// Gets the identifier for a USR, assigning a new identifier if necessary
+	int GetId(UnifiedSymbolResolution^ usr);
+
+	// GetUnifiedSymbolResolution
+	//
+	// Gets the USR that has been assigned an identifier
+	UnifiedSymbolResolution^ GetUnifiedSymbolResolution(int id);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of identifiers that have been assigned, including zero
+	property int Count
+	{
+		int get(void);
+	}
+
+	// Default (static)
+	//
+	// Gets the process-wide interner instance
+	static property UnifiedSymbolResolutionInterner^ Default
+	{
+		UnifiedSymbolResolutionInterner^ get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Intern
+	//
+	// Gets the identifier for an unmanaged USR string
+	int Intern(const char* psz);
+	int Intern(CXString&& string);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Intern
+	//
+	// Gets the identifier for a raw UTF-8 USR string
+	int Intern(const unsigned char* bytes, int cb);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<UInt64, int>^		m_ids;			// First identifier by hash
+	List<int>^						m_next;			// Next identifier with the same hash
+	List<array<Byte>^>^				m_bytes;		// Raw UTF-8 bytes by identifier
+
+	static initonly UnifiedSymbolResolutionInterner^ s_default = gcnew UnifiedSymbolResolutionInterner();
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __UNIFIEDSYMBOLRESOLUTIONINTERNER_H_
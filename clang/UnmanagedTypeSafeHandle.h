@@ -24,6 +24,8 @@
 #define __UNMANAGEDTYPESAFEHANDLE_H_
 #pragma once
 
+#include "PerformanceCounters.h"
+
 #pragma warning(push, 4)				// Enable maximum compiler warnings
 
 using namespace System;
@@ -89,11 +91,13 @@ public:
 			
 			m_handle->DangerousAddRef(m_release);
 			if(!m_release) throw gcnew ObjectDisposedException(UnmanagedTypeSafeHandle<_type, _dispose>::typeid->Name);
+
+			PerformanceCounters::HandleAddRef();
 		}
 
 		// Destructor
 		//
-		~Reference() { if(m_release) m_handle->DangerousRelease(); }
+		~Reference() { if(m_release) { m_handle->DangerousRelease(); PerformanceCounters::HandleRelease(); } }
 
 		// Pointer-to-member operator
 		//
@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Utf8String.h"
+
+#include "StringUtil.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Utf8String Constructor (private)
+//
+// Arguments:
+//
+//	handle		- Underlying StringHandle instance
+
+Utf8String::Utf8String(StringHandle^ handle) : m_handle(handle)
+{
+	if(Object::ReferenceEquals(handle, nullptr)) throw gcnew ArgumentNullException("handle");
+
+	// The length of the string is fixed, determine it once during construction
+	const char* psz = clang_getCString(StringHandle::Reference(m_handle));
+	size_t cb = (psz == __nullptr) ? 0 : strlen(psz);
+
+	if(cb > static_cast<size_t>(Int32::MaxValue)) throw gcnew OverflowException();
+	m_length = static_cast<int>(cb);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String Destructor
+
+Utf8String::~Utf8String()
+{
+	if(m_disposed) return;
+
+	delete m_handle;					// Release the safe handle
+	m_disposed = true;					// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::operator == (static)
+
+bool Utf8String::operator==(Utf8String^ lhs, Utf8String^ rhs)
+{
+	if(Object::ReferenceEquals(lhs, rhs)) return true;
+	if(Object::ReferenceEquals(lhs, nullptr) || Object::ReferenceEquals(rhs, nullptr)) return false;
+
+	CHECK_DISPOSED(lhs->m_disposed);
+	CHECK_DISPOSED(rhs->m_disposed);
+
+	if(lhs->m_length != rhs->m_length) return false;
+	if(lhs->m_length == 0) return true;
+
+	StringHandle::Reference lhsstring(lhs->m_handle);
+	StringHandle::Reference rhsstring(rhs->m_handle);
+
+	return (memcmp(clang_getCString(lhsstring), clang_getCString(rhsstring), lhs->m_length) == 0);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::operator != (static)
+
+bool Utf8String::operator!=(Utf8String^ lhs, Utf8String^ rhs)
+{
+	return !(lhs == rhs);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::CopyTo
+//
+// Copies the UTF-8 bytes of this string into an existing buffer
+//
+// Arguments:
+//
+//	destination		- Destination buffer
+//	offset			- Offset within the destination buffer to begin copying
+
+void Utf8String::CopyTo(array<Byte>^ destination, int offset)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(destination, nullptr)) throw gcnew ArgumentNullException("destination");
+	if((offset < 0) || (offset > destination->Length)) throw gcnew ArgumentOutOfRangeException("offset");
+	if(destination->Length - offset < m_length) throw gcnew ArgumentException("Destination buffer is not large enough", "destination");
+
+	if(m_length == 0) return;
+
+	StringHandle::Reference string(m_handle);
+	Marshal::Copy(IntPtr(const_cast<char*>(clang_getCString(string))), destination, offset, m_length);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::Create (internal, static)
+//
+// Creates a new Utf8String instance
+//
+// Arguments:
+//
+//	string		- CXString to take ownership of
+
+Utf8String^ Utf8String::Create(CXString&& string)
+{
+	return gcnew Utf8String(gcnew StringHandle(std::move(string)));
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::default[int]::get
+//
+// Gets the byte at the specified index in the string
+
+Byte Utf8String::default::get(int index)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((index < 0) || (index >= m_length)) throw gcnew ArgumentOutOfRangeException("index");
+	return static_cast<Byte>(clang_getCString(StringHandle::Reference(m_handle))[index]);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::Equals
+//
+// Compares this Utf8String instance to another Utf8String instance
+//
+// Arguments:
+//
+//	rhs		- Right-hand Utf8String instance to compare against
+
+bool Utf8String::Equals(Utf8String^ rhs)
+{
+	return (this == rhs);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::Equals
+//
+// Overrides Object::Equals()
+//
+// Arguments:
+//
+//	rhs		- Right-hand object instance to compare against
+
+bool Utf8String::Equals(Object^ rhs)
+{
+	if(Object::ReferenceEquals(rhs, nullptr)) return false;
+
+	// Convert the provided object into a Utf8String instance
+	Utf8String^ rhsref = dynamic_cast<Utf8String^>(rhs);
+	if(rhsref == nullptr) return false;
+
+	return (this == rhsref);
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::GetHashCode
+//
+// Overrides Object::GetHashCode()
+//
+// Arguments:
+//
+//	NONE
+
+int Utf8String::GetHashCode(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	uint64_t hash = StringUtil::Hash(clang_getCString(StringHandle::Reference(m_handle)), m_length);
+	return static_cast<int>(hash ^ (hash >> 32));
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::Length::get
+//
+// Gets the length of the string, in bytes
+
+int Utf8String::Length::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_length;
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::ToArray
+//
+// Copies the UTF-8 bytes of this string into a new byte array
+//
+// Arguments:
+//
+//	NONE
+
+array<Byte>^ Utf8String::ToArray(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	array<Byte>^ bytes = gcnew array<Byte>(m_length);
+	CopyTo(bytes, 0);
+
+	return bytes;
+}
+
+//---------------------------------------------------------------------------
+// Utf8String::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ Utf8String::ToString(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return StringUtil::ToString(clang_getCString(StringHandle::Reference(m_handle)), m_length, CP_UTF8);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __UTF8STRING_H_
+#define __UTF8STRING_H_
+#pragma once
+
+#include "UnmanagedTypeSafeHandle.h"
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// Class Utf8String
+//
+// Exposes the raw UTF-8 contents of an unmanaged clang string without any
+// conversion into a UTF-16 System::String.  The underlying string is owned
+// by this object and is released when the object is disposed of
+//---------------------------------------------------------------------------
+
+public ref class Utf8String
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Overloaded Operators
+
+	// operator== (static)
+	//
+	static bool operator==(Utf8String^ lhs, Utf8String^ rhs);
+
+	// operator!= (static)
+	//
+	static bool operator!=(Utf8String^ lhs, Utf8String^ rhs);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// CopyTo
+	//
+	// Copies the UTF-8 bytes of this string into an existing buffer
+	void CopyTo(array<Byte>^ destination, int offset);
+
+	// Equals
+	//
+	// Overrides Object::Equals()
+	virtual bool Equals(Object^ rhs) override;
+
+	// Equals
+	//
+	// Compares this Utf8String instance to another Utf8String instance
+	bool Equals(Utf8String^ rhs);
+
+	// GetHashCode
+	//
+	// Overrides Object::GetHashCode()
+	virtual int GetHashCode(void) override;
+
+	// ToArray
+	//
+	// Copies the UTF-8 bytes of this string into a new byte array
+	array<Byte>^ ToArray(void);
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// default[int]
+	//
+	// Gets the byte at the specified index in the string
+	property Byte default[int]
+	{
+		Byte get(int index);
+	}
+
+	// Length
+	//
+	// Gets the length of the string, in bytes
+	property int Length
+	{
+		int get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new Utf8String instance
+	static Utf8String^ Create(CXString&& string);
+
+private:
+
+	// StringHandle
+	//
+	// UnmanagedTypeSafeHandle specialization for CXString
+	using StringHandle = UnmanagedTypeSafeHandle<CXString, clang_disposeString>;
+
+	// Instance Constructor
+	//
+	Utf8String(StringHandle^ handle);
+
+	// Destructor
+	//
+	~Utf8String();
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed;			// Object disposal flag
+	StringHandle^				m_handle;			// Underlying safe handle
+	int							m_length;			// Length of the string
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __UTF8STRING_H_
@@ -0,0 +1,479 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#include "stdafx.h"
+#include "WorkspaceSnapshot.h"
+
+#include "Clang.h"
+#include "Index.h"
+#include "StringUtil.h"
+#include "TranslationUnit.h"
+#include "TranslationUnitParseOptions.h"
+#include "UnsavedFile.h"
+#include "VirtualFileOverlay.h"
+
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+using namespace System::Text;
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+namespace zuki::tools::llvm::clang {
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot Constructor (private)
+//
+// Arguments:
+//
+//	entries		- Files to include in the snapshot
+//	contents	- Distinct file contents keyed by hash
+
+WorkspaceSnapshot::WorkspaceSnapshot(List<Entry^>^ entries, Dictionary<UInt64, FileContent^>^ contents) : m_entries(entries), 
+	m_paths(gcnew Dictionary<String^, Entry^>(StringComparer::OrdinalIgnoreCase)), m_contents(contents), m_unsaved(__nullptr), m_numunsaved(0)
+{
+	if(Object::ReferenceEquals(entries, nullptr)) throw gcnew ArgumentNullException("entries");
+	if(Object::ReferenceEquals(contents, nullptr)) throw gcnew ArgumentNullException("contents");
+
+	HashSet<FileContent^>^ distinct = gcnew HashSet<FileContent^>();
+	for each(Entry^ entry in entries) { m_paths->Add(entry->FileName, entry); distinct->Add(entry->Content); }
+	m_distinct = distinct->Count;
+
+	if(entries->Count == 0) return;
+
+	// Build the unmanaged unsaved file array once, every parse against the snapshot uses it
+	try { m_unsaved = new CXUnsavedFile[entries->Count]; }
+	catch(Exception^) { throw gcnew OutOfMemoryException(); }
+
+	memset(m_unsaved, 0, sizeof(CXUnsavedFile) * entries->Count);
+	m_numunsaved = entries->Count;
+
+	try {
+
+		// The contents point directly into the shared buffers, only the file names are owned here
+		for(int index = 0; index < entries->Count; index++) {
+
+			m_unsaved[index].Filename = StringUtil::ToCharPointer(entries[index]->FileName, CP_UTF8);
+			m_unsaved[index].Contents = entries[index]->Content->Buffer;
+			m_unsaved[index].Length = static_cast<unsigned long>(entries[index]->Content->Length);
+		}
+	}
+
+	catch(Exception^) { this->!WorkspaceSnapshot(); throw; }
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot Destructor
+
+WorkspaceSnapshot::~WorkspaceSnapshot()
+{
+	if(m_disposed) return;
+
+	this->!WorkspaceSnapshot();			// Release the unmanaged resources
+	m_disposed = true;					// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot Finalizer
+
+WorkspaceSnapshot::!WorkspaceSnapshot()
+{
+	if(m_unsaved != __nullptr) {
+
+		// The file contents belong to the shared buffers and are not released here
+		for(int index = 0; index < m_numunsaved; index++)
+			StringUtil::FreeCharPointer(const_cast<char*>(m_unsaved[index].Filename));
+
+		delete[] m_unsaved;
+	}
+
+	m_unsaved = __nullptr;
+	m_numunsaved = 0;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::ContentCount::get
+//
+// Gets the number of distinct file contents in the snapshot
+
+int WorkspaceSnapshot::ContentCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_distinct;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::Count::get
+//
+// Gets the number of files in the snapshot
+
+int WorkspaceSnapshot::Count::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_entries->Count;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::Create (static)
+//
+// Creates a snapshot of the files in a set of directories and their subdirectories
+//
+// Arguments:
+//
+//	directories		- Directories to include in the snapshot
+
+WorkspaceSnapshot^ WorkspaceSnapshot::Create(IEnumerable<String^>^ directories)
+{
+	return Create(directories, "*", nullptr);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::Create (static)
+//
+// Creates a snapshot of the files in a set of directories and their subdirectories
+//
+// Arguments:
+//
+//	directories		- Directories to include in the snapshot
+//	searchPattern	- Pattern to match against the file names
+
+WorkspaceSnapshot^ WorkspaceSnapshot::Create(IEnumerable<String^>^ directories, String^ searchPattern)
+{
+	return Create(directories, searchPattern, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::Create (static)
+//
+// Creates a snapshot of the files in a set of directories and their subdirectories
+//
+// Arguments:
+//
+//	directories		- Directories to include in the snapshot
+//	searchPattern	- Pattern to match against the file names
+//	baseline		- Previous snapshot to share unchanged files with (optional)
+
+WorkspaceSnapshot^ WorkspaceSnapshot::Create(IEnumerable<String^>^ directories, String^ searchPattern, WorkspaceSnapshot^ baseline)
+{
+	Entry^				previous;				// Baseline entry for a file
+	UInt64				hash;					// Hash of the file contents
+
+	if(Object::ReferenceEquals(directories, nullptr)) throw gcnew ArgumentNullException("directories");
+	if(Object::ReferenceEquals(searchPattern, nullptr)) throw gcnew ArgumentNullException("searchPattern");
+	if((!Object::ReferenceEquals(baseline, nullptr)) && (baseline->m_disposed)) throw gcnew ObjectDisposedException("baseline");
+
+	List<Entry^>^ entries = gcnew List<Entry^>();
+	Dictionary<UInt64, FileContent^>^ contents = gcnew Dictionary<UInt64, FileContent^>();
+	HashSet<String^>^ paths = gcnew HashSet<String^>(StringComparer::OrdinalIgnoreCase);
+
+	for each(String^ directory in directories) {
+
+		if(Object::ReferenceEquals(directory, nullptr)) throw gcnew ArgumentNullException("directories");
+
+		for each(String^ file in Directory::EnumerateFiles(Path::GetFullPath(directory), searchPattern, SearchOption::AllDirectories)) {
+
+			String^ path = Path::GetFullPath(file);
+			if(!paths->Add(path)) continue;
+
+			// Files that have not changed since the baseline share its contents without being read
+			FileInfo^ info = gcnew FileInfo(path);
+			if((!Object::ReferenceEquals(baseline, nullptr)) && (baseline->m_paths->TryGetValue(path, previous)) &&
+				(previous->Length == info->Length) && (previous->LastWriteTimeUtc == info->LastWriteTimeUtc)) {
+
+				if(!contents->ContainsKey(previous->Content->Hash)) contents->Add(previous->Content->Hash, previous->Content);
+				entries->Add(previous);
+				continue;
+			}
+
+			array<Byte>^ bytes = File::ReadAllBytes(path);
+			if(bytes->Length == 0) hash = StringUtil::Hash("", 0);
+			else {
+
+				pin_ptr<Byte> pinbytes = &bytes[0];
+				hash = StringUtil::Hash(reinterpret_cast<const char*>(pinbytes), static_cast<size_t>(bytes->Length));
+			}
+
+			// Identical contents are shared with other files in this snapshot or in the baseline
+			FileContent^ content = FindContent(contents, bytes, hash);
+			if((Object::ReferenceEquals(content, nullptr)) && (!Object::ReferenceEquals(baseline, nullptr))) content = FindContent(baseline->m_contents, bytes, hash);
+			if(Object::ReferenceEquals(content, nullptr)) content = gcnew FileContent(bytes, hash);
+
+			if(!contents->ContainsKey(hash)) contents->Add(hash, content);
+			entries->Add(gcnew Entry(path, info->LastWriteTimeUtc, info->Length, content));
+		}
+	}
+
+	return gcnew WorkspaceSnapshot(entries, contents);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::CreateOverlay
+//
+// Writes the file contents into a content-addressed cache directory and
+// creates a VirtualFileOverlay that maps the original paths onto them
+//
+// Arguments:
+//
+//	cachedirectory	- Directory in which to store the file contents
+
+VirtualFileOverlay^ WorkspaceSnapshot::CreateOverlay(String^ cachedirectory)
+{
+	FileContent^			canonical;				// Content stored for a hash
+	String^					target;					// Cached file path
+
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(cachedirectory, nullptr)) throw gcnew ArgumentNullException("cachedirectory");
+
+	cachedirectory = Path::GetFullPath(cachedirectory);
+	Directory::CreateDirectory(cachedirectory);
+
+	Dictionary<FileContent^, String^>^ targets = gcnew Dictionary<FileContent^, String^>();
+	VirtualFileOverlay^ overlay = Clang::CreateVirtualFileOverlay();
+
+	try {
+
+		for each(Entry^ entry in m_entries) {
+
+			FileContent^ content = entry->Content;
+			if(!targets->TryGetValue(content, target)) {
+
+				// Cached files are named by the hash of their contents so they can be shared by other
+				// snapshots; contents whose hash collided with different bytes get a unique name instead
+				String^ name = content->Hash.ToString("x16");
+				if((!m_contents->TryGetValue(content->Hash, canonical)) || (!Object::ReferenceEquals(canonical, content)))
+					name = String::Concat(name, "-", Guid::NewGuid().ToString("N"));
+
+				// A cached file with the right name is only reused if it has exactly the right contents;
+				// a colliding hash from another snapshot or an edited cache file must not be picked up
+				target = Path::Combine(cachedirectory, name);
+				if(!IsCachedContent(target, content)) {
+
+					array<Byte>^ bytes = gcnew array<Byte>(content->Length);
+					if(content->Length > 0) Marshal::Copy(IntPtr(content->Buffer), bytes, 0, content->Length);
+					File::WriteAllBytes(target, bytes);
+				}
+
+				targets->Add(content, target);
+			}
+
+			overlay->AddFileMapping(entry->FileName, target);
+		}
+	}
+
+	catch(Exception^) { delete overlay; throw; }
+
+	return overlay;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::CreateTranslationUnit
+//
+// Creates a TranslationUnit by parsing source code against the snapshot
+//
+// Arguments:
+//
+//	index			- Index instance to use for the parse
+//	path			- Path to the input source code file (optional)
+//	args			- Arguments to pass to the libclang engine
+
+TranslationUnit^ WorkspaceSnapshot::CreateTranslationUnit(Index^ index, String^ path, IEnumerable<String^>^ args)
+{
+	return CreateTranslationUnit(index, path, args, static_cast<TranslationUnitParseOptions>(-1));
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::CreateTranslationUnit
+//
+// Creates a TranslationUnit by parsing source code against the snapshot
+//
+// Arguments:
+//
+//	index			- Index instance to use for the parse
+//	path			- Path to the input source code file (optional)
+//	args			- Arguments to pass to the libclang engine
+//	options			- Options to control source code parsing behaviors
+
+TranslationUnit^ WorkspaceSnapshot::CreateTranslationUnit(Index^ index, String^ path, IEnumerable<String^>^ args, TranslationUnitParseOptions options)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(index, nullptr)) throw gcnew ArgumentNullException("index");
+
+	// libclang copies the unsaved file contents, the snapshot only has to outlive the parse
+	try { return index->ParseTranslationUnit(path, args, m_unsaved, m_numunsaved, options); }
+	finally { GC::KeepAlive(this); }
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::FileNames::get
+//
+// Gets the full paths of the files in the snapshot
+
+ReadOnlyCollection<String^>^ WorkspaceSnapshot::FileNames::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	array<String^>^ filenames = gcnew array<String^>(m_entries->Count);
+	for(int index = 0; index < m_entries->Count; index++) filenames[index] = m_entries[index]->FileName;
+
+	return gcnew ReadOnlyCollection<String^>(filenames);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::FindContent (private, static)
+//
+// Locates existing contents that match a buffer
+//
+// Arguments:
+//
+//	contents		- Contents keyed by hash
+//	bytes			- Buffer to be matched
+//	hash			- Hash of the buffer
+
+WorkspaceSnapshot::FileContent^ WorkspaceSnapshot::FindContent(Dictionary<UInt64, FileContent^>^ contents, array<Byte>^ bytes, UInt64 hash)
+{
+	FileContent^			content;				// Content stored for the hash
+
+	if(!contents->TryGetValue(hash, content)) return nullptr;
+	if(content->Length != bytes->Length) return nullptr;
+	if(bytes->Length == 0) return content;
+
+	// The hash is only a hint, the contents must be identical to be shared
+	pin_ptr<Byte> pinbytes = &bytes[0];
+	return (memcmp(content->Buffer, pinbytes, bytes->Length) == 0) ? content : nullptr;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::GetContentHash
+//
+// Gets the hash of the contents of a file in the snapshot
+//
+// Arguments:
+//
+//	path			- Path to the file
+
+UInt64 WorkspaceSnapshot::GetContentHash(String^ path)
+{
+	Entry^				entry;					// Entry for the file
+
+	CHECK_DISPOSED(m_disposed);
+
+	if(Object::ReferenceEquals(path, nullptr)) throw gcnew ArgumentNullException("path");
+	if(!m_paths->TryGetValue(Path::GetFullPath(path), entry)) throw gcnew ArgumentOutOfRangeException("path");
+
+	return entry->Content->Hash;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::GetUnsavedFiles
+//
+// Creates UnsavedFile instances for every file in the snapshot
+//
+// Arguments:
+//
+//	NONE
+
+array<UnsavedFile^>^ WorkspaceSnapshot::GetUnsavedFiles(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	array<UnsavedFile^>^ unsavedfiles = gcnew array<UnsavedFile^>(m_entries->Count);
+
+	for(int index = 0; index < m_entries->Count; index++) {
+
+		FileContent^ content = m_entries[index]->Content;
+		unsavedfiles[index] = gcnew UnsavedFile(m_entries[index]->FileName, gcnew String(content->Buffer, 0, content->Length, Encoding::UTF8));
+	}
+
+	return unsavedfiles;
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::IsCachedContent (private, static)
+//
+// Determines if a cached file exists and has the same contents as a buffer
+//
+// Arguments:
+//
+//	path			- Path to the cached file
+//	content			- Contents to be matched
+
+bool WorkspaceSnapshot::IsCachedContent(String^ path, FileContent^ content)
+{
+	if(!File::Exists(path)) return false;
+	if((gcnew FileInfo(path))->Length != content->Length) return false;
+
+	array<Byte>^ bytes = File::ReadAllBytes(path);
+	if(bytes->Length != content->Length) return false;
+	if(bytes->Length == 0) return true;
+
+	pin_ptr<Byte> pinbytes = &bytes[0];
+	return (memcmp(content->Buffer, pinbytes, bytes->Length) == 0);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::FileContent Constructor
+//
+// Arguments:
+//
+//	bytes		- File contents to copy into the unmanaged buffer
+//	hash		- Hash of the file contents
+
+WorkspaceSnapshot::FileContent::FileContent(array<Byte>^ bytes, UInt64 hash) : Buffer(__nullptr), Length(bytes->Length), Hash(hash)
+{
+	// The buffer is null terminated, libclang does not require it but it costs nothing
+	try { Buffer = new char[Length + 1]; }
+	catch(Exception^) { throw gcnew OutOfMemoryException(); }
+
+	if(Length > 0) Marshal::Copy(bytes, 0, IntPtr(Buffer), Length);
+	Buffer[Length] = '\0';
+
+	GC::AddMemoryPressure(Length + 1);
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::FileContent Destructor
+
+WorkspaceSnapshot::FileContent::~FileContent()
+{
+	this->!FileContent();
+}
+
+//---------------------------------------------------------------------------
+// WorkspaceSnapshot::FileContent Finalizer
+
+WorkspaceSnapshot::FileContent::!FileContent()
+{
+	if(Buffer == __nullptr) return;
+
+	delete[] Buffer;
+	GC::RemoveMemoryPressure(Length + 1);
+
+	Buffer = __nullptr;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
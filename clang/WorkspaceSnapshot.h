@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+
+#ifndef __WORKSPACESNAPSHOT_H_
+#define __WORKSPACESNAPSHOT_H_
+#pragma once
+
+#pragma warning(push, 4)				// Enable maximum compiler warnings
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+namespace zuki::tools::llvm::clang {
+
+// FORWARD DECLARATIONS
+//
+ref class	Index;
+ref class	TranslationUnit;
+enum class	TranslationUnitParseOptions;
+ref class	UnsavedFile;
+ref class	VirtualFileOverlay;
+
+//---------------------------------------------------------------------------
+// Class WorkspaceSnapshot
+//
+// Immutable in-memory copy of the files in a set of directories.  The files
+// are read once and presented to parses as unsaved files so that they are
+// not read from disk again.  File contents are addressed by a hash of their
+// bytes; identical files share a single buffer, and a snapshot created from
+// a baseline snapshot shares the buffers of every file that has not changed
+//---------------------------------------------------------------------------
+
+public ref class WorkspaceSnapshot
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Create (static)
+	//
+	// Creates a snapshot of the files in a set of directories and their subdirectories
+	static WorkspaceSnapshot^ Create(IEnumerable<String^>^ directories);
+	static WorkspaceSnapshot^ Create(IEnumerable<String^>^ directories, String^ searchPattern);
+	static WorkspaceSnapshot^ Create(IEnumerable<String^>^ directories, String^ searchPattern, WorkspaceSnapshot^ baseline);
+
+	// CreateOverlay
+	//
+	// Writes the file contents into a content-addressed cache directory and
+	// creates a VirtualFileOverlay that maps the original paths onto them
+	VirtualFileOverlay^ CreateOverlay(String^ cachedirectory);
+
+	// CreateTranslationUnit
+	//
+	// Creates a TranslationUnit by parsing source code against the snapshot
+	TranslationUnit^ CreateTranslationUnit(Index^ index, String^ path, IEnumerable<String^>^ args);
+	TranslationUnit^ CreateTranslationUnit(Index^ index, String^ path, IEnumerable<String^>^ args, TranslationUnitParseOptions options);
+
+	// GetContentHash
+	//
+	// Gets the hash of the contents of a file in the snapshot
+	UInt64 GetContentHash(String^ path);
+
+	// GetUnsavedFiles
+	//
+	// Creates UnsavedFile instances for every file in the snapshot
+	array<UnsavedFile^>^ GetUnsavedFiles(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// ContentCount
+	//
+	// Gets the number of distinct file contents in the snapshot
+	property int ContentCount
+	{
+		int get(void);
+	}
+
+	// Count
+	//
+	// Gets the number of files in the snapshot
+	property int Count
+	{
+		int get(void);
+	}
+
+	// FileNames
+	//
+	// Gets the full paths of the files in the snapshot
+	property ReadOnlyCollection<String^>^ FileNames
+	{
+		ReadOnlyCollection<String^>^ get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Data Types
+
+	// Class FileContent
+	//
+	// Unmanaged buffer holding file contents, shared between snapshots
+	ref class FileContent
+	{
+	public:
+
+		// Instance Constructor
+		//
+		FileContent(array<Byte>^ bytes, UInt64 hash);
+
+		// Destructor / Finalizer
+		//
+		~FileContent();
+		!FileContent();
+
+		// Fields
+		//
+		char*					Buffer;			// Unmanaged contents
+		initonly int			Length;			// Length of the contents
+		initonly UInt64			Hash;			// Hash of the contents
+	};
+
+	// Class Entry
+	//
+	// Associates a file in the snapshot with its contents
+	ref class Entry
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Entry(String^ filename, DateTime lastwrite, Int64 length, FileContent^ content) : 
+			FileName(filename), LastWriteTimeUtc(lastwrite), Length(length), Content(content) {}
+
+		// Fields
+		//
+		initonly String^		FileName;			// Full path to the file
+		initonly DateTime		LastWriteTimeUtc;	// Time the file was written
+		initonly Int64			Length;				// Length of the file
+		initonly FileContent^	Content;			// File contents
+	};
+
+	// Instance Constructor
+	//
+	WorkspaceSnapshot(List<Entry^>^ entries, Dictionary<UInt64, FileContent^>^ contents);
+
+	// Destructor / Finalizer
+	//
+	~WorkspaceSnapshot();
+	!WorkspaceSnapshot();
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// FindContent (static)
+	//
+	// Locates existing contents that match a buffer
+	static FileContent^ FindContent(Dictionary<UInt64, FileContent^>^ contents, array<Byte>^ bytes, UInt64 hash);
+
+	// IsCachedContent (static)
+	//
+	// Determines if a cached file exists and has the same contents as a buffer
+	static bool IsCachedContent(String^ path, FileContent^ content);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool									m_disposed;		// Object disposal flag
+	List<Entry^>^							m_entries;		// Files in the snapshot
+	Dictionary<String^, Entry^>^			m_paths;		// Files keyed by path
+	Dictionary<UInt64, FileContent^>^		m_contents;		// Contents keyed by hash
+	int										m_distinct;		// Distinct contents
+	CXUnsavedFile*							m_unsaved;		// Unmanaged unsaved files
+	int										m_numunsaved;	// Number of unsaved files
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::tools::llvm::clang
+
+#pragma warning(pop)
+
+#endif	// __WORKSPACESNAPSHOT_H_